@@ -6,6 +6,7 @@
 #include "Project.h"
 #include "LogSystem/LogMgr.h"
 #include "GfxSystem/OglRenderer.h"
+#include "GfxSystem/NullRenderer.h"
 #include "GfxSystem/GfxWindow.h"
 #include "GUISystem/ViewportWindow.h"
 #include "ScriptSystem/ScriptResource.h"
@@ -38,9 +39,16 @@ Application::Application():
 	#endif
 }
 
-void Application::Init(const string& sharedDir)
+void Application::Init(const string& sharedDir, const HeadlessSettings& headless)
 {
 	mSharedDir = sharedDir;
+	mHeadless = headless;
+	if (mHeadless.enabled)
+	{
+		// the editor can't run without the window
+		mDevelopMode = false;
+		mEditMode = false;
+	}
 	
 	if (mSharedDir.empty())
 	{
@@ -108,6 +116,7 @@ void Application::Init(const string& sharedDir)
 	// get access to config file
 	mGlobalConfig = new Config((tempDir / configFilename).string());
 	GlobalProperties::SetPointer("GlobalConfig", mGlobalConfig);
+	LogSystem::LogMgr::GetSingleton().LoadChannelLevels(*mGlobalConfig);
 
 	// make the app settings public
 	GlobalProperties::SetPointer("DevelopMode", &mDevelopMode);
@@ -145,34 +154,45 @@ void Application::Init(const string& sharedDir)
 	StringSystem::StringMgr::Init();
 	gStringMgrSystem.LoadLanguagePack(mGlobalConfig->GetString("Language", "", "Editor"), mGlobalConfig->GetString("Country", "", "Editor"));
 
-	GfxSystem::GfxWindow::CreateSingleton();
-	int32 windowX = mGlobalConfig->GetInt32("WindowX", 50, "Windows"); // start at 50 to give some offset to the window
-	int32 windowY = mGlobalConfig->GetInt32("WindowY", 50, "Windows");
-	int32 windowWidth = mGlobalConfig->GetInt32("WindowWidth", 1024, "Windows");
-	int32 windowHeight = mGlobalConfig->GetInt32("WindowHeight", 768, "Windows");
-	int32 resX = mGlobalConfig->GetInt32("FullscreenResolutionWidth", 0, "Windows");
-	int32 resY = mGlobalConfig->GetInt32("FullscreenResolutionHeight", 0, "Windows");
-	bool fullscreen = mGlobalConfig->GetBool("Fullscreen", false, "Windows");
-	GfxSystem::GfxWindow::GetSingleton().Init(windowX, windowY, windowWidth, windowHeight, resX, resY, fullscreen, "Loading...");
-
-	GfxSystem::GfxRenderer::CreateSingleton<GfxSystem::OglRenderer>();
+	if (mHeadless.enabled)
+	{
+		ocInfo << "Running headless";
+		GfxSystem::GfxRenderer::CreateSingleton<GfxSystem::NullRenderer>();
+	}
+	else
+	{
+		GfxSystem::GfxWindow::CreateSingleton();
+		int32 windowX = mGlobalConfig->GetInt32("WindowX", 50, "Windows"); // start at 50 to give some offset to the window
+		int32 windowY = mGlobalConfig->GetInt32("WindowY", 50, "Windows");
+		int32 windowWidth = mGlobalConfig->GetInt32("WindowWidth", 1024, "Windows");
+		int32 windowHeight = mGlobalConfig->GetInt32("WindowHeight", 768, "Windows");
+		int32 resX = mGlobalConfig->GetInt32("FullscreenResolutionWidth", 0, "Windows");
+		int32 resY = mGlobalConfig->GetInt32("FullscreenResolutionHeight", 0, "Windows");
+		bool fullscreen = mGlobalConfig->GetBool("Fullscreen", false, "Windows");
+		GfxSystem::GfxWindow::GetSingleton().Init(windowX, windowY, windowWidth, windowHeight, resX, resY, fullscreen, "Loading...");
+
+		GfxSystem::GfxRenderer::CreateSingleton<GfxSystem::OglRenderer>();
+	}
 	GfxSystem::GfxRenderer::GetSingleton().Init();
 
-	InputSystem::InputMgr::CreateSingleton();
+	if (!mHeadless.enabled) InputSystem::InputMgr::CreateSingleton();
 
 	ScriptSystem::ScriptMgr::CreateSingleton();
 
 	EntitySystem::EntityMgr::CreateSingleton();
 
-	GUISystem::GUIMgr::CreateSingleton();
-	GUISystem::GUIMgr::GetSingleton().Init((tempDir / ceguiLogFilename).string());
+	if (!mHeadless.enabled)
+	{
+		GUISystem::GUIMgr::CreateSingleton();
+		GUISystem::GUIMgr::GetSingleton().Init((tempDir / ceguiLogFilename).string());
+	}
 
 	Editor::EditorMgr::CreateSingleton();
 	EntitySystem::LayerMgr::CreateSingleton();
 
 	// create core states
 	mLoadingScreen = new LoadingScreen();
-	mGame = new Game(tempDir.string());
+	mGame = new Game();
 
 	// init finished, now loading
 	RequestStateChange(AS_LOADING);
@@ -197,7 +217,7 @@ Application::~Application()
 		gEditorMgr.Deinit();
 	Editor::EditorMgr::DestroySingleton();
 
-	GUISystem::GUIMgr::DestroySingleton();
+	if (GUISystem::GUIMgr::SingletonExists()) GUISystem::GUIMgr::DestroySingleton();
 
 	// Cancel unload callback for script and text resources
 	ScriptSystem::ScriptResource::SetUnloadCallback(0);
@@ -208,18 +228,21 @@ Application::~Application()
 
 	ScriptSystem::ScriptMgr::DestroySingleton();
 
-	InputSystem::InputMgr::DestroySingleton();
+	if (InputSystem::InputMgr::SingletonExists()) InputSystem::InputMgr::DestroySingleton();
 
 	GfxSystem::GfxRenderer::DestroySingleton();
 
-	mGlobalConfig->SetInt32("WindowX", gGfxWindow.GetWindowX(), "Windows");
-	mGlobalConfig->SetInt32("WindowY", gGfxWindow.GetWindowY(), "Windows");
-	mGlobalConfig->SetInt32("WindowWidth", gGfxWindow.GetWindowWidth(), "Windows");
-	mGlobalConfig->SetInt32("WindowHeight", gGfxWindow.GetWindowHeight(), "Windows");
-	mGlobalConfig->SetInt32("FullscreenResolutionWidth", gGfxWindow.GetFullscreenResolutionWidth(), "Windows");
-	mGlobalConfig->SetInt32("FullscreenResolutionHeight", gGfxWindow.GetFullscreenResolutionHeight(), "Windows");
-	mGlobalConfig->SetBool("Fullscreen", gGfxWindow.IsFullscreen(), "Windows");
-	GfxSystem::GfxWindow::DestroySingleton();
+	if (GfxSystem::GfxWindow::SingletonExists())
+	{
+		mGlobalConfig->SetInt32("WindowX", gGfxWindow.GetWindowX(), "Windows");
+		mGlobalConfig->SetInt32("WindowY", gGfxWindow.GetWindowY(), "Windows");
+		mGlobalConfig->SetInt32("WindowWidth", gGfxWindow.GetWindowWidth(), "Windows");
+		mGlobalConfig->SetInt32("WindowHeight", gGfxWindow.GetWindowHeight(), "Windows");
+		mGlobalConfig->SetInt32("FullscreenResolutionWidth", gGfxWindow.GetFullscreenResolutionWidth(), "Windows");
+		mGlobalConfig->SetInt32("FullscreenResolutionHeight", gGfxWindow.GetFullscreenResolutionHeight(), "Windows");
+		mGlobalConfig->SetBool("Fullscreen", gGfxWindow.IsFullscreen(), "Windows");
+		GfxSystem::GfxWindow::DestroySingleton();
+	}
 
 	StringSystem::StringMgr::Deinit();
 
@@ -237,10 +260,13 @@ Application::~Application()
 
 void Application::RunMainLoop()
 {
+	uint32 headlessFrameIndex = 0;
+	uint64 headlessFrameEnd = mTimer.GetMilliseconds();
+
 	while (GetState() != AS_SHUTDOWN)
 	{
 		// process window events
-		MessagePump();
+		if (!mHeadless.enabled) MessagePump();
 
 		// make sure we have everything ok
 		OC_ASSERT(mGame);
@@ -250,7 +276,10 @@ void Application::RunMainLoop()
 		gProfiler.Update();
 
 		// process input events
-		gInputMgr.CaptureInput();
+		if (!mHeadless.enabled) gInputMgr.CaptureInput();
+
+		// finish loading of the resources prepared in background
+		gResourceMgr.ProcessPreparedResources();
 
 		// make sure the resources are up to date
 		if ((mDevelopMode) && (GetState() != AS_LOADING) && (gEditorMgr.IsProjectOpened()))
@@ -279,14 +308,17 @@ void Application::RunMainLoop()
 				gEditorMgr.UpdateResourceWindow();
 		}
 
-		// calculate time since last frame
-		float32 delta = CalculateFrameDeltaTime();
+		// calculate time since last frame; headless runs advance the game by fixed steps
+		float32 delta = mHeadless.enabled ? mHeadless.frameDelta : CalculateFrameDeltaTime();
+
+		// show the messages logged by the worker threads since the last frame
+		LogSystem::LogMgr::GetSingleton().FlushConsoleMessages();
 
 		// update logic
 		FrameUpdate(delta);
 
 		// draw
-		FrameDraw(delta);
+		if (!mHeadless.enabled) FrameDraw(delta);
 
 		// update FPS and other performance counters
 		UpdateStats();
@@ -294,6 +326,24 @@ void Application::RunMainLoop()
 		// update app state machine
 		UpdateState();
 
+		if (mHeadless.enabled && GetState() == AS_GAME)
+		{
+			++headlessFrameIndex;
+			if (mHeadless.frameCount > 0 && headlessFrameIndex >= mHeadless.frameCount)
+			{
+				ocInfo << "Headless run finished after " << headlessFrameIndex << " frames";
+				RequestStateChange(AS_SHUTDOWN, true);
+			}
+			else if (mHeadless.realTime)
+			{
+				// the frames are not caught up if they are late, just like the physics
+				headlessFrameEnd += (uint64)(1000.0f * mHeadless.frameDelta);
+				uint64 curTime = mTimer.GetMilliseconds();
+				if (headlessFrameEnd > curTime) SleepMillis((uint32)(headlessFrameEnd - curTime));
+				else headlessFrameEnd = curTime;
+			}
+		}
+
 		// if we don't have focus yield for a while to allow other apps to work
 		if (!mHasFocus) YieldProcess();
 	}
@@ -392,7 +442,7 @@ void Core::Application::RegisterGameInputListener( InputSystem::IInputListener*
 	{
 		gEditorMgr.GetGameViewport()->AddInputListener(listener);
 	}
-	else
+	else if (!mHeadless.enabled)
 	{
 		gInputMgr.AddInputListener(listener);
 	}
@@ -405,7 +455,7 @@ void Core::Application::UnregisterGameInputListener( InputSystem::IInputListener
 		if (gEditorMgr.GetGameViewport())
 			gEditorMgr.GetGameViewport()->RemoveInputListener(listener);
 	}
-	else
+	else if (!mHeadless.enabled)
 	{
 		gInputMgr.RemoveInputListener(listener);
 	}
@@ -503,7 +553,7 @@ void Application::FrameUpdate(float32 delta)
 
 		mGame->Init();
 
-		gGfxWindow.SetWindowCaption("");
+		if (!mHeadless.enabled) gGfxWindow.SetWindowCaption("");
 
 		if (mDevelopMode)
 		{
@@ -515,7 +565,7 @@ void Application::FrameUpdate(float32 delta)
 		else
 		{
 			if (!mGameProject) mGameProject = new Project(false);
-			if (!mGameProject->OpenProject("."))
+			if (!mGameProject->OpenProject(mHeadless.enabled ? mHeadless.projectPath : "."))
 			{
 				ocError << "Invalid project; quiting...";
 				Shutdown();
@@ -527,7 +577,7 @@ void Application::FrameUpdate(float32 delta)
 
 		break;
 	case AS_GAME:
-		gGUIMgr.Update(delta);
+		if (!mHeadless.enabled) gGUIMgr.Update(delta);
 		mGameProject->Update();
 		mGame->Update(delta);
 		if (mEditMode)
@@ -661,6 +711,11 @@ void Core::Application::YieldProcess()
 	Sleep(1);
 }
 
+void Core::Application::SleepMillis( const uint32 millis )
+{
+	Sleep(millis);
+}
+
 #else
 
 //------------
@@ -733,4 +788,9 @@ void Core::Application::YieldProcess()
 	usleep(20000);
 }
 
+void Core::Application::SleepMillis( const uint32 millis )
+{
+	usleep(millis * 1000);
+}
+
 #endif
@@ -33,6 +33,23 @@ namespace Core
 		AS_SHUTDOWN
 	};
 
+	/// Settings of the application running without a window, renderer, input and GUI (see Application::Init).
+	struct HeadlessSettings
+	{
+		HeadlessSettings(void): enabled(false), frameDelta(1.0f / 60.0f), frameCount(0), realTime(false) {}
+
+		/// True if the application runs headless.
+		bool enabled;
+		/// Path to the project which is run.
+		string projectPath;
+		/// Game time (in seconds) passed in each frame.
+		float32 frameDelta;
+		/// Number of frames after which the application quits. Zero means no limit.
+		uint32 frameCount;
+		/// If true, the frames are run at the rate of the real time, otherwise as fast as possible.
+		bool realTime;
+	};
+
 	/// Main class of the whole application. One instance is created at startup and the RunMainLoop() method is invoked.
 	/// The application is state-driven which means that it can be in a single state (Core::eAppState) at a given point of
 	/// time. Each of these states are represented by a class inside Core.
@@ -47,7 +64,8 @@ namespace Core
 		virtual ~Application(void);
 
 		/// Inits the application (creates singletons, ...).
-		void Init(const string& sharedDir);
+		/// If the headless mode is enabled, no window is opened and only the game of the given project is run.
+		void Init(const string& sharedDir, const HeadlessSettings& headless = HeadlessSettings());
 
 		/// Main loop of the whole project.
 		void RunMainLoop(void);
@@ -87,6 +105,9 @@ namespace Core
 
 		/// Returns whether the editor is currently turned on and the game is running only in a small window.
 		bool IsEditMode() const { return mEditMode; }
+
+		/// Returns whether the application runs without a window, renderer, input and GUI.
+		bool IsHeadless() const { return mHeadless.enabled; }
 		
 		/// Returns true if the application has currently focus.
 		bool HasFocus(void) const { return mHasFocus; }
@@ -128,6 +149,7 @@ namespace Core
 		/// Application settings.
 		bool mDevelopMode; ///< if true the editor support is turned on.
 		bool mEditMode; ///< if true the editor is currently turned on and the game is running only in a small window.
+		HeadlessSettings mHeadless; ///< settings of the run without a window.
 		Project* mGameProject; ///< Project used for the game itself.
 		bool mHasFocus;
 
@@ -168,6 +190,9 @@ namespace Core
 
 		/// Redraws the application in the current frame (called from the main loop).
 		void FrameDraw(float32 delta);
+
+		/// Suspends the application for the given time.
+		void SleepMillis(const uint32 millis);
 	};
 }
 
@@ -5,27 +5,40 @@
 #include "StringConverter.h"
 #include "Core/Application.h"
 #include "Core/Project.h"
+#include "Core/Config.h"
 #include "Editor/EditorMgr.h"
 #include "Editor/EditorGUI.h"
 #include "ResourceSystem/XMLResource.h"
+#include "ResourceSystem/XMLReader.h"
+#include "ResourceSystem/BinaryInput.h"
 #include "GfxSystem/PhysicsDraw.h"
 #include "GfxSystem/Mesh.h"
 #include "GUISystem/CEGUICommon.h"
 
 #include <Box2D.h>
 #include <Box2D/Dynamics/b2WorldCallbacks.h>
+#include "EntitySystem/EntityMgr/PropertyKeys.h"
 
 using namespace Core;
 using namespace EntitySystem;
 using namespace InputSystem;
 
 const float PHYSICS_TIMESTEP = 0.016f;
+/// Tolerance of the physics time accumulator, so that rounding errors don't postpone a whole step to the next frame.
+const float32 PHYSICS_TIMESTEP_EPSILON = 0.0001f;
 const int32 PHYSICS_VELOCITY_ITERATIONS = 6;
 const int32 PHYSICS_POSITION_ITERATIONS = 2;
-const char* TMP_ACTION_FILE = "tmpActionSave.xml";
+const int32 DEFAULT_MAX_PHYSICS_STEPS = 5;
 const string Game::GameCameraName = "GameCamera";
 const char* Game::SavePath = "saves";
 
+const StringKey XML_GAME_INFO_ELEMENT("GameInfo");
+const StringKey XML_CURRENT_TIME_ELEMENT("CurrentTime");
+const StringKey XML_SCENE_NAME_ELEMENT("SceneName");
+const StringKey XML_REQUESTED_SCENE_NAME_ELEMENT("RequestedSceneName");
+const StringKey XML_DYNAMIC_PROPERTIES_ELEMENT("DynamicProperties");
+const StringKey XML_TYPE_ATTRIBUTE("Type");
+
 
 /// Callback receiver from physics.
 class Core::Game::PhysicsCallbacks: public b2ContactFilter, public b2ContactListener
@@ -49,7 +62,7 @@ private:
 };
 
 
-Core::Game::Game(const string& tempDirectory):
+Core::Game::Game(void):
 	StateMachine<eGameState>(GS_NOT_INITED),
 	mActionRestarted(true),
 	mTimer(true),
@@ -57,13 +70,9 @@ Core::Game::Game(const string& tempDirectory):
 	mCamera(EntitySystem::EntityHandle::Null),
 	mRootWindow(0),
 	mUpdateRootWindowCounter(0),
-	mTempActionSave(""),
 	mPhysics(0),
 	mPhysicsCallbacks(0)
 {
-	if (!tempDirectory.empty()) mTempActionSave = tempDirectory + string("/") + TMP_ACTION_FILE;
-	else mTempActionSave = string("./") + TMP_ACTION_FILE;
-
 	mPhysicsCallbacks = new PhysicsCallbacks(this);
 	mPhysicsDraw = new GfxSystem::PhysicsDraw();
 	mPhysics = new b2World(b2Vec2(0.0f, 0.0f), true);
@@ -159,7 +168,11 @@ void Core::Game::Init()
 	mPhysics->SetContactListener(mPhysicsCallbacks);
 	mPhysics->SetDebugDraw(mPhysicsDraw);
 	mPhysicsResidualDelta = 0.0f;
+	mDroppedPhysicsTime = 0.0f;
 
+	// slow frames must not cause even slower frames by catching up the physics
+	mMaxPhysicsSteps = GlobalProperties::Get<Core::Config>("GlobalConfig").GetInt32("MaxPhysicsStepsPerFrame", DEFAULT_MAX_PHYSICS_STEPS, "Game");
+	if (mMaxPhysicsSteps < 1) mMaxPhysicsSteps = 1;
 
 	// update globally accessible game related properties, like the physics engine
 	UpdateGameProperties();
@@ -176,11 +189,8 @@ void Core::Game::Clean()
 	gApp.UnregisterGameInputListener(this);
 	ForceStateChange(GS_CLEANING);
 
-	for (PhysicsEventList::const_iterator i=mPhysicsEvents.begin(); i!=mPhysicsEvents.end(); ++i)
-	{
-		delete *i;
-	}
 	mPhysicsEvents.clear();
+	mPhysicsEventReceivers.clear();
 	
 	ForceStateChange(GS_NOT_INITED);
 	ocInfo << "Game cleaned";
@@ -201,9 +211,18 @@ void Core::Game::Update(const float32 delta)
 	// check action scripts
 	gEntityMgr.BroadcastMessage(EntityMessage(EntityMessage::CHECK_ACTION));
 
-	// advance the physics forward in time
+	// advance the physics forward in time; if it can't keep up, the game is rather slowed down
 	float32 physicsDelta = delta + mPhysicsResidualDelta;
-	while (physicsDelta > PHYSICS_TIMESTEP)
+	const float32 maxPhysicsDelta = mMaxPhysicsSteps * PHYSICS_TIMESTEP;
+	if (physicsDelta > maxPhysicsDelta)
+	{
+		mDroppedPhysicsTime += physicsDelta - maxPhysicsDelta;
+		// a headless run has a fixed frame delta, so the dropped time means it is misconfigured rather than slow
+		if (gApp.IsHeadless()) ocWarning << "Frame delta exceeds " << mMaxPhysicsSteps << " physics steps; dropping " << physicsDelta - maxPhysicsDelta << " s of game time";
+		else ocChannelDebug(LC_CORE) << "Physics can't keep up; dropping " << physicsDelta - maxPhysicsDelta << " s of game time";
+		physicsDelta = maxPhysicsDelta;
+	}
+	while (physicsDelta >= PHYSICS_TIMESTEP - PHYSICS_TIMESTEP_EPSILON)
 	{
 		float32 stepSize = PHYSICS_TIMESTEP;
 
@@ -220,12 +239,7 @@ void Core::Game::Update(const float32 delta)
 		gEntityMgr.BroadcastMessage(EntityMessage(EntityMessage::SYNC_POST_PHYSICS, Reflection::PropertyFunctionParameters() << stepSize));		
 
 		// process physics events
-		for (PhysicsEventList::const_iterator i=mPhysicsEvents.begin(); i!=mPhysicsEvents.end(); ++i)
-		{
-			ProcessPhysicsEvent(**i);
-			delete *i;
-		}
-		mPhysicsEvents.clear();
+		ProcessPhysicsEvents();
 
 		// destroy entities marked for destruction
 		gEntityMgr.ProcessDestroyQueue();
@@ -235,7 +249,8 @@ void Core::Game::Update(const float32 delta)
 
 		physicsDelta -= stepSize;
 	}
-	mPhysicsResidualDelta = physicsDelta;
+	// the last step may have eaten up to the epsilon more than was left
+	mPhysicsResidualDelta = physicsDelta > 0.0f ? physicsDelta : 0.0f;
 
 	if (mUpdateRootWindowCounter > 0) 
 	{
@@ -265,9 +280,9 @@ void Core::Game::Draw(const float32 passedDelta)
 		// sync the game camera with the editor camera
 		EntityHandle gameCamera = gEntityMgr.FindFirstEntity(GameCameraName);
 		EntityHandle editorCamera = gEntityMgr.FindFirstEntity(Editor::EditorGUI::EditorCameraName);
-		gameCamera.GetProperty("Zoom").SetValue(editorCamera.GetProperty("Zoom").GetValue<float32>());
-		gameCamera.GetProperty("Rotation").SetValue(editorCamera.GetProperty("Rotation").GetValue<float32>());
-		gameCamera.GetProperty("Position").SetValue(editorCamera.GetProperty("Position").GetValue<Vector2>());
+		gameCamera.GetProperty(PropertyKeys::Zoom).SetValue(editorCamera.GetProperty(PropertyKeys::Zoom).GetValue<float32>());
+		gameCamera.GetProperty(PropertyKeys::Rotation).SetValue(editorCamera.GetProperty(PropertyKeys::Rotation).GetValue<float32>());
+		gameCamera.GetProperty(PropertyKeys::Position).SetValue(editorCamera.GetProperty(PropertyKeys::Position).GetValue<Vector2>());
 	}
 	
 	gGfxRenderer.SetCurrentRenderTarget(mRenderTarget);
@@ -278,7 +293,10 @@ void Core::Game::Draw(const float32 passedDelta)
 		gEntityMgr.BroadcastMessage(EntityMessage(EntityMessage::DRAW, Reflection::PropertyFunctionParameters() << delta));
 	}
 
+	// the entities are drawn in between the last two physics steps according to the time left for the next step
+	if (IsActionRunning()) gGfxRenderer.SetInterpolationFactor(mPhysicsResidualDelta / PHYSICS_TIMESTEP);
 	gGfxRenderer.DrawEntities();
+	gGfxRenderer.SetInterpolationFactor(1.0f);
 
 	gGfxRenderer.FinalizeRenderTarget();
 }
@@ -366,21 +384,22 @@ bool Core::Game::PhysicsCallbacks::ShouldCollide(b2Fixture* fixtureA, b2Fixture*
 
 void Core::Game::PhysicsCallbacks::BeginContact(b2Contact* contact)
 {
-	PhysicsEvent* evt = new PhysicsEvent();
+	mParent->mPhysicsEvents.push_back(PhysicsEvent());
+	PhysicsEvent& evt = mParent->mPhysicsEvents.back();
 
-	evt->type = PhysicsEvent::COLLISION_STARTED;
+	evt.type = PhysicsEvent::COLLISION_STARTED;
 
 	void* userData1 = contact->GetFixtureA()->GetUserData();
 	void* userData2 = contact->GetFixtureB()->GetUserData();
-	if (userData1) evt->entity1 = *(EntityHandle*)userData1;
-	else evt->entity1.Invalidate();
-	if (userData2) evt->entity2 = *(EntityHandle*)userData2;
-	else evt->entity2.Invalidate();
+	if (userData1) evt.entity1 = *(EntityHandle*)userData1;
+	else evt.entity1.Invalidate();
+	if (userData2) evt.entity2 = *(EntityHandle*)userData2;
+	else evt.entity2.Invalidate();
 
 	b2WorldManifold worldManifold;
 	contact->GetWorldManifold(&worldManifold);
 	
-	evt->normal = worldManifold.normal;
+	evt.normal = worldManifold.normal;
 
 	Vector2 worldPoint = Vector2_Zero;
 	int32 pointCount = contact->GetManifold()->pointCount;
@@ -393,46 +412,76 @@ void Core::Game::PhysicsCallbacks::BeginContact(b2Contact* contact)
 		worldPoint.x = worldPoint.x / pointCount;
 		worldPoint.y = worldPoint.y / pointCount;
 	}
-	evt->contactPoint = worldPoint;
-
-	mParent->mPhysicsEvents.push_back(evt);
+	evt.contactPoint = worldPoint;
 }
 
 void Core::Game::PhysicsCallbacks::EndContact(b2Contact* contact)
 {
-	PhysicsEvent* evt = new PhysicsEvent();
+	mParent->mPhysicsEvents.push_back(PhysicsEvent());
+	PhysicsEvent& evt = mParent->mPhysicsEvents.back();
 
-	evt->type = PhysicsEvent::COLLISION_ENDED;
+	evt.type = PhysicsEvent::COLLISION_ENDED;
 
 	void* userData1 = contact->GetFixtureA()->GetUserData();
 	void* userData2 = contact->GetFixtureB()->GetUserData();
-	if (userData1) evt->entity1 = *(EntityHandle*)userData1;
-	else evt->entity1.Invalidate();
-	if (userData2) evt->entity2 = *(EntityHandle*)userData2;
-	else evt->entity2.Invalidate();
-
-	mParent->mPhysicsEvents.push_back(evt);
+	if (userData1) evt.entity1 = *(EntityHandle*)userData1;
+	else evt.entity1.Invalidate();
+	if (userData2) evt.entity2 = *(EntityHandle*)userData2;
+	else evt.entity2.Invalidate();
 }
 
-void Core::Game::ProcessPhysicsEvent(const PhysicsEvent& evt)
+void Core::Game::ProcessPhysicsEvents(void)
 {
-	if (!evt.entity1.IsValid() || !evt.entity2.IsValid() || !evt.entity1.Exists() || !evt.entity2.Exists())
-		return;
-
-	if (evt.type == PhysicsEvent::COLLISION_STARTED)
+	// both entities of each event receive it
+	for (uint32 i=0; i<mPhysicsEvents.size(); ++i)
 	{
-		gEntityMgr.PostMessage(evt.entity1, EntityMessage(EntityMessage::COLLISION_STARTED, PropertyFunctionParameters() << evt.entity2 << evt.normal << evt.contactPoint));
-		gEntityMgr.PostMessage(evt.entity2, EntityMessage(EntityMessage::COLLISION_STARTED, PropertyFunctionParameters() << evt.entity1 << evt.normal << evt.contactPoint));
+		const PhysicsEvent& evt = mPhysicsEvents[i];
+		if (!evt.entity1.IsValid() || !evt.entity2.IsValid() || !evt.entity1.Exists() || !evt.entity2.Exists())
+			continue;
+
+		PhysicsEventReceiver receiver;
+		receiver.eventIndex = i;
+		receiver.entity = evt.entity1.GetID();
+		receiver.isFirstEntity = true;
+		mPhysicsEventReceivers.push_back(receiver);
+		receiver.entity = evt.entity2.GetID();
+		receiver.isFirstEntity = false;
+		mPhysicsEventReceivers.push_back(receiver);
 	}
-	else if (evt.type == PhysicsEvent::COLLISION_ENDED)
-	{
-		gEntityMgr.PostMessage(evt.entity1, EntityMessage(EntityMessage::COLLISION_ENDED, PropertyFunctionParameters() << evt.entity2));
-		gEntityMgr.PostMessage(evt.entity2, EntityMessage(EntityMessage::COLLISION_ENDED, PropertyFunctionParameters() << evt.entity1));
-	}
-	else
+
+	// each entity gets its events in the order they happened
+	Containers::sort(mPhysicsEventReceivers.begin(), mPhysicsEventReceivers.end());
+
+	PhysicsEventReceiverList::const_iterator groupEnd;
+	for (PhysicsEventReceiverList::const_iterator it=mPhysicsEventReceivers.begin(); it!=mPhysicsEventReceivers.end(); it=groupEnd)
 	{
-		ocError << "Unknown physics event";
+		const PhysicsEvent& firstEvt = mPhysicsEvents[it->eventIndex];
+		EntityHandle entity = it->isFirstEntity ? firstEvt.entity1 : firstEvt.entity2;
+		bool handlesStarted = gEntityMgr.HasEntityMessageHandler(entity, EntityMessage::COLLISION_STARTED);
+		bool handlesEnded = gEntityMgr.HasEntityMessageHandler(entity, EntityMessage::COLLISION_ENDED);
+
+		for (groupEnd=it; groupEnd!=mPhysicsEventReceivers.end() && groupEnd->entity == it->entity; ++groupEnd)
+		{
+			const PhysicsEvent& evt = mPhysicsEvents[groupEnd->eventIndex];
+			const EntityHandle& other = groupEnd->isFirstEntity ? evt.entity2 : evt.entity1;
+
+			if (evt.type == PhysicsEvent::COLLISION_STARTED)
+			{
+				if (handlesStarted) gEntityMgr.PostMessage(entity, EntityMessage(EntityMessage::COLLISION_STARTED, PropertyFunctionParameters() << other << evt.normal << evt.contactPoint));
+			}
+			else if (evt.type == PhysicsEvent::COLLISION_ENDED)
+			{
+				if (handlesEnded) gEntityMgr.PostMessage(entity, EntityMessage(EntityMessage::COLLISION_ENDED, PropertyFunctionParameters() << other));
+			}
+			else
+			{
+				ocError << "Unknown physics event";
+			}
+		}
 	}
+
+	mPhysicsEvents.clear();
+	mPhysicsEventReceivers.clear();
 }
 
 void Core::Game::PauseAction(void)
@@ -454,17 +503,9 @@ void Core::Game::ResumeAction(void)
 
 void Core::Game::SaveAction(void)
 {
-	bool result = true;
-	ResourceSystem::XMLOutput storage(mTempActionSave);
-	storage.BeginElement("Action");
-	if (!gEntityMgr.SaveEntitiesToStorage(storage, false, true)) result = false;
-	if (!SaveGameInfoToStorage(storage)) result = false;
-	storage.EndElement();
-	result = result && storage.CloseAndReport();
-	
-	if (result)
+	if (SaveSnapshot(mActionSnapshot))
 	{
-		ocInfo << "Action saved in " << mTempActionSave;
+		ocInfo << "Action saved (" << mActionSnapshot.GetSize() << " bytes)";
 	}
 	else 
 	{
@@ -475,27 +516,59 @@ void Core::Game::SaveAction(void)
 void Core::Game::RestartAction(void)
 {
 	mActionRestarted = true;
-	bool result = true;
 
 	PauseAction();
-	
-	if (gResourceMgr.AddResourceFileToGroup(mTempActionSave, "Action", ResourceSystem::RESTYPE_AUTODETECT, ResourceSystem::BPT_ABSOLUTE))
-	{
-		gResourceMgr.LoadResourcesInGroup("Action");
-		gEntityMgr.DestroyAllEntities(false, true);
-		ResourceSystem::ResourcePtr resource = gResourceMgr.GetResource("Action", mTempActionSave);
-		if (!LoadGameInfoFromResource(resource)) { result = false; }
-		if (!gEntityMgr.LoadEntitiesFromResource(resource)) { result = false; }
-		gResourceMgr.DeleteGroup("Action");
-		gEntityMgr.UpdatePrototypesInstances();
-	}
-	else
+
+	if (mActionSnapshot.GetSize() > 0 && RestoreSnapshot(mActionSnapshot)) ocInfo << "Action restarted";
+	else ocError << "Action cannot be restarted!";
+}
+
+bool Core::Game::SaveSnapshot(GameSnapshot& snapshot)
+{
+	bool result = true;
+	snapshot.Clear();
+	if (!SaveGameInfoToBinary(snapshot)) result = false;
+	if (!SaveDynamicPropertiesToBinary(snapshot)) result = false;
+	if (!gEntityMgr.SaveEntitiesToBinary(snapshot, false, true)) result = false;
+	return result;
+}
+
+bool Core::Game::RestoreSnapshot(const GameSnapshot& snapshot)
+{
+	bool result = true;
+	ResourceSystem::BinaryInput input(snapshot.GetData(), snapshot.GetSize());
+	gEntityMgr.DestroyAllEntities(false, true);
+	if (!LoadGameInfoFromBinary(input)) result = false;
+	if (!LoadDynamicPropertiesFromBinary(input)) result = false;
+	if (!gEntityMgr.LoadEntitiesFromBinary(input)) result = false;
+	gEntityMgr.UpdatePrototypesInstances();
+	return result;
+}
+
+bool Core::Game::SaveGameInfoToBinary(ResourceSystem::BinaryOutput& storage)
+{
+	storage.Write<uint64>(GetTimeMillis());
+	storage.WriteString(gApp.GetGameProject()->GetOpenedSceneName());
+	storage.WriteString(gApp.GetGameProject()->GetRequestedSceneName());
+	return true;
+}
+
+bool Core::Game::LoadGameInfoFromBinary(ResourceSystem::BinaryInput& input)
+{
+	uint64 currentTime = input.Read<uint64>();
+	string sceneName = input.ReadString();
+	string requestedSceneName = input.ReadString();
+	if (input.HasFailed())
 	{
-		result = false;
+		ocError << "Binary: Game info is corrupted";
+		return false;
 	}
 
-	if (result) ocInfo << "Action restarted from " << mTempActionSave;
-	else ocError << "Action cannot be restarted!";
+	mTimer.Reset(currentTime);
+	if (!sceneName.empty()) gApp.GetGameProject()->ForceOpenSceneName(sceneName);
+	if (!requestedSceneName.empty()) gApp.GetGameProject()->RequestOpenScene(requestedSceneName);
+
+	return true;
 }
 
 bool Core::Game::SaveGameInfoToStorage(ResourceSystem::XMLOutput& storage)
@@ -530,27 +603,31 @@ bool Core::Game::LoadGameInfoFromResource(ResourceSystem::ResourcePtr res)
 		return false;
 	}
 	
-	ResourceSystem::XMLResourcePtr xml = res;
+	ResourceSystem::XMLResourcePtr xmlResource = res;
+	ResourceSystem::XMLReader xml(xmlResource);
 	uint64 currentTime = 0;
 	string sceneName, requestedSceneName;
 
-	for (ResourceSystem::XMLNodeIterator it = xml->IterateTopLevel(); it != xml->EndTopLevel(); ++it)
+	if (!xml.Read()) return false;
+	const uint32 topLevelDepth = xml.GetDepth();
+	while (xml.ReadChildElement(topLevelDepth))
 	{
-		if ((*it).compare("GameInfo") != 0) { continue; }
+		if (xml.GetName() != XML_GAME_INFO_ELEMENT) { continue; }
 
-		for (ResourceSystem::XMLNodeIterator entIt = it.IterateChildren(); entIt != it.EndChildren(); ++entIt)
+		const uint32 depth = xml.GetDepth();
+		while (xml.ReadChildElement(depth))
 		{
-			if ((*entIt).compare("CurrentTime") == 0)
+			if (xml.GetName() == XML_CURRENT_TIME_ELEMENT)
 			{
-				currentTime = entIt.GetValue<uint64>();
+				currentTime = xml.ReadElementValue<uint64>();
 			}
-			else if ((*entIt).compare("SceneName") == 0)
+			else if (xml.GetName() == XML_SCENE_NAME_ELEMENT)
 			{
-				sceneName = entIt.GetValue<string>();
+				sceneName = xml.ReadElementText();
 			}
-			else if ((*entIt).compare("RequestedSceneName") == 0)
+			else if (xml.GetName() == XML_REQUESTED_SCENE_NAME_ELEMENT)
 			{
-				requestedSceneName = entIt.GetValue<string>();
+				requestedSceneName = xml.ReadElementText();
 			}
 		}
 	}
@@ -586,24 +663,28 @@ bool Core::Game::SaveDynamicPropertiesToStorage(ResourceSystem::XMLOutput& stora
 
 bool Core::Game::LoadDynamicPropertiesFromResource(ResourceSystem::ResourcePtr res)
 {
-  mDynamicProperties.ClearProperties();
+  ClearDynamicProperties();
   if (!res)
 	{
 		ocError << "XML: Can't load data; null resource pointer";
 		return false;
 	}
 	
-	ResourceSystem::XMLResourcePtr xml = res;
+	ResourceSystem::XMLResourcePtr xmlResource = res;
+	ResourceSystem::XMLReader xml(xmlResource);
 
-	for (ResourceSystem::XMLNodeIterator it = xml->IterateTopLevel(); it != xml->EndTopLevel(); ++it)
+	if (!xml.Read()) return false;
+	const uint32 topLevelDepth = xml.GetDepth();
+	while (xml.ReadChildElement(topLevelDepth))
 	{
-		if ((*it).compare("DynamicProperties") != 0) { continue; }
+		if (xml.GetName() != XML_DYNAMIC_PROPERTIES_ELEMENT) { continue; }
 
-		for (ResourceSystem::XMLNodeIterator entIt = it.IterateChildren(); entIt != it.EndChildren(); ++entIt)
+		const uint32 depth = xml.GetDepth();
+		while (xml.ReadChildElement(depth))
 		{
-			if (entIt.HasAttribute("Type"))
+			if (xml.HasAttribute(XML_TYPE_ATTRIBUTE))
 			{
-			  string propertyTypeName = entIt.GetAttribute<string>("Type");
+			  string propertyTypeName = xml.GetAttribute<string>(XML_TYPE_ATTRIBUTE);
 			  Reflection::ePropertyType propertyType = Reflection::PropertyTypes::GetTypeFromName(propertyTypeName);
 			  if (propertyType == PT_UNKNOWN)
 			  {
@@ -611,34 +692,8 @@ bool Core::Game::LoadDynamicPropertiesFromResource(ResourceSystem::ResourcePtr r
 				  continue;
 			  }
 			  
-			  AbstractProperty* prop = 0;
-			  
-			  switch (propertyType)
-	      {
-	      // We generate cases for all property types and arrays of property types here.
-	      #define PROPERTY_TYPE(typeID, typeClass, defaultValue, typeName, scriptSetter, cloning) case typeID: \
-		      prop = new ValuedProperty<typeClass>(*entIt, PA_FULL_ACCESS, "");
-	      #include "Utils/Properties/PropertyTypes.h"
-	      #undef PROPERTY_TYPE
-
-	      #define PROPERTY_TYPE(typeID, typeClass, defaultValue, typeName, scriptSetter, cloning) case typeID##_ARRAY: \
-		      prop = new ValuedProperty<Array<typeClass>*>(*entIt, PA_FULL_ACCESS, "");
-	      #include "Utils/Properties/PropertyTypes.h"
-	      #undef PROPERTY_TYPE
-
-	      default:
-		      OC_NOT_REACHED();
-	      }
-	      
-	      if (prop)
-	      {
-	        if (mDynamicProperties.AddProperty(prop))
-	        {
-	          PropertySystem::GetProperties()->push_back(prop);
-	          prop->ReadValueXML(0, entIt);
-	        }
-			    else delete prop;
-	      }
+			  AbstractProperty* prop = CreateDynamicProperty(propertyType, xml.GetName());
+			  if (prop) prop->ReadValueXML(0, xml);
 			  
 			} else continue;
 		}
@@ -647,6 +702,108 @@ bool Core::Game::LoadDynamicPropertiesFromResource(ResourceSystem::ResourcePtr r
 	return true;
 }
 
+bool Core::Game::SaveDynamicPropertiesToBinary(ResourceSystem::BinaryOutput& storage)
+{
+	Reflection::AbstractPropertyList propertyList;
+	mDynamicProperties.EnumProperties(propertyList);
+	storage.Write<uint32>(propertyList.size());
+	for (Reflection::AbstractPropertyList::iterator it = propertyList.begin(); it != propertyList.end(); ++it)
+	{
+		storage.WriteString((*it)->GetKey().ToString());
+		storage.Write<uint8>((uint8)(*it)->GetType());
+
+		// write property value prefixed by its size, so it can be skipped
+		const uint32 valueSizePosition = storage.ReserveUInt32();
+		(*it)->WriteValueBinary(0, storage);
+		storage.WriteUInt32At(valueSizePosition, storage.GetSize() - valueSizePosition - sizeof(uint32));
+	}
+	return true;
+}
+
+bool Core::Game::LoadDynamicPropertiesFromBinary(ResourceSystem::BinaryInput& input)
+{
+	ClearDynamicProperties();
+
+	const uint32 propertiesCount = input.Read<uint32>();
+	for (uint32 i=0; i<propertiesCount && !input.HasFailed(); ++i)
+	{
+		StringKey propertyKey = input.ReadString();
+		Reflection::ePropertyType propertyType = (Reflection::ePropertyType)input.Read<uint8>();
+		ResourceSystem::BinaryInput valueInput = input.ReadBlock(input.Read<uint32>());
+		if (input.HasFailed()) break;
+
+		AbstractProperty* prop = CreateDynamicProperty(propertyType, propertyKey);
+		if (prop) prop->ReadValueBinary(0, valueInput);
+	}
+
+	if (input.HasFailed())
+	{
+		ocError << "Binary: Game dynamic properties are corrupted";
+		return false;
+	}
+	return true;
+}
+
+AbstractProperty* Core::Game::CreateDynamicProperty(const Reflection::ePropertyType type, const StringKey& name)
+{
+	AbstractProperty* prop = 0;
+
+	switch (type)
+	{
+	// We generate cases for all property types and arrays of property types here.
+	#define PROPERTY_TYPE(typeID, typeClass, defaultValue, typeName, scriptSetter, cloning) case typeID: \
+		prop = new ValuedProperty<typeClass>(name, PA_FULL_ACCESS, ""); \
+		break;
+	#include "Utils/Properties/PropertyTypes.h"
+	#undef PROPERTY_TYPE
+
+	#define PROPERTY_TYPE(typeID, typeClass, defaultValue, typeName, scriptSetter, cloning) case typeID##_ARRAY: \
+		prop = new ValuedProperty<Array<typeClass>*>(name, PA_FULL_ACCESS, ""); \
+		break;
+	#include "Utils/Properties/PropertyTypes.h"
+	#undef PROPERTY_TYPE
+
+	default:
+		ocError << "Game dynamic properties: Unknown property type " << (int32)type << ".";
+		return 0;
+	}
+
+	if (!mDynamicProperties.AddProperty(prop))
+	{
+		delete prop;
+		return 0;
+	}
+	PropertySystem::GetProperties()->push_back(prop);
+	return prop;
+}
+
+void Core::Game::DestroyDynamicProperty(AbstractProperty* prop)
+{
+	PropertySystem::GetProperties()->remove(prop);
+	delete prop;
+}
+
+void Core::Game::ClearDynamicProperties()
+{
+	// the properties are owned by the global list, so they must be released there as well
+	Reflection::AbstractPropertyList propertyList;
+	mDynamicProperties.EnumProperties(propertyList);
+	mDynamicProperties.ClearProperties();
+	for (Reflection::AbstractPropertyList::iterator it = propertyList.begin(); it != propertyList.end(); ++it)
+	{
+		DestroyDynamicProperty(*it);
+	}
+}
+
+bool Core::Game::DeleteDynamicProperty(const string& propName)
+{
+	AbstractProperty* prop = mDynamicProperties.GetProperty(propName);
+	if (!prop) return false;
+	mDynamicProperties.DeleteProperty(propName);
+	DestroyDynamicProperty(prop);
+	return true;
+}
+
 bool Core::Game::SaveToFile(const string& fileName)
 {
   bool result = true;
@@ -7,6 +7,7 @@
 #include "Base.h"
 #include "StateMachine.h"
 #include "InputSystem/IInputListener.h"
+#include "ResourceSystem/BinaryOutput.h"
 
 namespace Core
 {
@@ -23,6 +24,9 @@ namespace Core
 		GS_NORMAL
 	};
 
+	/// State of the game captured in memory by Game::SaveSnapshot.
+	typedef ResourceSystem::BinaryOutput GameSnapshot;
+
 	/// This class holds all info related directly to the game itself and takes care about rendering, input and game
 	/// logic. Basically it connects more parts of the whole system together to create the game engine. As the application
 	/// itself it is state-driven as well which means the game can be only in a single state (Core::eGameState) at the
@@ -31,8 +35,8 @@ namespace Core
 	{
 	public:
 
-		/// Constructs the game while defining a directory to store temporary game stuff.
-		Game(const string& tempDirectory);
+		/// Default constructor.
+		Game(void);
 
 		/// Default destructor.
 		virtual ~Game(void);
@@ -95,6 +99,13 @@ namespace Core
 		/// Restarts the game action to the initial (saved) state.
 		void RestartAction(void);
 
+		/// Captures the state of all entities including the transient ones, the game info and the dynamic properties
+		/// into the snapshot. The snapshot is kept in memory only, so it's cheap enough to be taken even periodically.
+		bool SaveSnapshot(GameSnapshot& snapshot);
+
+		/// Restores the state captured by SaveSnapshot. All current entities are destroyed.
+		bool RestoreSnapshot(const GameSnapshot& snapshot);
+
 		/// Returns the current game time.
 		inline uint64 GetTimeMillis(void) { return mTimer.GetMilliseconds(); }
 
@@ -104,6 +115,12 @@ namespace Core
 		/// Load the information about the game from a XML stream.
 		bool LoadGameInfoFromResource(ResourceSystem::ResourcePtr res);
 
+		/// Saves the information about the game to binary data.
+		bool SaveGameInfoToBinary(ResourceSystem::BinaryOutput& storage);
+
+		/// Load the information about the game from binary data.
+		bool LoadGameInfoFromBinary(ResourceSystem::BinaryInput& input);
+
 		//@}
 
 
@@ -113,6 +130,10 @@ namespace Core
 		/// Returns the physics engine.
 		inline Physics* GetPhysics(void) { return mPhysics; }
 
+		/// Returns the game time (in seconds) skipped since the game was inited, because the physics couldn't keep up
+		/// with it in the maximal number of steps per frame.
+		inline float32 GetDroppedPhysicsTime(void) const { return mDroppedPhysicsTime; }
+
 		//@}
 
 
@@ -140,13 +161,13 @@ namespace Core
 		//@{
 		
 		/// Clears the dynamic property list.
-		inline void ClearDynamicProperties() { mDynamicProperties.ClearProperties(); }
+		void ClearDynamicProperties();
 		
 		/// Returns whether the specified dynamic property exists.
 		inline bool HasDynamicProperty(const string& propName) const { return mDynamicProperties.HasProperty(propName); }
 		
 		/// Deletes the specified dynamic property.
-		inline bool DeleteDynamicProperty(const string& propName) { return mDynamicProperties.DeleteProperty(propName); }
+		bool DeleteDynamicProperty(const string& propName);
 		
 		/// Gets the specified dynamic property.
 		template<typename T>
@@ -183,6 +204,12 @@ namespace Core
 		
 		/// Load the dynamic properties from a XML stream.
 		bool LoadDynamicPropertiesFromResource(ResourceSystem::ResourcePtr res);
+
+		/// Saves the dynamic properties to binary data.
+		bool SaveDynamicPropertiesToBinary(ResourceSystem::BinaryOutput& storage);
+
+		/// Load the dynamic properties from binary data.
+		bool LoadDynamicPropertiesFromBinary(ResourceSystem::BinaryInput& input);
 		
 		//@}
 		
@@ -207,14 +234,24 @@ namespace Core
 		CEGUI::Window* mRootWindow;  ///< Root window for in-game GUI elements.
 		int32 mUpdateRootWindowCounter; ///< Number of frames to keep updating the root window.
 		Reflection::PropertyMap mDynamicProperties; ///< Dymanic properties saved with the game accessible from scripts.
-		string mTempActionSave; ///< File for temporary save of the action.
+		GameSnapshot mActionSnapshot; ///< State of the action to which the restart action will rollback.
+
+		/// Creates a dynamic property of the given type and adds it to the dynamic properties. Returns null if
+		/// the property can't be added.
+		AbstractProperty* CreateDynamicProperty(const Reflection::ePropertyType type, const StringKey& name);
+
+		/// Removes the dynamic property from the global list of properties and deletes it. The property must be
+		/// removed from the dynamic properties before.
+		void DestroyDynamicProperty(AbstractProperty* prop);
 
 
 		// Physics.
 		Physics* mPhysics;
 		float32 mPhysicsResidualDelta; ///< Part of the timestep delta we didn't use for the physics update last Update.
+		int32 mMaxPhysicsSteps; ///< Maximal number of physics steps in one Update. The rest of the time is dropped.
+		float32 mDroppedPhysicsTime; ///< Total time dropped because of the limit of the physics steps.
 		/// A structure for queuing events from the physics engine.
-		struct PhysicsEvent: ClassAllocation<PhysicsEvent, ALLOCATION_POOLED>
+		struct PhysicsEvent
 		{
 			// Note that here shouldn't be any pointer to a shape cos it can be destroyed during ProcessPhysicsEvent.
 			enum eType { COLLISION_STARTED, COLLISION_ENDED, COLLISION_PRESOLVED };
@@ -224,9 +261,22 @@ namespace Core
 			Vector2 normal; ///< From entity1 to entity2. World coordinates.
 			Vector2 contactPoint; ///< World coordinates.
 		};
-		typedef vector<PhysicsEvent*> PhysicsEventList;
-		PhysicsEventList mPhysicsEvents;
-		void ProcessPhysicsEvent(const PhysicsEvent& evt);
+		/// An entity receiving a physics event.
+		struct PhysicsEventReceiver
+		{
+			EntitySystem::EntityID entity;
+			uint32 eventIndex;
+			bool isFirstEntity; ///< True if the entity is entity1 of the event.
+			bool operator<(const PhysicsEventReceiver& rhs) const { return entity < rhs.entity || (entity == rhs.entity && eventIndex < rhs.eventIndex); }
+		};
+		typedef vector<PhysicsEvent> PhysicsEventList;
+		typedef vector<PhysicsEventReceiver> PhysicsEventReceiverList;
+		PhysicsEventList mPhysicsEvents; ///< Events of the current physics step. The buffers are reused by all steps.
+		PhysicsEventReceiverList mPhysicsEventReceivers;
+
+		/// Delivers the queued physics events to the entities and empties the queue.
+		/// The events are grouped by the receiving entity, so entities without a collision handler are skipped at once.
+		void ProcessPhysicsEvents(void);
 
 	private:
 
@@ -2,6 +2,7 @@
 #include "LoadingScreen.h"
 #include "GfxSystem/Texture.h"
 #include "Editor/EditorMgr.h"
+#include "Core/Application.h"
 
 using namespace Core;
 
@@ -66,7 +67,7 @@ void Core::LoadingScreen::DoLoading( eType type, const string& sceneName )
 		gResourceMgr.LoadResourcesInGroup("Scripts");
 
 		// start up the GUI stuff
-		gGUIMgr.InitResources();
+		if (GUISystem::GUIMgr::SingletonExists()) gGUIMgr.InitResources();
 
 		break;
 
@@ -82,7 +83,7 @@ void Core::LoadingScreen::DoLoading( eType type, const string& sceneName )
 
 
 	// enforce minimum anim time limit
-	while (mAnimationEndTimer.GetMilliseconds() < 1000.0f * LOADING_ANIM_MIN_TIME)
+	while (!gApp.IsHeadless() && mAnimationEndTimer.GetMilliseconds() < 1000.0f * LOADING_ANIM_MIN_TIME)
 	{
 		Draw();
 	}
@@ -152,6 +153,13 @@ void Core::LoadingScreen::ResourceLoadEnded( void )
 	Draw();
 }
 
+void Core::LoadingScreen::ResourceGroupLoadProgress( uint32 loadedCount, uint32 resourceCount )
+{
+	OC_UNUSED(loadedCount);
+	OC_UNUSED(resourceCount);
+	Draw();
+}
+
 void Core::LoadingScreen::ResourceGroupLoadEnded( void )
 {
 	Draw();
@@ -46,6 +46,7 @@ namespace Core
 		virtual void ResourceGroupLoadStarted(const string& groupName, uint32 resourceCount);
 		virtual void ResourceLoadStarted(const ResourceSystem::Resource* resource);
 		virtual void ResourceLoadEnded(void);
+		virtual void ResourceGroupLoadProgress(uint32 loadedCount, uint32 resourceCount);
 		virtual void ResourceGroupLoadEnded(void);
 		//@}
 
@@ -11,11 +11,15 @@
 #include "GUISystem/ViewportWindow.h"
 #include "EntitySystem/EntityMgr/LayerMgr.h"
 #include "Utils/FilesystemUtils.h"
+#include "ResourceSystem/BinaryOutput.h"
 
 using namespace Core;
 
 const char* Project::PROJECT_FILE_NAME = "project.ini";
 
+/// Suffix appended to the file name of a scene to get the file name of its binary version.
+const char* BINARY_SCENE_SUFFIX = ".bin";
+
 
 Project::Project(bool editorSupport): mProjectConfig(0), mSceneIndex(-1), mRequestSceneIndex(-1), mEditorSupport(editorSupport)
 {
@@ -105,7 +109,7 @@ bool Project::OpenProject(const string& path)
 	// Load prototypes.
 	gEntityMgr.LoadPrototypes();
 
-	gGfxWindow.SetWindowCaption(mProjectInfo.name);
+	SetWindowCaption(mProjectInfo.name);
 
 	ocInfo << "Project " << path << " loaded.";
 
@@ -140,7 +144,7 @@ void Project::CloseProject()
 		gEditorMgr.OnProjectClosed();
 	}
 
-	gGfxWindow.SetWindowCaption("");
+	SetWindowCaption("");
 
 	ocInfo << "Project closed.";
 }
@@ -235,6 +239,11 @@ void Core::Project::SaveProjectConfig()
 	ocInfo << "Project " << mProjectPath << " saved.";
 }
 
+void Project::SetWindowCaption(const string& caption)
+{
+	if (GfxSystem::GfxWindow::SingletonExists()) gGfxWindow.SetWindowCaption(caption);
+}
+
 void Project::CreateDefaultProjectStructure()
 {
 	try
@@ -292,7 +301,7 @@ bool Project::CreateScene(const string& sceneInputFilename, const string& sceneN
 
 	if (mEditorSupport)
 	{
-		gGfxWindow.SetWindowCaption(mProjectInfo.name + " (" + sceneFilename + ")");
+		SetWindowCaption(mProjectInfo.name + " (" + sceneFilename + ")");
 	}
 
 	OpenSceneAtIndex(mSceneIndex);
@@ -347,9 +356,23 @@ void Core::Project::OpenScene( const ResourceSystem::ResourcePtr resource )
 
 	// Set the in-game GUI root window
 	if (gApp.IsEditMode()) game.SetRootWindow(gEditorMgr.GetGameViewport());
-	else game.CreateDefaultRootWindow();
+	else if (!gApp.IsHeadless()) game.CreateDefaultRootWindow();
 
-	gEntityMgr.LoadEntitiesFromResource(resource);
+	// the binary version of the scene loads much faster, but the editor works with the XML version
+	ResourceSystem::ResourcePtr sceneData = gApp.IsEditMode() ? resource : GetBinaryScene(resource);
+	const bool sceneLoaded = gEntityMgr.LoadEntitiesFromResource(sceneData);
+	if (sceneData != resource)
+	{
+		sceneData->Unload();
+		if (!sceneLoaded)
+		{
+			// an old or damaged binary version must not leave the scene half loaded
+			ocWarning << "Binary version of scene " << resource->GetName() << " can't be loaded; loading XML and regenerating it.";
+			gEntityMgr.DestroyAllEntities(false, true);
+			gLayerMgr.Clear();
+			if (gEntityMgr.LoadEntitiesFromResource(resource)) SaveBinaryScene(resource);
+		}
+	}
 
 	game.Init();
 
@@ -366,7 +389,7 @@ void Core::Project::OpenScene( const ResourceSystem::ResourcePtr resource )
 
 	if (mEditorSupport)
 	{
-		gGfxWindow.SetWindowCaption(mProjectInfo.name + " (" + resource->GetName() + ")");
+		SetWindowCaption(mProjectInfo.name + " (" + resource->GetName() + ")");
 		gEditorMgr.OnSceneOpened();
 	}
 
@@ -405,6 +428,7 @@ bool Project::SaveOpenedScene()
 	if (xmlOutput.CloseAndReport())
 	{
 		ocInfo << "Scene " << mSceneList[mSceneIndex].filename << " saved.";
+		SaveBinaryScene(sceneResource);
 		return true;
 	}
 	else
@@ -419,7 +443,7 @@ void Project::CloseOpenedScene()
 	if (!IsSceneOpened()) return;
 
 	mSceneIndex = -1;
-	gGfxWindow.SetWindowCaption(mProjectInfo.name);
+	SetWindowCaption(mProjectInfo.name);
 	gEntityMgr.DestroyAllEntities(false, true);
 	gLayerMgr.Clear();
 	if (mEditorSupport)
@@ -568,4 +592,42 @@ string Core::Project::FixSceneFilename( const string& oldName )
 	string fixedName = oldName;
 	if (!hasEnding(fixedName, ".xml")) fixedName = fixedName + ".xml";
 	return fixedName;
-}
\ No newline at end of file
+}
+
+bool Core::Project::SaveBinaryScene( const ResourceSystem::ResourcePtr sceneResource )
+{
+	ResourceSystem::BinaryOutput binaryOutput;
+	if (!gEntityMgr.SaveEntitiesToBinary(binaryOutput) || !binaryOutput.SaveToFile(sceneResource->GetFilePath() + BINARY_SCENE_SUFFIX))
+	{
+		ocWarning << "Unable to save binary version of scene " << sceneResource->GetName() << ".";
+		return false;
+	}
+	return true;
+}
+
+ResourceSystem::ResourcePtr Core::Project::GetBinaryScene( const ResourceSystem::ResourcePtr sceneResource )
+{
+	const string binaryPath = sceneResource->GetFilePath() + BINARY_SCENE_SUFFIX;
+	const string binaryName = sceneResource->GetName() + BINARY_SCENE_SUFFIX;
+	try
+	{
+		if (!boost::filesystem::exists(binaryPath)) return sceneResource;
+		if (boost::filesystem::last_write_time(binaryPath) < boost::filesystem::last_write_time(sceneResource->GetFilePath()))
+		{
+			ocInfo << "Binary version of scene " << sceneResource->GetName() << " is out of date; loading XML.";
+			return sceneResource;
+		}
+	}
+	catch (boost::exception&)
+	{
+		return sceneResource;
+	}
+
+	if (!gResourceMgr.ResourceExists("Project", binaryName))
+	{
+		gResourceMgr.AddResourceFileToGroup(binaryName, "Project", ResourceSystem::RESTYPE_BINARYRESOURCE, ResourceSystem::BPT_PROJECT);
+	}
+	ResourceSystem::ResourcePtr binaryScene = gResourceMgr.GetResource("Project", binaryName);
+	if (!binaryScene || binaryScene->GetType() != ResourceSystem::RESTYPE_BINARYRESOURCE) return sceneResource;
+	return binaryScene;
+}
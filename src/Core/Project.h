@@ -171,6 +171,15 @@ namespace Core
 
 		/// Creates default directories and files for new project.
 		void CreateDefaultProjectStructure();
+
+		/// Sets the caption of the application window if there's any.
+		void SetWindowCaption(const string& caption);
+
+		/// Saves the binary version of the opened scene next to the scene file.
+		bool SaveBinaryScene(const ResourceSystem::ResourcePtr sceneResource);
+
+		/// Returns the binary version of the scene if it's up to date, otherwise returns the scene resource itself.
+		ResourceSystem::ResourcePtr GetBinaryScene(const ResourceSystem::ResourcePtr sceneResource);
 		
 		string mProjectPath;
 		ProjectInfo mProjectInfo;
@@ -7,11 +7,16 @@
 #include "GUISystem/PromptBox.h"
 #include "GUISystem/PopupMgr.h"
 #include "EntitySystem/EntityMgr/LayerMgr.h"
-#include "ResourceSystem/XMLResource.h"
+#include "ResourceSystem/XMLReader.h"
+#include "ResourceSystem/BinaryInput.h"
+#include "ResourceSystem/BinaryOutput.h"
 
 using namespace Editor;
 using namespace EntitySystem;
 
+const StringKey XML_ENTITY_ELEMENT("Entity");
+const StringKey XML_ID_ATTRIBUTE("ID");
+
 Editor::HierarchyWindow::HierarchyWindow(): mWindow(0), mTree(0), mCurrentParent(EntitySystem::EntityHandle::Null), mDontAddEntities(false), mIsRemovingChildEntities(false)
 {
 }
@@ -190,13 +195,27 @@ bool Editor::HierarchyWindow::CheckHierarchy()
 	return true;
 }
 
-void Editor::HierarchyWindow::LoadHierarchy( ResourceSystem::XMLNodeIterator& xml )
+void Editor::HierarchyWindow::LoadHierarchy( ResourceSystem::XMLReader& xml )
 {
 	ocInfo << "Loading hierarchy";
 
 	ClearHierarchy();
 	LoadSubtree(xml, mHierarchy.begin());
+	FinishLoadingHierarchy();
+}
 
+void Editor::HierarchyWindow::LoadHierarchy( ResourceSystem::BinaryInput& input )
+{
+	ocInfo << "Loading hierarchy";
+
+	ClearHierarchy();
+	LoadSubtree(input, mHierarchy.begin());
+	if (input.HasFailed()) ocError << "Binary hierarchy tree description is corrupted";
+	FinishLoadingHierarchy();
+}
+
+void Editor::HierarchyWindow::FinishLoadingHierarchy()
+{
 	set<EntitySystem::EntityHandle> loadedEntities;
 	for (HierarchyTree::iterator it=mHierarchy.begin(); it!=mHierarchy.end(); ++it)
 	{
@@ -234,19 +253,20 @@ void Editor::HierarchyWindow::LoadHierarchy( ResourceSystem::XMLNodeIterator& xm
 	ocInfo << "Hierarchy loaded";
 }
 
-void Editor::HierarchyWindow::LoadSubtree(ResourceSystem::XMLNodeIterator& xml, const HierarchyTree::iterator_base& parent)
+void Editor::HierarchyWindow::LoadSubtree(ResourceSystem::XMLReader& xml, const HierarchyTree::iterator_base& parent)
 {
-	for (ResourceSystem::XMLNodeIterator iter=xml.IterateChildren(); iter!=xml.EndChildren(); ++iter)
+	const uint32 depth = xml.GetDepth();
+	while (xml.ReadChildElement(depth))
 	{
-		if ((*iter).compare("Entity") != 0) continue;
-		if (!iter.HasAttribute("ID"))
+		if (xml.GetName() != XML_ENTITY_ELEMENT) continue;
+		if (!xml.HasAttribute(XML_ID_ATTRIBUTE))
 		{
 			ocError << "Missing attribute 'ID' in the hierarchy tree description";	
 			continue;
 		}
-		EntitySystem::EntityHandle entity = EntitySystem::EntityHandle(iter.GetAttribute<EntitySystem::EntityID>("ID"));
+		EntitySystem::EntityHandle entity = EntitySystem::EntityHandle(xml.GetAttribute<EntitySystem::EntityID>(XML_ID_ATTRIBUTE));
 		HierarchyTree::iterator childIter = mHierarchy.append_child(parent, entity);
-		LoadSubtree(iter, childIter);
+		LoadSubtree(xml, childIter);
 	}
 }
 
@@ -269,6 +289,32 @@ void Editor::HierarchyWindow::SaveSubtree( ResourceSystem::XMLOutput& storage, c
 	}
 }
 
+void Editor::HierarchyWindow::LoadSubtree(ResourceSystem::BinaryInput& input, const HierarchyTree::iterator_base& parent)
+{
+	const uint32 childrenCount = input.Read<uint32>();
+	for (uint32 i=0; i<childrenCount && !input.HasFailed(); ++i)
+	{
+		EntitySystem::EntityHandle entity = EntitySystem::EntityHandle(input.Read<EntitySystem::EntityID>());
+		HierarchyTree::iterator childIter = mHierarchy.append_child(parent, entity);
+		LoadSubtree(input, childIter);
+	}
+}
+
+void Editor::HierarchyWindow::SaveHierarchy( ResourceSystem::BinaryOutput& storage )
+{
+	SaveSubtree(storage, mHierarchy.begin());
+}
+
+void Editor::HierarchyWindow::SaveSubtree( ResourceSystem::BinaryOutput& storage, const HierarchyTree::iterator_base& parent )
+{
+	storage.Write<uint32>(mHierarchy.number_of_children(parent));
+	for (HierarchyTree::sibling_iterator iter=mHierarchy.begin(parent); iter!=mHierarchy.end(parent); ++iter)
+	{
+		storage.Write<EntitySystem::EntityID>(iter->GetID());
+		SaveSubtree(storage, iter);
+	}
+}
+
 bool Editor::HierarchyWindow::OnTreeItemClicked( const CEGUI::EventArgs& e )
 {
 	const CEGUI::MouseEventArgs& args = static_cast<const CEGUI::MouseEventArgs&>(e);
@@ -38,11 +38,17 @@ namespace Editor
 		void Clear();
 
 		/// Loads the hierarchy from an XML input.
-		void LoadHierarchy(ResourceSystem::XMLNodeIterator& xml);
+		void LoadHierarchy(ResourceSystem::XMLReader& xml);
 
 		/// Saves the hierarchy to an XML output.
 		void SaveHierarchy(ResourceSystem::XMLOutput& storage);
 
+		/// Loads the hierarchy from a binary input.
+		void LoadHierarchy(ResourceSystem::BinaryInput& input);
+
+		/// Saves the hierarchy to a binary output.
+		void SaveHierarchy(ResourceSystem::BinaryOutput& storage);
+
 		/// Adds a new entity to the hierarchy as a parent of the current parent (see SetCurrentParent()).
 		void AddEntityToHierarchy(const EntitySystem::EntityHandle toAdd, eAddItemMode addMode = ADD_APPEND);
 
@@ -123,7 +129,16 @@ namespace Editor
 		void SaveSubtree(ResourceSystem::XMLOutput& storage, const HierarchyTree::iterator_base& parent);
 
 		/// Loads the hierarchy recursively.
-		void LoadSubtree(ResourceSystem::XMLNodeIterator& xml, const HierarchyTree::iterator_base& parent);
+		void LoadSubtree(ResourceSystem::XMLReader& xml, const HierarchyTree::iterator_base& parent);
+
+		/// Saves the hierarchy recursively.
+		void SaveSubtree(ResourceSystem::BinaryOutput& storage, const HierarchyTree::iterator_base& parent);
+
+		/// Loads the hierarchy recursively.
+		void LoadSubtree(ResourceSystem::BinaryInput& input, const HierarchyTree::iterator_base& parent);
+
+		/// Adds the entities missing in the loaded hierarchy to its root and refreshes the tree.
+		void FinishLoadingHierarchy();
 
 		/// Creates the subtree based on the saved hierarchy.
 		void SetupSubtree(const HierarchyTree::iterator_base& parentIter, const string& hierarchyPath, uint32 depth, size_t& itemIndex);
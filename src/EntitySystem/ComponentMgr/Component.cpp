@@ -3,7 +3,7 @@
 
 using namespace EntitySystem;
 
-Component::Component() {}
+Component::Component(): mPoolIndex(0) {}
 
 Component::~Component() {}
 
@@ -13,9 +13,14 @@ EntityMessage::eResult Component::HandleMessage(const EntityMessage& msg)
 	return EntityMessage::RESULT_IGNORED;
 }
 
-PropertyHolder Component::GetProperty(const StringKey name, const PropertyAccessFlags mask) const
+PropertyHolder Component::GetProperty(const StringKey& name, const PropertyAccessFlags mask) const
 {
 	const AbstractProperty* prop = GetPropertyPointer(name, mask);
 	if (prop) return PropertyHolder(const_cast<Component*> (this), const_cast<AbstractProperty*> (prop));
 	else return PropertyHolder();
-}
\ No newline at end of file
+}
+
+Component* Component::GetSiblingComponent(const eComponentType type) const
+{
+	return gEntityMgr.GetEntityComponentPtr(mOwner, type);
+}
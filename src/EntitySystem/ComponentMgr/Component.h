@@ -28,6 +28,10 @@ namespace EntitySystem
 		/// Called when a new message arrives. To be overriden.
 		virtual EntityMessage::eResult HandleMessage(const EntityMessage& msg);
 
+		/// Returns true if this component handles messages of the given type. By default it is answered by the RTTI
+		/// of the component. To be overriden by components whose handlers are known only at run-time.
+		virtual bool HasMessageHandler(const EntityMessage::eType type) const { return GetRTTI()->HandlesMessage(type); }
+
 		/// Returns a handle to the owner of this component (an entity).
 		inline EntityHandle GetOwner(void) const { return mOwner; }
 
@@ -41,10 +45,16 @@ namespace EntitySystem
 		inline void _SetType(const eComponentType type) { mType = type; }
 
 		/// Posts a message to the entity owning this component.
-		inline EntityMessage::eResult PostMessage(const EntityMessage::eType type, Reflection::PropertyFunctionParameters data = Reflection::PropertyFunctionParameters()) const { return GetOwner().PostMessage(type, data); }
+		inline EntityMessage::eResult PostMessage(const EntityMessage::eType type, const Reflection::PropertyFunctionParameters& data = Reflection::PropertyFunctionParameters()) const { return GetOwner().PostMessage(type, data); }
 
 		/// Returns a property to be get or set.
-		PropertyHolder GetProperty(const StringKey name, const PropertyAccessFlags mask = PA_FULL_ACCESS) const;
+		PropertyHolder GetProperty(const StringKey& name, const PropertyAccessFlags mask = PA_FULL_ACCESS) const;
+
+		/// Returns the first component of the given type attached to the owner entity or null if there's none.
+		/// @remarks Code called often should resolve the component once (e.g. on INIT) and keep the pointer instead of
+		/// going through the properties. The pointer stays valid as long as the component exists, which is guaranteed
+		/// for the components this one depends on.
+		Component* GetSiblingComponent(const eComponentType type) const;
 
 		/// We don't want anyone except the ComponentMgr to create new components, but it has to be public because of the RTTI.
 		Component(void);
@@ -55,7 +65,9 @@ namespace EntitySystem
 	private:
 		EntityHandle mOwner;
 		eComponentType mType;
+		size_t mPoolIndex;
 		friend class ComponentMgr;
+		friend class ComponentPool;
 		inline void SetOwner(const EntityHandle owner) { mOwner = owner; }
 	};
 }
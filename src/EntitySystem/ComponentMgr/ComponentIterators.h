@@ -19,18 +19,18 @@ namespace EntitySystem
 	public:
 
 		/// Creates an iterator to walk across entity components in the given list. Beginning with the first item.
-		EntityComponentsIterator(ComponentsList* componentsList):
+		EntityComponentsIterator(const ComponentsList* componentsList):
 			ComponentsList::const_iterator(componentsList->begin()),
 			mComponentsList(componentsList) {}
 
 		/// Creates an iterator to walk across entity components in the given list. Beginning with the first item.
-		EntityComponentsIterator(ComponentsList& componentsList):
+		EntityComponentsIterator(const ComponentsList& componentsList):
 			ComponentsList::const_iterator(componentsList.begin()),
 			mComponentsList(&componentsList) {}
 
 		/// Creates an iterator to walk across components in the given list. Beginning with the item determined by
 		/// the given iterator.
-		EntityComponentsIterator(ComponentsList* componentsList, const ComponentsList::const_iterator firstItem):
+		EntityComponentsIterator(const ComponentsList* componentsList, const ComponentsList::const_iterator firstItem):
 			ComponentsList::const_iterator(firstItem),
 			mComponentsList(componentsList) {}
 
@@ -63,7 +63,7 @@ namespace EntitySystem
 		}
 
 	private:
-		ComponentsList* mComponentsList;
+		const ComponentsList* mComponentsList;
 	};
 
 }
@@ -1,6 +1,7 @@
 #include "Common.h"
 #include "ComponentMgr.h"
 #include "Component.h"
+#include "ComponentPool.h"
 
 #include "../Components/_ComponentHeaders.h"
 
@@ -8,19 +9,24 @@ using namespace EntitySystem;
 
 ComponentMgr::ComponentMgr()
 {
-	mComponentCreationMethod[NUM_COMPONENT_TYPES-1] = 0;
+	mComponentPools[NUM_COMPONENT_TYPES-1] = 0;
 
 	// register components
-	#define COMPONENT_TYPE(cls) mComponentCreationMethod[CT_##cls] = (ComponentCreationMethod)cls::GetClassRTTI()->GetClassFactory();
+	#define COMPONENT_TYPE(cls) mComponentPools[CT_##cls] = new TypedComponentPool<cls>();
 	#include "../Components/_ComponentTypes.h"
 	#undef COMPONENT_TYPE
 
-	OC_ASSERT(mComponentCreationMethod[NUM_COMPONENT_TYPES-1]);
+	OC_ASSERT(mComponentPools[NUM_COMPONENT_TYPES-1]);
 }
 
 ComponentMgr::~ComponentMgr()
 {
 	OC_ASSERT_MSG(mEntityComponentsMap.size()==0, "ComponentsMap not empty. (EntityMgr should erase it before deleting ComponentMgr)");
+
+	for (int32 i=0; i<NUM_COMPONENT_TYPES; ++i)
+	{
+		delete mComponentPools[i];
+	}
 }
 
 EntityComponentsIterator ComponentMgr::GetEntityComponents(EntityID id) const
@@ -33,16 +39,16 @@ EntityComponentsIterator ComponentMgr::GetEntityComponents(EntityID id) const
 ComponentID ComponentMgr::CreateComponent(const EntityID id, const eComponentType type)
 {
 	OC_ASSERT(type < NUM_COMPONENT_TYPES && type >= 0);
-	Component* cmp = mComponentCreationMethod[type]();
-	EntityComponentsMap::const_iterator entIt = mEntityComponentsMap.find(id);
+	EntityComponentsMap::iterator entIt = mEntityComponentsMap.find(id);
 	OC_ASSERT(entIt != mEntityComponentsMap.end());
-	entIt->second->push_back(cmp);
+	Component* cmp = mComponentPools[type]->CreateComponent();
+	entIt->second.push_back(cmp);
 	cmp->SetOwner(EntityHandle(id));
 	cmp->_SetType(type);
 	cmp->Create();
-	ComponentID cmpID = entIt->second->size()-1;
+	ComponentID cmpID = entIt->second.size()-1;
 
-	ocTrace << "Created component " << cmpID << " in entity " << id << " of type " << type;
+	ocChannelTrace(LC_ENTITIES) << "Created component " << cmpID << " in entity " << id << " of type " << type;
 	return cmpID;
 }
 
@@ -51,16 +57,15 @@ void ComponentMgr::DestroyEntityComponents(EntityID id)
 	EntityComponentsMap::iterator iter = mEntityComponentsMap.find(id);
 	if (iter == mEntityComponentsMap.end()) return;
 
-	ComponentsList& cmpList = *iter->second;
+	ComponentsList& cmpList = iter->second;
 	for (ComponentsList::iterator i=cmpList.begin(); i!=cmpList.end(); ++i)
 	{
 		(*i)->Destroy();
 	}
 	for (ComponentsList::iterator i=cmpList.begin(); i!=cmpList.end(); ++i)
 	{
-		delete (*i);
+		ReleaseComponent(*i);
 	}
-	delete iter->second;
 	mEntityComponentsMap.erase(iter);
 }
 
@@ -73,18 +78,24 @@ void EntitySystem::ComponentMgr::DestroyComponent( const EntityID id, const Comp
 		return;
 	}
 
-	ComponentsList* components = iter->second;
-	if ((size_t)componentToDestroy >= components->size())
+	ComponentsList& components = iter->second;
+	if ((size_t)componentToDestroy >= components.size())
 	{
 		ocError << "Invalid component ID to destroy: " << componentToDestroy;
 		return;
 	}
 
-	Component* cmp = (*components)[componentToDestroy];
+	Component* cmp = components[componentToDestroy];
 	cmp->Destroy();
-	delete cmp;
+	ReleaseComponent(cmp);
+
+	components.erase(components.begin() + componentToDestroy);
+}
 
-	components->erase(components->begin() + componentToDestroy);
+void EntitySystem::ComponentMgr::ReleaseComponent( Component* cmp )
+{
+	OC_DASSERT(cmp->GetType() < NUM_COMPONENT_TYPES && cmp->GetType() >= 0);
+	mComponentPools[cmp->GetType()]->DestroyComponent(cmp);
 }
 
 Component* EntitySystem::ComponentMgr::GetEntityComponent( const EntityID id, const ComponentID cmpID ) const
@@ -96,15 +107,13 @@ Component* EntitySystem::ComponentMgr::GetEntityComponent( const EntityID id, co
 		return 0;
 	}
 
-	OC_DASSERT(iter->second);
-
-	if ((size_t)cmpID >= iter->second->size())
+	if ((size_t)cmpID >= iter->second.size())
 	{
 		ocError << "Invalid ComponentID of " << cmpID << " when trying to get a component of entity " << id;
 		return 0;
 	}
 
-	return (*iter->second)[cmpID];	
+	return iter->second[cmpID];	
 }
 
 int32 EntitySystem::ComponentMgr::GetNumberOfEntityComponents( const EntityID id ) const
@@ -113,8 +122,13 @@ int32 EntitySystem::ComponentMgr::GetNumberOfEntityComponents( const EntityID id
 	if (iter == mEntityComponentsMap.end())
 		return 0; // no components
 
-	OC_DASSERT(iter->second);
-	return iter->second->size();
+	return iter->second.size();
+}
+
+int32 EntitySystem::ComponentMgr::GetNumberOfComponentsOfType( const eComponentType type ) const
+{
+	OC_ASSERT(type < NUM_COMPONENT_TYPES && type >= 0);
+	return mComponentPools[type]->GetComponentsCount();
 }
 
 void EntitySystem::ComponentMgr::PrepareForEntity( const EntityID id )
@@ -122,7 +136,7 @@ void EntitySystem::ComponentMgr::PrepareForEntity( const EntityID id )
 	EntityComponentsMap::const_iterator entIt = mEntityComponentsMap.find(id);
 	if (entIt == mEntityComponentsMap.end())
 	{
-		mEntityComponentsMap[id] = new ComponentsList();
+		mEntityComponentsMap[id] = ComponentsList();
 	}
 }
 
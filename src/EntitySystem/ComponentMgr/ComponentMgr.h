@@ -11,13 +11,13 @@
 
 namespace EntitySystem
 {
-	/// Type used for a registration function of individual components.
-	typedef Component* (*ComponentCreationMethod)(void);
+	class ComponentPool;
 
 	/// This class manages instances of all entity components in the system. Every entity consist only of these
 	/// components plus some minor attributes.
 	/// @remarks
 	/// Components are registered automatically by taking their definitions from the ComponentTypes.h file.
+	/// Components of the same type are stored together in a pool, so they can be walked linearly in memory.
 	class ComponentMgr : public Singleton<ComponentMgr>
 	{
 	public:
@@ -48,17 +48,23 @@ namespace EntitySystem
 
 		/// Returns the number of components of an entity.
 		int32 GetNumberOfEntityComponents(const EntityID id) const;
+
+		/// Returns the number of all components of a specified type.
+		int32 GetNumberOfComponentsOfType(const eComponentType type) const;
 		
 		/// Enums all component dependencies of the certain component type.
 		void EnumComponentDependencies(const eComponentType type, Reflection::ComponentDependencyList& out) const;
 
 	private:
 
-		typedef hash_map<EntityID, ComponentsList*> EntityComponentsMap;
+		typedef hash_map<EntityID, ComponentsList> EntityComponentsMap;
 
-		ComponentCreationMethod mComponentCreationMethod[NUM_COMPONENT_TYPES];
+		ComponentPool* mComponentPools[NUM_COMPONENT_TYPES];
 		EntityComponentsMap mEntityComponentsMap;
 
+		/// Destroys the component and returns its memory to the pool.
+		void ReleaseComponent(Component* cmp);
+
 	};
 }
 
@@ -0,0 +1,82 @@
+/// @file
+/// Pooled storage of entity components of the same type.
+
+#ifndef ComponentPool_h__
+#define ComponentPool_h__
+
+#include "Base.h"
+#include "Component.h"
+#include "ComponentIterators.h"
+#include "Memory/FreeList.h"
+
+namespace EntitySystem
+{
+	/// Storage of all components of one type. The components are allocated from a freelist, so they reside in large
+	/// chunks of memory and their addresses never change. The pool also keeps a dense list of pointers to all live
+	/// components to count them and to check that all of them were destroyed.
+	/// @remarks The per-frame systems reach the components through the broadcast subscriber lists of EntityMgr,
+	/// which keep the order of the handlers scripts rely on. Iterating packed component data is not supported yet.
+	class ComponentPool
+	{
+	public:
+
+		/// Destructor.
+		virtual ~ComponentPool(void) { OC_ASSERT_MSG(mComponents.empty(), "Components were not destroyed before their pool"); }
+
+		/// Creates a new component in the pool.
+		Component* CreateComponent(void)
+		{
+			Component* cmp = Allocate();
+			cmp->mPoolIndex = mComponents.size();
+			mComponents.push_back(cmp);
+			return cmp;
+		}
+
+		/// Destroys a component previously created by this pool.
+		void DestroyComponent(Component* cmp)
+		{
+			OC_DASSERT(cmp->mPoolIndex < mComponents.size() && mComponents[cmp->mPoolIndex] == cmp);
+			Component* last = mComponents.back();
+			mComponents[cmp->mPoolIndex] = last;
+			last->mPoolIndex = cmp->mPoolIndex;
+			mComponents.pop_back();
+			Free(cmp);
+		}
+
+		/// Returns the number of live components in the pool.
+		inline size_t GetComponentsCount(void) const { return mComponents.size(); }
+
+	protected:
+
+		/// Allocates and constructs a new component instance.
+		virtual Component* Allocate(void) = 0;
+
+		/// Destructs and deallocates a component instance.
+		virtual void Free(Component* cmp) = 0;
+
+	private:
+		ComponentsList mComponents;
+	};
+
+	/// Pool of components of the concrete type T.
+	template<class T>
+	class TypedComponentPool : public ComponentPool
+	{
+	public:
+
+		/// Destructor.
+		virtual ~TypedComponentPool(void) {}
+
+	protected:
+
+		virtual Component* Allocate(void) { return mFreeList.Allocate(); }
+
+		virtual void Free(Component* cmp) { mFreeList.Free(static_cast<T*>(cmp)); }
+
+	private:
+		typedef Memory::FreeList<T, Memory::Policies::LinkedListAllocation<T>, Memory::Policies::PlacementNewConstruction<T>, Memory::Policies::DoubleGrowth<32> > ComponentFreeList;
+		ComponentFreeList mFreeList;
+	};
+}
+
+#endif // ComponentPool_h__
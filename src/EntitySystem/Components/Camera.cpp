@@ -23,4 +23,7 @@ void EntityComponents::Camera::RegisterReflection()
 	RegisterProperty<float32>	("Zoom",		&Camera::GetZoom,		&Camera::SetZoom,		PA_FULL_ACCESS, "How big things appear in the camera. The bigger the number the bigger the objects.");
 	RegisterProperty<float32>	("Rotation",	&Camera::GetRotation,	&Camera::SetRotation,	PA_FULL_ACCESS, "Rotation along the Z axis in radians.");
 	RegisterProperty<Vector2>	("Position",	&Camera::GetPosition,	&Camera::SetPosition,	PA_FULL_ACCESS, "Position in the world.");
+
+	// the camera is only read by the renderer
+	ClearHandledMessages();
 }
@@ -1,10 +1,12 @@
 #include "Common.h"
 #include "DynamicBody.h"
+#include "Transform.h"
 #include <Box2D.h>
 
 void EntityComponents::DynamicBody::Create( void )
 {
 	mBody = 0;
+	mTransform = 0;
 	mAngularDamping = 0.5f;
 	mLinearDamping = 0.1f;
 }
@@ -23,12 +25,15 @@ EntityMessage::eResult EntityComponents::DynamicBody::HandleMessage( const Entit
 	switch (msg.type)
 	{
 	case EntityMessage::INIT:
+		// the transform is accessed directly in each physics step
+		mTransform = static_cast<Transform*>(GetSiblingComponent(CT_Transform));
+		OC_ASSERT(mTransform);
 		if (!gEntityMgr.IsEntityPrototype(GetOwner())) CreateBody();
 		return EntityMessage::RESULT_OK;
 	case EntityMessage::SYNC_PRE_PHYSICS:
 		{
-			Vector2 position = GetOwner().GetProperty("Position").GetValue<Vector2>();
-			float32 angle = GetOwner().GetProperty("Angle").GetValue<float32>();
+			Vector2 position = mTransform->GetPosition();
+			float32 angle = mTransform->GetAngle();
 			if (position != mBody->GetPosition() || angle != mBody->GetAngle())
 			{
 				mBody->SetTransform(position, angle);
@@ -37,8 +42,7 @@ EntityMessage::eResult EntityComponents::DynamicBody::HandleMessage( const Entit
 			return EntityMessage::RESULT_OK;
 		}
 	case EntityMessage::SYNC_POST_PHYSICS:
-		GetOwner().GetProperty("Position").SetValue<Vector2>(mBody->GetPosition());
-		GetOwner().GetProperty("Angle").SetValue<float32>(mBody->GetAngle());
+		mTransform->SetSimulatedTransform(mBody->GetPosition(), mBody->GetAngle());
 		return EntityMessage::RESULT_OK;
 	default:
 		break;
@@ -69,14 +73,20 @@ void EntityComponents::DynamicBody::RegisterReflection( void )
 
 	// we need the transform to be able to have the position and angle ready while creating the body
 	AddComponentDependency(CT_Transform);
+
+	// the body is created on init and synchronized with the transform around each physics step;
+	// moving the body touches the shared broadphase, but copying its state back touches only our transform
+	AddHandledMessage(EntityMessage::INIT);
+	AddHandledMessage(EntityMessage::SYNC_PRE_PHYSICS);
+	AddParallelHandledMessage(EntityMessage::SYNC_POST_PHYSICS);
 }
 
 void EntityComponents::DynamicBody::CreateBody( void )
 {
 	b2BodyDef bodyDef;
 	bodyDef.type = b2_dynamicBody;
-	bodyDef.position = GetOwner().GetProperty("Position").GetValue<Vector2>();
-	bodyDef.angle = GetOwner().GetProperty("Angle").GetValue<float32>();
+	bodyDef.position = mTransform->GetPosition();
+	bodyDef.angle = mTransform->GetAngle();
 	bodyDef.angularDamping = mAngularDamping;
 	bodyDef.linearDamping = mLinearDamping;
 	bodyDef.userData = GetOwnerPtr();
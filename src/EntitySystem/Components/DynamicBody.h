@@ -8,6 +8,8 @@
 
 namespace EntityComponents
 {
+	class Transform;
+
 	/// Physical representation of dynamic entities. This component works as a layer between entities and the physics engine.
 	class DynamicBody: public RTTIGlue<DynamicBody, Component>
 	{
@@ -86,6 +88,7 @@ namespace EntityComponents
 	private:
 
 		PhysicalBody* mBody;
+		Transform* mTransform;
 		mutable float32 mAngularDamping;
 		mutable float32 mLinearDamping;
 		mutable Array<Vector2> mContactsCache;
@@ -22,6 +22,11 @@ void EntityComponents::GUILayout::Destroy(void)
 void EntityComponents::GUILayout::ReloadWindow(void)
 {  
 	if (mRootWindow) gGUIMgr.DestroyWindow(mRootWindow);
+	mRootWindow = 0;
+
+	// headless applications have no GUI, but the callbacks of the layout still work
+	if (!GUISystem::GUIMgr::SingletonExists()) return;
+
 	if (mLayout)
 	{
 		if (mScheme)
@@ -76,7 +81,7 @@ EntityMessage::eResult EntityComponents::GUILayout::HandleMessage(const EntityMe
 				// Execute script with time out
 				if (!gScriptMgr.ExecuteContext(ctx, mCallbackTimeOut) && msg.type == EntityMessage::UPDATE_LOGIC) { mScriptUpdateError = true; }
 				// Release context
-				ctx->Release();
+				gScriptMgr.ReleaseContext(ctx);
 			} else if (msg.type == EntityMessage::UPDATE_LOGIC) { mScriptUpdateError = true; }
 		}
 	}
@@ -115,6 +120,14 @@ void EntityComponents::GUILayout::RegisterReflection()
 	RegisterProperty<uint32>("CallbackTimeOut", &GUILayout::GetCallbackTimeOut, &GUILayout::SetCallbackTimeOut, PA_FULL_ACCESS, "Maximum number of miliseconds a script can run before it is terminated (0 means unlimited).");
 	RegisterProperty<bool>("Visible", &GUILayout::GetVisible, &GUILayout::SetVisible, PA_FULL_ACCESS, "Whether the GUI layout is visible.");
 	RegisterProperty<bool>("Enabled", &GUILayout::GetEnabled, &GUILayout::SetEnabled, PA_FULL_ACCESS, "Whether the GUI layout reacts on an user input.");
+
+	// these are forwarded to the callback script as well
+	AddHandledMessage(EntityMessage::INIT);
+	AddHandledMessage(EntityMessage::POST_INIT);
+	AddHandledMessage(EntityMessage::UPDATE_LOGIC);
+	AddHandledMessage(EntityMessage::KEY_PRESSED);
+	AddHandledMessage(EntityMessage::KEY_RELEASED);
+	AddHandledMessage(EntityMessage::RESOURCE_UPDATE);
 }
 
 void EntityComponents::GUILayout::SetLayout(ResourceSystem::ResourcePtr value)
@@ -5,13 +5,18 @@
 
 void EntityComponents::Model::Create( void )
 {
+	mDrawableHandle = GfxSystem::InvalidDrawableHandle;
 	mTransparency = 0.0f;
 	mYAngle = 0.0f;
 }
 
 void EntityComponents::Model::Destroy( void )
 {
-	gGfxRenderer.GetSceneManager()->RemoveDrawable(this);
+	if (mDrawableHandle != GfxSystem::InvalidDrawableHandle)
+	{
+		gGfxRenderer.GetSceneManager()->RemoveDrawable(mDrawableHandle);
+		mDrawableHandle = GfxSystem::InvalidDrawableHandle;
+	}
 }
 
 EntityMessage::eResult EntityComponents::Model::HandleMessage( const EntityMessage& msg )
@@ -27,10 +32,10 @@ EntityMessage::eResult EntityComponents::Model::HandleMessage( const EntityMessa
 				OC_ASSERT(mMeshHandle.get());
 			}
 
-			if (!gEntityMgr.IsEntityPrototype(GetOwner()))
+			if (!gEntityMgr.IsEntityPrototype(GetOwner()) && mDrawableHandle == GfxSystem::InvalidDrawableHandle)
 			{
 				Component* transform = gEntityMgr.GetEntityComponentPtr(GetOwner(), CT_Transform);
-				gGfxRenderer.GetSceneManager()->AddDrawable(this, transform);
+				mDrawableHandle = gGfxRenderer.GetSceneManager()->AddDrawable(this, transform);
 			}
 
 			return EntityMessage::RESULT_ERROR;
@@ -48,6 +53,9 @@ void EntityComponents::Model::RegisterReflection()
 
 	// we need the transform to be able to have the position and angle ready while creating the Model
 	AddComponentDependency(CT_Transform);
+
+	// the model only needs to register itself for drawing
+	AddHandledMessage(EntityMessage::INIT);
 }
 
 void EntityComponents::Model::SetMesh(ResourceSystem::ResourcePtr value) 
@@ -55,5 +63,6 @@ void EntityComponents::Model::SetMesh(ResourceSystem::ResourcePtr value)
 	if (value && value->GetType() == ResourceSystem::RESTYPE_MESH)
 	{
 		mMeshHandle = value; 
+		if (mDrawableHandle != GfxSystem::InvalidDrawableHandle) gGfxRenderer.GetSceneManager()->UpdateDrawable(mDrawableHandle);
 	}
 }
@@ -48,6 +48,7 @@ namespace EntityComponents
 	private:
 
 		ResourceSystem::ResourcePtr mMeshHandle;
+		GfxSystem::DrawableHandle mDrawableHandle;
 		float32 mTransparency;
 		float32 mYAngle;
 	};
@@ -1,5 +1,7 @@
 #include "Common.h"
 #include "PolygonCollider.h"
+#include "Transform.h"
+#include "EntitySystem/EntityMgr/PropertyKeys.h"
 #include <Box2D.h>
 
 void EntityComponents::PolygonCollider::Create( void )
@@ -7,6 +9,7 @@ void EntityComponents::PolygonCollider::Create( void )
 	mShape = 0;
 	mDensity = 1;
 	mSensorBody = 0;
+	mTransform = 0;
 	mFriction = 0.5f;
 	mRestitution = 0.5f;
 }
@@ -21,17 +24,20 @@ EntityMessage::eResult EntityComponents::PolygonCollider::HandleMessage( const E
 	switch (msg.type)
 	{
 	case EntityMessage::POST_INIT: // we have to wait until the physical bodies are inited, that's why we're using POST_INIT
+		// the transform is accessed directly in each physics step
+		mTransform = static_cast<Transform*>(GetSiblingComponent(CT_Transform));
+		OC_ASSERT(mTransform);
 		if (!gEntityMgr.IsEntityPrototype(GetOwner())) RecreateShape();
 		return EntityMessage::RESULT_OK;
 	case EntityMessage::SYNC_PRE_PHYSICS:
-		if (mPolygon.GetSize() != 0 && !(mPolygonScale == GetOwner().GetProperty("Scale").GetValue<Vector2>()))
+		if (mPolygon.GetSize() != 0 && !(mPolygonScale == mTransform->GetScale()))
 		{
 			RecreateShape();
 		}
 		else if (mSensorBody)
 		{
-			Vector2 position = GetOwner().GetProperty("Position").GetValue<Vector2>();
-			float32 angle = GetOwner().GetProperty("Angle").GetValue<float32>();
+			Vector2 position = mTransform->GetPosition();
+			float32 angle = mTransform->GetAngle();
 			if (position != mSensorBody->GetPosition() || angle != mSensorBody->GetAngle())
 			{
 				mSensorBody->SetTransform(position, angle);
@@ -66,6 +72,12 @@ void EntityComponents::PolygonCollider::RegisterReflection( void )
 
 	// we need the transform to be able to have the position and angle ready while creating the body
 	AddComponentDependency(CT_Transform);
+
+	// the shape must be recreated whenever the body it is attached to changes
+	AddHandledMessage(EntityMessage::POST_INIT);
+	AddHandledMessage(EntityMessage::SYNC_PRE_PHYSICS);
+	AddHandledMessage(EntityMessage::COMPONENT_CREATED);
+	AddHandledMessage(EntityMessage::COMPONENT_DESTROYED);
 }
 
 void EntityComponents::PolygonCollider::RecreateShape( void )
@@ -80,7 +92,7 @@ void EntityComponents::PolygonCollider::RecreateShape( void )
 
 	// define the shape
 	b2PolygonShape shapeDef;
-	mPolygonScale = GetOwner().GetProperty("Scale").GetValue<Vector2>();
+	mPolygonScale = GetOwner().GetProperty(PropertyKeys::Scale).GetValue<Vector2>();
 	b2Vec2* vertices = new b2Vec2[mPolygon.GetSize()];
 	GetBox2dVertices(&mPolygon, vertices);
 	shapeDef.Set(vertices, mPolygon.GetSize());
@@ -96,7 +108,7 @@ void EntityComponents::PolygonCollider::RecreateShape( void )
 	PhysicalBody* body = 0;
 	if (GetOwner().HasProperty("PhysicalBody"))
 	{
-		PropertyHolder bodyProp = GetOwner().GetProperty("PhysicalBody");
+		PropertyHolder bodyProp = GetOwner().GetProperty(PropertyKeys::PhysicalBody);
 		body = bodyProp.GetValue<PhysicalBody*>();
 	}
 	else
@@ -107,8 +119,8 @@ void EntityComponents::PolygonCollider::RecreateShape( void )
 		// create a dummy body by ourself
 		b2BodyDef bodyDef;
 		bodyDef.type = b2_staticBody;
-		bodyDef.position = GetOwner().GetProperty("Position").GetValue<Vector2>();
-		bodyDef.angle = GetOwner().GetProperty("Angle").GetValue<float32>();
+		bodyDef.position = GetOwner().GetProperty(PropertyKeys::Position).GetValue<Vector2>();
+		bodyDef.angle = GetOwner().GetProperty(PropertyKeys::Angle).GetValue<float32>();
 		bodyDef.fixedRotation = true;
 		bodyDef.userData = GetOwnerPtr();
 		mSensorBody = GlobalProperties::Get<Physics>("Physics").CreateBody(&bodyDef);
@@ -130,7 +142,7 @@ void EntityComponents::PolygonCollider::DestroyShape( void )
 	else if (GetOwner().HasProperty("PhysicalBody"))
 	{
 		// remove the shape from the body
-		PhysicalBody* body = GetOwner().GetProperty("PhysicalBody").GetValue<PhysicalBody*>();
+		PhysicalBody* body = GetOwner().GetProperty(PropertyKeys::PhysicalBody).GetValue<PhysicalBody*>();
 		if (body && mShape)
 		{
 			body->DestroyFixture(mShape);
@@ -233,7 +245,7 @@ void EntityComponents::PolygonCollider::SetRestitution( float32 val )
 
 void EntityComponents::PolygonCollider::GetBox2dVertices( Array<Vector2>* polygon, b2Vec2* vertices )
 {
-	Vector2 scale = GetOwner().GetProperty("Scale").GetValue<Vector2>();
+	Vector2 scale = GetOwner().GetProperty(PropertyKeys::Scale).GetValue<Vector2>();
 	for (int i=0; i<polygon->GetSize(); ++i)
 	{
 		vertices[i].x = scale.x * polygon->GetRawArrayPtr()[i].x;
@@ -8,6 +8,8 @@
 
 namespace EntityComponents
 {
+	class Transform;
+
 	/// Physical representation of static entities. This component works as a layer between entities and the physics engine.
 	/// It attaches itself to a physical body if there is any in the entity, or to a fixture (null body) otherwise.
 	class PolygonCollider: public RTTIGlue<PolygonCollider, Component>
@@ -57,6 +59,7 @@ namespace EntityComponents
 
 		PhysicalShape* mShape;
 		PhysicalBody* mSensorBody;
+		Transform* mTransform;
 		Array<Vector2> mPolygon;
 		Vector2 mPolygonScale;
 		mutable float32 mDensity;
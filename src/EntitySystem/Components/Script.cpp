@@ -36,7 +36,7 @@ bool Script::ExecuteScriptFunction(int32 funcId)
   // Execute script with time out
   if (!gScriptMgr.ExecuteContext(ctx, mTimeOut)) { res = false; }
   // Release context
-  ctx->Release();
+  gScriptMgr.ReleaseContext(ctx);
   return res;
 }
 
@@ -159,6 +159,19 @@ void Script::UpdateMessageHandlers(void)
 	mIsUpdating = false;
 }
 
+bool Script::HasMessageHandler(const EntityMessage::eType type) const
+{
+	// these are always handled by the component itself
+	if (type == EntityMessage::DESTROY || type == EntityMessage::RESOURCE_UPDATE) { return true; }
+
+	const char* handlerDecl = EntityMessage::GetHandlerDeclaration(type);
+	for (int32 i = 0; i < mModules.GetSize(); ++i)
+	{
+		if (gScriptMgr.ModuleHasFunction(mModules[i]->GetName().c_str(), handlerDecl)) { return true; }
+	}
+	return false;
+}
+
 EntityMessage::eResult Script::HandleMessage(const EntityMessage& msg)
 {
 	// Destroying the entity or the component is handled in the method Destroy
@@ -207,7 +220,7 @@ EntityMessage::eResult Script::HandleMessage(const EntityMessage& msg)
 		  errorFuncIds.push_back(funcId);
 		}
 		// Release context
-		ctx->Release();
+		gScriptMgr.ReleaseContext(ctx);
 	}
 	
 	// Delete all functions with errors. They will added in the next reload.
@@ -238,6 +251,8 @@ void Script::RegisterReflection()
 		PA_INIT, "Times of the execution of the action handlers");
 	RegisterProperty<int32>("ScriptCurrentArrayIndex", &Script::GetCurrentArrayIndex, 0, 
 		PA_INIT | PA_TRANSIENT, "Current index of ScriptStates and ScriptTimes");
+
+	// no handled messages are registered as the handlers are found in the script modules in run-time
 }
 
 void Script::SetModules(Utils::Array<ResourceSystem::ResourcePtr>* modules)
@@ -23,6 +23,9 @@ namespace EntityComponents
 		/// Called when a new message arrives.
 		virtual EntityMessage::eResult HandleMessage(const EntityMessage& msg);
 
+		/// Returns true if any of the script modules has a handler for the given message type.
+		virtual bool HasMessageHandler(const EntityMessage::eType type) const;
+
 		/// Called from RTTI when the component is allowed to set up its properties.
 		static void RegisterReflection(void);
 
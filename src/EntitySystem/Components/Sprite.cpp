@@ -6,6 +6,7 @@
 
 void EntityComponents::Sprite::Create( void )
 {
+	mDrawableHandle = GfxSystem::InvalidDrawableHandle;
 	mTransparency = 0.0f;
 	mFrameSize = GfxSystem::Point::Point_Zero;
 	mSkipSpace = GfxSystem::Point::Point_Zero;
@@ -18,7 +19,11 @@ void EntityComponents::Sprite::Create( void )
 
 void EntityComponents::Sprite::Destroy( void )
 {
-	gGfxRenderer.GetSceneManager()->RemoveDrawable(this);
+	if (mDrawableHandle != GfxSystem::InvalidDrawableHandle)
+	{
+		gGfxRenderer.GetSceneManager()->RemoveDrawable(mDrawableHandle);
+		mDrawableHandle = GfxSystem::InvalidDrawableHandle;
+	}
 }
 
 EntityMessage::eResult EntityComponents::Sprite::HandleMessage( const EntityMessage& msg )
@@ -34,10 +39,10 @@ EntityMessage::eResult EntityComponents::Sprite::HandleMessage( const EntityMess
 				OC_ASSERT(mTextureHandle.get());
 			}
 
-			if (!gEntityMgr.IsEntityPrototype(GetOwner()))
+			if (!gEntityMgr.IsEntityPrototype(GetOwner()) && mDrawableHandle == GfxSystem::InvalidDrawableHandle)
 			{
 				Component* transform = gEntityMgr.GetEntityComponentPtr(GetOwner(), CT_Transform);
-				gGfxRenderer.GetSceneManager()->AddDrawable(this, transform);
+				mDrawableHandle = gGfxRenderer.GetSceneManager()->AddDrawable(this, transform);
 			}
 				
 			return EntityMessage::RESULT_OK;
@@ -85,6 +90,11 @@ void EntityComponents::Sprite::RegisterReflection()
 
 	// we need the transform to be able to have the position and angle ready while creating the sprite
 	AddComponentDependency(CT_Transform);
+
+	// the sprite registers itself for drawing on init and advances its animation with the game logic;
+	// the animation state is private to the sprite, so sprites can be animated in parallel
+	AddHandledMessage(EntityMessage::INIT);
+	AddParallelHandledMessage(EntityMessage::UPDATE_LOGIC);
 }
 
 void EntityComponents::Sprite::SetTexture(ResourceSystem::ResourcePtr value)
@@ -92,6 +102,7 @@ void EntityComponents::Sprite::SetTexture(ResourceSystem::ResourcePtr value)
 	if (value && value->GetType() == ResourceSystem::RESTYPE_TEXTURE)
 	{
 		mTextureHandle = value;
+		if (mDrawableHandle != GfxSystem::InvalidDrawableHandle) gGfxRenderer.GetSceneManager()->UpdateDrawable(mDrawableHandle);
 	}
 }
 
@@ -101,6 +112,7 @@ void EntityComponents::Sprite::SetFrameSize(GfxSystem::Point value)
 	mFrameSize.y = MathUtils::Max<int32>(0,value.y);
 
 	RefreshFrameCount();
+	if (mDrawableHandle != GfxSystem::InvalidDrawableHandle) gGfxRenderer.GetSceneManager()->UpdateDrawable(mDrawableHandle);
 }
 
 void EntityComponents::Sprite::SetSkipSpace(GfxSystem::Point value)
@@ -86,6 +86,7 @@ namespace EntityComponents
 		void RefreshFrameCount();
 
 		ResourceSystem::ResourcePtr mTextureHandle;
+		GfxSystem::DrawableHandle mDrawableHandle;
 		float32 mTransparency;
 		GfxSystem::Point mFrameSize;
 		GfxSystem::Point mSkipSpace;
@@ -1,11 +1,13 @@
 #include "Common.h"
 #include "StaticBody.h"
+#include "Transform.h"
 #include <Box2D.h>
 
 
 void EntityComponents::StaticBody::Create( void )
 {
 	mBody = 0;
+	mTransform = 0;
 }
 
 void EntityComponents::StaticBody::Destroy( void )
@@ -22,12 +24,15 @@ EntityMessage::eResult EntityComponents::StaticBody::HandleMessage( const Entity
 	switch (msg.type)
 	{
 	case EntityMessage::INIT:
+		// the transform is accessed directly in each physics step
+		mTransform = static_cast<Transform*>(GetSiblingComponent(CT_Transform));
+		OC_ASSERT(mTransform);
 		if (!gEntityMgr.IsEntityPrototype(GetOwner())) CreateBody();
 		return EntityMessage::RESULT_OK;
 	case EntityMessage::SYNC_PRE_PHYSICS:	
 		{
-			Vector2 position = GetOwner().GetProperty("Position").GetValue<Vector2>();
-			float32 angle = GetOwner().GetProperty("Angle").GetValue<float32>();
+			Vector2 position = mTransform->GetPosition();
+			float32 angle = mTransform->GetAngle();
 			if (position != mBody->GetPosition() || angle != mBody->GetAngle())
 			{
 				mBody->SetTransform(position, angle);
@@ -45,14 +50,18 @@ void EntityComponents::StaticBody::RegisterReflection( void )
 
 	// we need the transform to be able to have the position and angle ready while creating the body
 	AddComponentDependency(CT_Transform);
+
+	// static bodies only follow the transform, physics never moves them
+	AddHandledMessage(EntityMessage::INIT);
+	AddHandledMessage(EntityMessage::SYNC_PRE_PHYSICS);
 }
 
 void EntityComponents::StaticBody::CreateBody( void )
 {
 	b2BodyDef bodyDef;
 	bodyDef.type = b2_staticBody;
-	bodyDef.position = GetOwner().GetProperty("Position").GetValue<Vector2>();
-	bodyDef.angle = GetOwner().GetProperty("Angle").GetValue<float32>();
+	bodyDef.position = mTransform->GetPosition();
+	bodyDef.angle = mTransform->GetAngle();
 	bodyDef.userData = GetOwnerPtr();
 
 	mBody = GlobalProperties::Get<Physics>("Physics").CreateBody(&bodyDef);
@@ -8,6 +8,8 @@
 
 namespace EntityComponents
 {
+	class Transform;
+
 	/// Physical representation of static entities. This component works as a layer between entities and the physics engine.
 	class StaticBody: public RTTIGlue<StaticBody, Component>
 	{
@@ -34,6 +36,7 @@ namespace EntityComponents
 	private:
 
 		PhysicalBody* mBody;
+		Transform* mTransform;
 
 		void CreateBody(void);
 
@@ -2,6 +2,8 @@
 #include "Transform.h"
 #include <Box2D.h>
 #include "EntitySystem/EntityMgr/LayerMgr.h"
+#include "GfxSystem/GfxSceneMgr.h"
+#include "EntitySystem/EntityMgr/PropertyKeys.h"
 
 const float32 MIN_SCALAR_SCALE = 0.01f;
 
@@ -11,6 +13,8 @@ void EntityComponents::Transform::Create( void )
 	mScale.x = 1;
 	mScale.y = 1;
 	mAngle = 0.0f;
+	mPreviousPosition.SetZero();
+	mPreviousAngle = 0.0f;
 	mDepth = 0;
 	mShape = 0;
 	mBody = 0;
@@ -54,6 +58,9 @@ void EntityComponents::Transform::RegisterReflection()
 	RegisterProperty<float32>("Angle", &Transform::GetAngle, &Transform::SetAngle, PA_FULL_ACCESS, "Rotation along the Z axis in radians.");
 	RegisterProperty<int32>("Layer", &Transform::GetLayer, &Transform::SetLayer, PA_FULL_ACCESS, "What layer the object reside in.");
 	RegisterProperty<PhysicalShape*>("PhysicalShapeDummy", &Transform::GetPhysicalShape, 0, PA_NONE | PA_TRANSIENT, "Pointer to the dummy physical shape when there's no collider in the entity.");
+
+	// the dummy picking shape is kept in sync before each physics step
+	AddHandledMessage(EntityMessage::SYNC_PRE_PHYSICS);
 }
 
 void EntityComponents::Transform::SetLayer(int32 value)
@@ -64,12 +71,40 @@ void EntityComponents::Transform::SetLayer(int32 value)
 	}
 }
 
+void EntityComponents::Transform::SetPosition( Vector2 pos )
+{
+	// the entity is moved at once, so there's nothing to interpolate
+	mPreviousPosition = pos;
+	if (mPosition == pos) return;
+	mPosition = pos;
+	NotifySceneMgr();
+}
+
+void EntityComponents::Transform::SetSimulatedTransform( const Vector2& position, const float32 angle )
+{
+	mPreviousPosition = mPosition;
+	mPreviousAngle = mAngle;
+	mAngle = angle;
+	if (mPosition == position) return;
+	mPosition = position;
+	NotifySceneMgr();
+}
+
 void EntityComponents::Transform::SetScale( Vector2 value )
 {
 	if (value.x >= MIN_SCALAR_SCALE)
 		mScale.x = value.x;
 	if (value.y >= MIN_SCALAR_SCALE)
 		mScale.y = value.y;
+	NotifySceneMgr();
+}
+
+void EntityComponents::Transform::NotifySceneMgr()
+{
+	if (GfxSystem::GfxRenderer::SingletonExists())
+	{
+		gGfxRenderer.GetSceneManager()->MarkTransformDirty(this);
+	}
 }
 
 void EntityComponents::Transform::DestroyShape()
@@ -88,8 +123,8 @@ void EntityComponents::Transform::CreateShape()
 	// create a dummy body
 	b2BodyDef bodyDef;
 	bodyDef.type = b2_staticBody;
-	bodyDef.position = GetOwner().GetProperty("Position").GetValue<Vector2>();
-	bodyDef.angle = GetOwner().GetProperty("Angle").GetValue<float32>();
+	bodyDef.position = GetOwner().GetProperty(PropertyKeys::Position).GetValue<Vector2>();
+	bodyDef.angle = GetOwner().GetProperty(PropertyKeys::Angle).GetValue<float32>();
 	bodyDef.fixedRotation = true;
 	bodyDef.userData = GetOwnerPtr();
 	mBody = GlobalProperties::Get<Physics>("Physics").CreateBody(&bodyDef);
@@ -31,7 +31,7 @@ namespace EntityComponents
 		Vector2 GetPosition(void) const { return mPosition; }
 		
 		/// Position of the entity in world coordinates.
-		void SetPosition(Vector2 pos) { mPosition = pos; }
+		void SetPosition(Vector2 pos);
 		
 		/// Scale of the entity with respect to the X and Y axes in the entity's space.
 		Vector2 GetScale(void) const { return mScale; }
@@ -43,7 +43,19 @@ namespace EntityComponents
 		float32 GetAngle(void) const { return mAngle; }
 		
 		/// Angle of the entity in radians.
-		void SetAngle(float32 value) { mAngle = value; }
+		void SetAngle(float32 value) { mAngle = value; mPreviousAngle = value; }
+
+		/// Moves the entity to the state computed by a simulation step. Unlike the setters, the previous position and
+		/// angle are remembered, so the movement can be interpolated while drawing.
+		void SetSimulatedTransform(const Vector2& position, const float32 angle);
+
+		/// Returns the position in between the state before the last simulation step (factor 0) and the current
+		/// state (factor 1).
+		Vector2 GetInterpolatedPosition(const float32 factor) const { return mPreviousPosition + factor * (mPosition - mPreviousPosition); }
+
+		/// Returns the angle in between the state before the last simulation step (factor 0) and the current
+		/// state (factor 1).
+		float32 GetInterpolatedAngle(const float32 factor) const { return mPreviousAngle + factor * (mAngle - mPreviousAngle); }
 		
 		/// Depth of the entity (ala the Z coordinate).
 		int32 GetLayer(void) const { return mDepth; }
@@ -58,12 +70,17 @@ namespace EntityComponents
 		Vector2 mPosition;
 		Vector2 mScale;
 		float32 mAngle;
+		Vector2 mPreviousPosition;
+		float32 mPreviousAngle;
 		int32 mDepth;
 		PhysicalShape* mShape; // used to support picking of objects without a collider
 		PhysicalBody* mBody;
 
 		void DestroyShape();
 		void CreateShape();
+
+		/// Tells the scene manager that the drawables of this entity have moved.
+		void NotifySceneMgr();
 	};
 }
 
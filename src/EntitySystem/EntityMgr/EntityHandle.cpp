@@ -110,27 +110,27 @@ bool EntitySystem::EntityHandle::GetProperties( PropertyList& out, const Propert
 	return gEntityMgr.GetEntityProperties(*this, out, mask);
 }
 
-PropertyHolder EntitySystem::EntityHandle::GetFunction( const StringKey key, const PropertyAccessFlags mask ) const
+PropertyHolder EntitySystem::EntityHandle::GetFunction( const StringKey& key, const PropertyAccessFlags mask ) const
 {
 	return gEntityMgr.GetEntityProperty(*this, key, mask);
 }
 
-bool EntitySystem::EntityHandle::HasProperty( const StringKey key, const PropertyAccessFlags mask ) const
+bool EntitySystem::EntityHandle::HasProperty( const StringKey& key, const PropertyAccessFlags mask ) const
 {
 	return gEntityMgr.HasEntityProperty(*this, key, mask);
 }
 
-bool EntitySystem::EntityHandle::HasComponentProperty(const ComponentID componentID, const StringKey key, const PropertyAccessFlags mask ) const
+bool EntitySystem::EntityHandle::HasComponentProperty(const ComponentID componentID, const StringKey& key, const PropertyAccessFlags mask ) const
 {
   return gEntityMgr.HasEntityComponentProperty(*this, componentID, key, mask);
 }
 
-PropertyHolder EntitySystem::EntityHandle::GetProperty( const StringKey key, const PropertyAccessFlags mask ) const
+PropertyHolder EntitySystem::EntityHandle::GetProperty( const StringKey& key, const PropertyAccessFlags mask ) const
 {
 	return gEntityMgr.GetEntityProperty(*this, key, mask);
 }
 
-Reflection::PropertyHolder EntitySystem::EntityHandle::GetComponentProperty( const ComponentID componentID, const StringKey key, const PropertyAccessFlags mask ) const
+Reflection::PropertyHolder EntitySystem::EntityHandle::GetComponentProperty( const ComponentID componentID, const StringKey& key, const PropertyAccessFlags mask ) const
 {
 	return gEntityMgr.GetEntityComponentProperty(*this, componentID, key, mask);
 }
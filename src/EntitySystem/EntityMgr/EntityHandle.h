@@ -71,19 +71,19 @@ namespace EntitySystem
 		bool GetProperties(PropertyList& out, const PropertyAccessFlags mask = PA_FULL_ACCESS) const;
 
 		/// Retrieves a function of this entity. A filter related to the function's flags can be specified.
-		PropertyHolder GetFunction(const StringKey key, const PropertyAccessFlags mask = PA_FULL_ACCESS) const;
+		PropertyHolder GetFunction(const StringKey& key, const PropertyAccessFlags mask = PA_FULL_ACCESS) const;
 
 		/// Returns true if the entity has the given property.
-		bool HasProperty(const StringKey key, const PropertyAccessFlags mask = PA_FULL_ACCESS) const;
+		bool HasProperty(const StringKey& key, const PropertyAccessFlags mask = PA_FULL_ACCESS) const;
 		
 		/// Returns true if the component of the entity has the given property.
-		bool HasComponentProperty(const ComponentID componentID, const StringKey key, const PropertyAccessFlags mask = PA_FULL_ACCESS) const;
+		bool HasComponentProperty(const ComponentID componentID, const StringKey& key, const PropertyAccessFlags mask = PA_FULL_ACCESS) const;
 
 		/// Retrieves a property of this entity. A filter related to properties' flags can be specified.
-		PropertyHolder GetProperty(const StringKey key, const PropertyAccessFlags mask = PA_FULL_ACCESS) const;
+		PropertyHolder GetProperty(const StringKey& key, const PropertyAccessFlags mask = PA_FULL_ACCESS) const;
 
 		/// Retrieves a property of a component of this entity. A filter related to properties' flags can be specified.
-		PropertyHolder GetComponentProperty(const ComponentID componentID, const StringKey key, const PropertyAccessFlags mask = PA_FULL_ACCESS) const;
+		PropertyHolder GetComponentProperty(const ComponentID componentID, const StringKey& key, const PropertyAccessFlags mask = PA_FULL_ACCESS) const;
 
 		/// Register a dynamic property to a component of this entity.
 		template <class T>
@@ -97,10 +97,10 @@ namespace EntitySystem
 		EntityMessage::eResult PostMessage(const EntityMessage& msg) const;
 
 		/// Sends a message to this entity.
-		inline EntityMessage::eResult PostMessage(const EntityMessage::eType type) const {  return PostMessage(EntityMessage(type, Reflection::PropertyFunctionParameters())); }
+		inline EntityMessage::eResult PostMessage(const EntityMessage::eType type) const {  return PostMessage(EntityMessage(type)); }
 
 		/// Sends a message to this entity.
-		inline EntityMessage::eResult PostMessage(const EntityMessage::eType type, Reflection::PropertyFunctionParameters data) const {  return PostMessage(EntityMessage(type, data)); }
+		inline EntityMessage::eResult PostMessage(const EntityMessage::eType type, const Reflection::PropertyFunctionParameters& data) const {  return PostMessage(EntityMessage(type, data)); }
 
 		/// Returns the internal ID of this entity.
 		inline EntityID GetID(void) const;
@@ -64,7 +64,7 @@ namespace EntitySystem
 		EntityMessage(eType _type): type(_type) {}
 
 		/// Constructs a new message with given parameters.
-		EntityMessage(eType _type, Reflection::PropertyFunctionParameters _data): type(_type), parameters(_data) {}
+		EntityMessage(eType _type, const Reflection::PropertyFunctionParameters& _data): type(_type), parameters(_data) {}
 
 		/// Returns true if the parameters of the message match the definition of its type (see EntityMessageTypes.h).
 		bool AreParametersValid(void) const;
@@ -6,9 +6,14 @@
 #include "../ComponentMgr/Component.h"
 #include "Core/Game.h"
 #include "ResourceSystem/XMLResource.h"
+#include "ResourceSystem/XMLReader.h"
+#include "ResourceSystem/BinaryResource.h"
+#include "ResourceSystem/BinaryOutput.h"
 #include "GfxSystem/GfxSceneMgr.h"
 #include "Editor/EditorMgr.h"
 #include "Editor/EditorGUI.h"
+#include "PropertyKeys.h"
+#include "Utils/JobPool.h"
 
 namespace EntitySystem
 {
@@ -55,27 +60,65 @@ namespace EntitySystem
 		PrototypeInfo(const PrototypeInfo& rhs);
 		PrototypeInfo& operator=(const PrototypeInfo& rhs);
 	};
+
+	/// Predicate telling whether a component is contained in a sorted list of components.
+	class IsInSortedComponentsList
+	{
+	public:
+		IsInSortedComponentsList(const ComponentsList& list): mList(list) {}
+		bool operator()(Component* cmp) const { return std::binary_search(mList.begin(), mList.end(), cmp); }
+	private:
+		const ComponentsList& mList;
+	};
+
+	/// Predicate telling whether a subscriber was removed during a broadcast.
+	inline bool IsRemovedSubscriber(Component* cmp) { return cmp == 0; }
 }
 
 
 /// File used for storing prototypes.
 const char* PROTOTYPES_DEFAULT_FILE = "Prototypes.xml";
 
+/// Identifies binary data containing entities.
+const uint32 BINARY_ENTITIES_MAGIC = 0x4253434F;
+
+/// Version of the binary format of entities. It must be increased whenever the format or the property type IDs change.
+const uint32 BINARY_ENTITIES_VERSION = 2;
+
+/// Minimal number of components handling a broadcast message in one job. Smaller broadcasts are handled serially.
+const uint32 PARALLEL_BROADCAST_CHUNK_SIZE = 64;
+
+/// Names of the elements and attributes of the XML files with entities.
+const StringKey XML_LAYERS_ELEMENT("Layers");
+const StringKey XML_ENTITIES_ELEMENT("Entities");
+const StringKey XML_ENTITY_ELEMENT("Entity");
+const StringKey XML_COMPONENT_ELEMENT("Component");
+const StringKey XML_HIERARCHY_ELEMENT("Hierarchy");
+const StringKey XML_NAME_ATTRIBUTE("Name");
+const StringKey XML_ID_ATTRIBUTE("ID");
+const StringKey XML_PROTOTYPE_ATTRIBUTE("Prototype");
+const StringKey XML_TRANSIENT_ATTRIBUTE("Transient");
+const StringKey XML_TAG_ATTRIBUTE("Tag");
+const StringKey XML_TYPE_ATTRIBUTE("Type");
+const StringKey XML_ACCESS_ATTRIBUTE("Access");
+const StringKey XML_COMMENT_ATTRIBUTE("Comment");
+
 
 using namespace EntitySystem;
 
-EntityMgr::EntityMgr()
+EntityMgr::EntityMgr(): mBroadcastDepth(0), mHasRemovedSubscribers(false)
 {
 	ocInfo << "*** EntityMgr init ***";
 
 	mComponentMgr = new ComponentMgr();
-
+	mJobPool = new JobPool(JobPool::GetDefaultWorkerCount());
 }
 
 EntityMgr::~EntityMgr()
 {
 	DestroyAllEntities(true, true);
 	delete mComponentMgr;
+	delete mJobPool;
 }
 
 EntityMessage::eResult EntityMgr::PostMessage(EntityID targetEntity, const EntityMessage& msg)
@@ -111,11 +154,16 @@ EntityMessage::eResult EntityMgr::PostMessage(EntityID targetEntity, const Entit
 	}
 
 
-	if (msg.type == EntityMessage::POST_INIT) ei->second->mFullyInited = true;
+	if (msg.type == EntityMessage::POST_INIT)
+	{
+		ei->second->mFullyInited = true;
+		SubscribeEntityComponents(targetEntity);
+	}
 
 	EntityMessage::eResult result = EntityMessage::RESULT_IGNORED;
 	for (EntityComponentsIterator iter = mComponentMgr->GetEntityComponents(targetEntity); iter.HasMore(); ++iter)
 	{
+		if (!(*iter)->GetRTTI()->HandlesMessage(msg.type)) continue;
 		EntityMessage::eResult r = (*iter)->HandleMessage(msg);
 		if ((r == EntityMessage::RESULT_ERROR)
 			|| (r == EntityMessage::RESULT_OK && result == EntityMessage::RESULT_IGNORED))
@@ -128,12 +176,122 @@ EntityMessage::eResult EntityMgr::PostMessage(EntityID targetEntity, const Entit
 
 void EntityMgr::BroadcastMessage(const EntityMessage& msg)
 {
-	for (EntityMap::iterator i = mEntities.begin(); i!=mEntities.end(); ++i)
+	if (msg.type == EntityMessage::INIT || msg.type == EntityMessage::POST_INIT)
+	{
+		// these change the state of the entities, so they must go through all the checks
+		for (EntityMap::iterator i = mEntities.begin(); i!=mEntities.end(); ++i)
+		{
+			PostMessage(i->first, msg);
+		}
+		return;
+	}
+
+	if (!msg.AreParametersValid())
+	{
+		ocError << "Can't broadcast message: Parameters passed are not valid";
+		return;
+	}
+
+	// handlers may destroy components; the subscribers are then only nulled until the outermost broadcast ends
+	++mBroadcastDepth;
+
+	// handlers can add or remove components, so the list may change while we are walking it;
+	// components subscribed during the broadcast will get the message the next time
+	MessageSubscribers& subscribers = mMessageSubscribers[msg.type];
+	const size_t subscribersCount = subscribers.size();
+	for (size_t i=0; i<subscribersCount; )
+	{
+		// the subscribers are handled in the order of the list; only a long enough run of parallel handlers goes to
+		// the pool, as they touch only their own entities and so their order among themselves doesn't matter
+		size_t runEnd = i;
+		while (runEnd < subscribersCount && subscribers[runEnd] && subscribers[runEnd]->GetRTTI()->HandlesMessageInParallel(msg.type)) ++runEnd;
+		if (runEnd - i >= PARALLEL_BROADCAST_CHUNK_SIZE)
+		{
+			// the list can't change while the parallel handlers are running
+			pair<const EntityMessage*, Component**> context(&msg, &subscribers[i]);
+			mJobPool->ParallelFor(HandleMessageInParallel, &context, runEnd - i, PARALLEL_BROADCAST_CHUNK_SIZE);
+			i = runEnd;
+			continue;
+		}
+
+		if (subscribers[i]) subscribers[i]->HandleMessage(msg);
+		++i;
+	}
+
+	--mBroadcastDepth;
+	if (mBroadcastDepth == 0 && mHasRemovedSubscribers) CompactSubscribers();
+}
+
+void EntityMgr::HandleMessageInParallel(void* context, const uint32 begin, const uint32 end)
+{
+	pair<const EntityMessage*, Component**>* broadcast = (pair<const EntityMessage*, Component**>*)context;
+	const EntityMessage& msg = *broadcast->first;
+	Component** subscribers = broadcast->second;
+	for (uint32 i=begin; i<end; ++i)
 	{
-		PostMessage(i->first, msg);
+		subscribers[i]->HandleMessage(msg);
 	}
 }
 
+void EntityMgr::SubscribeComponent(const EntityID entity, Component* cmp)
+{
+	const RTTI* rtti = cmp->GetRTTI();
+	const bool isPrototype = EntityHandle::IsPrototypeID(entity);
+	for (int32 i=0; i<EntityMessage::NUM_TYPES; ++i)
+	{
+		EntityMessage::eType type = (EntityMessage::eType)i;
+
+		// init messages are never broadcasted through the subscriber lists
+		if (type == EntityMessage::INIT || type == EntityMessage::POST_INIT) continue;
+
+		// prototypes can receive only the messages related to their lifetime (see PostMessage)
+		if (isPrototype && type != EntityMessage::DESTROY && type != EntityMessage::RESOURCE_UPDATE) continue;
+
+		if (rtti->HandlesMessage(type) || rtti->HandlesMessageInParallel(type)) mMessageSubscribers[type].push_back(cmp);
+	}
+}
+
+void EntityMgr::SubscribeEntityComponents(const EntityID entity)
+{
+	for (EntityComponentsIterator it = mComponentMgr->GetEntityComponents(entity); it.HasMore(); ++it)
+	{
+		SubscribeComponent(entity, *it);
+	}
+}
+
+void EntityMgr::UnsubscribeComponents(ComponentsList& components)
+{
+	if (components.empty()) return;
+
+	Containers::sort(components.begin(), components.end());
+	if (mBroadcastDepth > 0)
+	{
+		// a broadcast is walking the lists, so they can't be shortened now
+		for (int32 i=0; i<EntityMessage::NUM_TYPES; ++i)
+		{
+			std::replace_if(mMessageSubscribers[i].begin(), mMessageSubscribers[i].end(), IsInSortedComponentsList(components), (Component*)0);
+		}
+		mHasRemovedSubscribers = true;
+		return;
+	}
+
+	for (int32 i=0; i<EntityMessage::NUM_TYPES; ++i)
+	{
+		MessageSubscribers& subscribers = mMessageSubscribers[i];
+		subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), IsInSortedComponentsList(components)), subscribers.end());
+	}
+}
+
+void EntityMgr::CompactSubscribers()
+{
+	for (int32 i=0; i<EntityMessage::NUM_TYPES; ++i)
+	{
+		MessageSubscribers& subscribers = mMessageSubscribers[i];
+		subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), IsRemovedSubscriber), subscribers.end());
+	}
+	mHasRemovedSubscribers = false;
+}
+
 EntityHandle EntityMgr::CreateEntity(EntityDescription& desc, Editor::HierarchyWindow::eAddItemMode addMode, bool autoLinkToPrototype)
 {
 	OC_ASSERT(mComponentMgr);
@@ -147,7 +305,7 @@ EntityHandle EntityMgr::CreateEntity(EntityDescription& desc, Editor::HierarchyW
 	}
 	if (desc.mPrototype != INVALID_ENTITY_ID && mEntities.find(desc.mPrototype) == mEntities.end())
 	{
-		ocInfo << "Prototype of the entity " << desc.mName << " can't be found. Continuing without it.";
+		ocChannelInfo(LC_ENTITIES) << "Prototype of the entity " << desc.mName << " can't be found. Continuing without it.";
 		desc.mPrototype = INVALID_ENTITY_ID;
 	}
 
@@ -185,7 +343,7 @@ EntityHandle EntityMgr::CreateEntity(EntityDescription& desc, Editor::HierarchyW
 			{
 				dependencyFailure = true;
 				ocError << "Component dependency failure on entity " << entityHandle;
-				ocInfo << "Component " << GetComponentTypeName(cmpType) << " depends on " << GetComponentTypeName(*depIt) << " which was not created yet";
+				ocChannelInfo(LC_ENTITIES) << "Component " << GetComponentTypeName(cmpType) << " depends on " << GetComponentTypeName(*depIt) << " which was not created yet";
 			}
 		}
 
@@ -210,7 +368,7 @@ EntityHandle EntityMgr::CreateEntity(EntityDescription& desc, Editor::HierarchyW
 		return entityHandle; // do like nothing's happened, but don't enum properties or they will access invalid memory
 	}
 
-	ocTrace << "Entity created: " << entityHandle;
+	ocChannelTrace(LC_ENTITIES) << "Entity created: " << entityHandle;
 
 	if (GlobalProperties::Get<bool>("DevelopMode"))
 	{
@@ -239,7 +397,7 @@ EntityHandle EntityMgr::InstantiatePrototype(const EntityHandle prototype, const
 
 	if (position.LengthSquared() != 0 && instance.HasProperty("Position"))
 	{
-		instance.GetProperty("Position").SetValue(position);
+		instance.GetProperty(PropertyKeys::Position).SetValue(position);
 	}
 
 	return instance;
@@ -315,7 +473,7 @@ EntityHandle EntityMgr::DuplicateEntity(const EntityHandle oldEntity, const stri
 		LinkEntityToPrototype(newEntity.GetID(), mEntities[newEntity.GetID()]->mPrototype);
 	}
 
-	ocTrace << "Entity duplicated: " << newEntity;
+	ocChannelTrace(LC_ENTITIES) << "Entity duplicated: " << newEntity;
 
 	if (GlobalProperties::Get<bool>("DevelopMode"))
 	{
@@ -337,6 +495,22 @@ void EntityMgr::DestroyEntity(const EntityHandle entityToDestroy)
 
 void EntitySystem::EntityMgr::ProcessDestroyQueue( void )
 {
+	// unsubscribe components of all the entities at once
+	ComponentsList destroyedComponents;
+	for (EntityQueue::const_iterator it=mEntityDestroyQueue.begin(); it!=mEntityDestroyQueue.end(); ++it)
+	{
+		if (mEntities.find(*it) == mEntities.end()) continue;
+		for (EntityComponentsIterator cmpIt=mComponentMgr->GetEntityComponents(*it); cmpIt.HasMore(); ++cmpIt)
+		{
+			destroyedComponents.push_back(*cmpIt);
+		}
+	}
+	UnsubscribeComponents(destroyedComponents);
+
+	// drawables of the destroyed entities are removed from the scene at once
+	GfxSystem::GfxSceneMgr* sceneMgr = GfxSystem::GfxRenderer::SingletonExists() ? gGfxRenderer.GetSceneManager() : 0;
+	if (sceneMgr) sceneMgr->BeginBatchRemoval();
+
 	for (EntityQueue::const_iterator it=mEntityDestroyQueue.begin(); it!=mEntityDestroyQueue.end(); ++it)
 	{
 		EntityMap::iterator mapIt = mEntities.find(*it);
@@ -348,11 +522,30 @@ void EntitySystem::EntityMgr::ProcessDestroyQueue( void )
 		}
 	}
 	mEntityDestroyQueue.clear();
+
+	if (sceneMgr) sceneMgr->EndBatchRemoval();
 }
 
 void EntityMgr::DestroyAllEntities(bool includingPrototypes, bool deleteTransients)
 {
 	OC_ASSERT(mComponentMgr);
+
+	// unsubscribe components of all the entities at once
+	ComponentsList destroyedComponents;
+	for (EntityMap::const_iterator entIt = mEntities.begin(); entIt != mEntities.end(); ++entIt)
+	{
+		if (!includingPrototypes && EntityHandle::IsPrototypeID(entIt->first)) continue;
+		if (!deleteTransients && entIt->second->mTransient) continue;
+		for (EntityComponentsIterator cmpIt=mComponentMgr->GetEntityComponents(entIt->first); cmpIt.HasMore(); ++cmpIt)
+		{
+			destroyedComponents.push_back(*cmpIt);
+		}
+	}
+	UnsubscribeComponents(destroyedComponents);
+
+	GfxSystem::GfxSceneMgr* sceneMgr = GfxSystem::GfxRenderer::SingletonExists() ? gGfxRenderer.GetSceneManager() : 0;
+	if (sceneMgr) sceneMgr->BeginBatchRemoval();
+
 	EntityMap::const_iterator it = mEntities.begin();
 	while (it != mEntities.end())
 	{
@@ -371,6 +564,8 @@ void EntityMgr::DestroyAllEntities(bool includingPrototypes, bool deleteTransien
 		DestroyEntityImmediately(it->first, false);
 		it = mEntities.erase(it);
 	}
+
+	if (sceneMgr) sceneMgr->EndBatchRemoval();
 	mEntityDestroyQueue.clear(); // new entities could be marked for removal during deleting another entities
 	if (includingPrototypes)
 	{
@@ -409,7 +604,7 @@ void EntityMgr::DestroyEntityImmediately( const EntityID entityToDestroy, const
 
 	if (erase) mEntities.erase(entityIt);
 
-	ocTrace << "Entity destroyed " << entityToDestroy;
+	ocChannelTrace(LC_ENTITIES) << "Entity destroyed " << entityToDestroy;
 }
 
 string EntitySystem::EntityMgr::GetEntityName(const EntitySystem::EntityHandle& h) const
@@ -507,7 +702,7 @@ bool EntitySystem::EntityMgr::GetEntityProperties( const EntityHandle entity, Pr
 	return true;
 }
 
-PropertyHolder EntitySystem::EntityMgr::GetEntityProperty( const EntityHandle entity, const StringKey key, const PropertyAccessFlags flagMask /*= 0xff*/ ) const
+PropertyHolder EntitySystem::EntityMgr::GetEntityProperty( const EntityHandle entity, const StringKey& key, const PropertyAccessFlags flagMask /*= 0xff*/ ) const
 {
 	OC_DASSERT(mComponentMgr);
 	if (!entity.Exists())
@@ -543,7 +738,7 @@ PropertyHolder EntitySystem::EntityMgr::GetEntityProperty( const EntityHandle en
 	return PropertyHolder();
 }
 
-Reflection::PropertyHolder EntitySystem::EntityMgr::GetEntityComponentProperty( const EntityHandle entity, const ComponentID component, const StringKey propertyKey, const PropertyAccessFlags flagMask /*= PA_FULL_ACCESS*/ ) const
+Reflection::PropertyHolder EntitySystem::EntityMgr::GetEntityComponentProperty( const EntityHandle entity, const ComponentID component, const StringKey& propertyKey, const PropertyAccessFlags flagMask /*= PA_FULL_ACCESS*/ ) const
 {
 	if (!entity.Exists())
 	{
@@ -583,7 +778,7 @@ Reflection::PropertyHolder EntitySystem::EntityMgr::GetEntityComponentProperty(
 	return PropertyHolder();
 }
 
-bool EntitySystem::EntityMgr::HasEntityProperty( const EntityHandle entity, const StringKey key, const PropertyAccessFlags flagMask /*= PA_FULL_ACCESS*/ ) const
+bool EntitySystem::EntityMgr::HasEntityProperty( const EntityHandle entity, const StringKey& key, const PropertyAccessFlags flagMask /*= PA_FULL_ACCESS*/ ) const
 {
 	OC_DASSERT(mComponentMgr);
 	if (!entity.Exists())
@@ -661,16 +856,16 @@ EntitySystem::EntityHandle EntitySystem::EntityMgr::FindFirstPrototype( const st
 }
 
 void EntitySystem::EntityMgr::LoadEntityPropertyFromXML(const EntityID entityID, const ComponentID componentID, 
-	PrototypeInfo* prototypeInfo, ResourceSystem::XMLNodeIterator& xmlPropertyIterator)
+	PrototypeInfo* prototypeInfo, ResourceSystem::XMLReader& xml)
 {
-	StringKey propertyKey(*xmlPropertyIterator);
+	StringKey propertyKey = xml.GetName();
 	
 	// test whether it is a dynamic property
 	if (!HasEntityComponentProperty(entityID, componentID, propertyKey, PA_INIT))
 	{
-		if (xmlPropertyIterator.HasAttribute("Type"))
+		if (xml.HasAttribute(XML_TYPE_ATTRIBUTE))
 		{
-			string propertyTypeName = xmlPropertyIterator.GetAttribute<string>("Type");
+			string propertyTypeName = xml.GetAttribute<string>(XML_TYPE_ATTRIBUTE);
 			Reflection::ePropertyType propertyType = Reflection::PropertyTypes::GetTypeFromName(propertyTypeName);
 			if (propertyType == PT_UNKNOWN)
 			{
@@ -678,27 +873,27 @@ void EntitySystem::EntityMgr::LoadEntityPropertyFromXML(const EntityID entityID,
 				return;
 			}
 			Reflection::PropertyAccessFlags accessFlags = Reflection::PA_FULL_ACCESS;
-			if (xmlPropertyIterator.HasAttribute("Access"))
+			if (xml.HasAttribute(XML_ACCESS_ATTRIBUTE))
 			{
-				accessFlags = (uint8)xmlPropertyIterator.GetAttribute<uint16>("Access");
+				accessFlags = (uint8)xml.GetAttribute<uint16>(XML_ACCESS_ATTRIBUTE);
 			}
 
 			string comment = "";
-			if (xmlPropertyIterator.HasAttribute("Comment"))
+			if (xml.HasAttribute(XML_COMMENT_ATTRIBUTE))
 			{
-				comment = xmlPropertyIterator.GetAttribute<string>("Comment");
+				comment = xml.GetAttribute<string>(XML_COMMENT_ATTRIBUTE);
 			}
 
 			if (!RegisterDynamicPropertyOfEntityComponent(propertyType, entityID, componentID,
 				propertyKey, accessFlags, comment))
 			{
-				ocError << "XML: Entity: Cannot registry dynamic entity property '" << *xmlPropertyIterator << "'.";
+				ocError << "XML: Entity: Cannot registry dynamic entity property '" << propertyKey.ToString() << "'.";
 				return;
 			}
 		}
 		else
 		{
-			ocError << "XML: Entity: Unknown entity property '" << *xmlPropertyIterator << "' (it might not be marked as initable (PA_INIT))";
+			ocError << "XML: Entity: Unknown entity property '" << propertyKey.ToString() << "' (it might not be marked as initable (PA_INIT))";
 			return;
 		}
 	}
@@ -708,26 +903,32 @@ void EntitySystem::EntityMgr::LoadEntityPropertyFromXML(const EntityID entityID,
 
 	PropertyHolder prop = GetEntityComponentProperty(entityID, componentID, propertyKey);
 
-	prop.ReadValueXML(xmlPropertyIterator);
+	prop.ReadValueXML(xml);
 }
 
-void EntitySystem::EntityMgr::LoadEntityFromXML(ResourceSystem::XMLNodeIterator &entIt, const bool isPrototype)
+void EntitySystem::EntityMgr::LoadEntityFromXML(ResourceSystem::XMLReader& xml, const bool isPrototype)
 {
 	// init the entity description
 	EntityDescription desc;
 	desc.Reset();
-	if (entIt.HasAttribute("Name"))	desc.SetName(entIt.GetAttribute<string>("Name"));
-	if (entIt.HasAttribute("ID")) desc.SetDesiredID(entIt.GetAttribute<EntityID>("ID"));
+	if (xml.HasAttribute(XML_NAME_ATTRIBUTE)) desc.SetName(xml.GetAttribute<string>(XML_NAME_ATTRIBUTE));
+	if (xml.HasAttribute(XML_ID_ATTRIBUTE)) desc.SetDesiredID(xml.GetAttribute<EntityID>(XML_ID_ATTRIBUTE));
 	// note that the prototypes are taken into account only in the develop mode
-	if (GlobalProperties::Get<bool>("DevelopMode") && entIt.HasAttribute("Prototype")) desc.SetPrototype(entIt.GetAttribute<EntityID>("Prototype"));
-	if (entIt.HasAttribute("Transient")) desc.SetTransient(entIt.GetAttribute<bool>("Transient"));
+	if (GlobalProperties::Get<bool>("DevelopMode") && xml.HasAttribute(XML_PROTOTYPE_ATTRIBUTE)) desc.SetPrototype(xml.GetAttribute<EntityID>(XML_PROTOTYPE_ATTRIBUTE));
+	if (xml.HasAttribute(XML_TRANSIENT_ATTRIBUTE)) desc.SetTransient(xml.GetAttribute<bool>(XML_TRANSIENT_ATTRIBUTE));
 	if (isPrototype) desc.SetKind(EntityDescription::EK_PROTOTYPE);
 
 	// add component types
-	for (ResourceSystem::XMLNodeIterator cmpIt = entIt.IterateChildren(); cmpIt != entIt.EndChildren(); ++cmpIt)
+	// note that the entity can be created only when all its component types are known, so the nodes of the entity
+	//      are kept by the bookmark and read once more to set the properties
+	const uint32 depth = xml.GetDepth();
+	xml.SetBookmark();
+	while (xml.ReadChildElement(depth))
 	{
-		if ((*cmpIt).compare("Component") == 0)	desc.AddComponent(DetectComponentType(cmpIt.GetAttribute<string>("Type")));
+		if (xml.GetName() == XML_COMPONENT_ELEMENT) desc.AddComponent(DetectComponentType(xml.GetAttribute<string>(XML_TYPE_ATTRIBUTE)));
 	}
+	xml.ReturnToBookmark();
+	xml.ReleaseBookmark();
 
 	// create the entity
 	bool autoLink = false;
@@ -735,7 +936,7 @@ void EntitySystem::EntityMgr::LoadEntityFromXML(ResourceSystem::XMLNodeIterator
 	if (!entity) return;
 
 	// setup the tag
-	if (entIt.HasAttribute("Tag")) SetEntityTag(entity, entIt.GetAttribute<EntityTag>("Tag"));
+	if (xml.HasAttribute(XML_TAG_ATTRIBUTE)) SetEntityTag(entity, xml.GetAttribute<EntityTag>(XML_TAG_ATTRIBUTE));
 
 	// get the prototype stuff if available
 	PrototypeInfo* prototypeInfo = 0;
@@ -747,26 +948,18 @@ void EntitySystem::EntityMgr::LoadEntityFromXML(ResourceSystem::XMLNodeIterator
 
 	// set properties loaded from the file
 	ComponentID currentComponent = -1;
-	for (ResourceSystem::XMLNodeIterator cmpIt = entIt.IterateChildren(); cmpIt != entIt.EndChildren(); ++cmpIt)
+	while (xml.ReadChildElement(depth))
 	{
 		// skip unwanted data
-		if ((*cmpIt).compare("Component") != 0)
+		if (xml.GetName() != XML_COMPONENT_ELEMENT)
 			continue;
 
 		++currentComponent;
 
-		bool first = true;
-
-		for (ResourceSystem::XMLNodeIterator xmlPropertyIter = cmpIt.IterateChildren(); 
-			xmlPropertyIter != cmpIt.EndChildren(); ++xmlPropertyIter)
+		const uint32 componentDepth = xml.GetDepth();
+		while (xml.ReadChildElement(componentDepth))
 		{
-			// skip unwanted data
-			if (first && (*xmlPropertyIter).compare("Type") == 0)
-			{
-				first = false;
-				continue;
-			}
-			LoadEntityPropertyFromXML(entity.GetID(), currentComponent, prototypeInfo, xmlPropertyIter);
+			LoadEntityPropertyFromXML(entity.GetID(), currentComponent, prototypeInfo, xml);
 		}
 	}
 
@@ -783,7 +976,7 @@ void EntitySystem::EntityMgr::LoadEntityFromXML(ResourceSystem::XMLNodeIterator
 	}
 
 
-	ocTrace << "Entity loaded from XML: " << entity;
+	ocChannelTrace(LC_ENTITIES) << "Entity loaded from XML: " << entity;
 }
 
 bool EntitySystem::EntityMgr::LoadEntitiesFromResource(ResourceSystem::ResourcePtr res, const bool loadPrototypes)
@@ -793,25 +986,38 @@ bool EntitySystem::EntityMgr::LoadEntitiesFromResource(ResourceSystem::ResourceP
 		ocError << "XML: Can't load data; null resource pointer";
 		return false;
 	}
-	ResourceSystem::XMLResourcePtr xml = res;
-	OC_ASSERT_MSG((bool)xml, "Wrong entity resource");
+	if (res->GetType() == ResourceSystem::RESTYPE_BINARYRESOURCE)
+	{
+		ResourceSystem::BinaryResourcePtr binary = res;
+		ResourceSystem::BinaryInput input = binary->GetInput();
+		return LoadEntitiesFromBinary(input, loadPrototypes);
+	}
+
+	ResourceSystem::XMLResourcePtr xmlResource = res;
+	OC_ASSERT_MSG((bool)xmlResource, "Wrong entity resource");
 
 	bool result = true;
 
-	ResourceSystem::XMLNodeIterator toplevelIter = xml->IterateTopLevel();
+	// the top level elements are the children of the document element
+	ResourceSystem::XMLReader xml(xmlResource);
+	if (!xml.Read())
+	{
+		ocError << "XML: Expected the document element";
+		return false;
+	}
+	const uint32 topLevelDepth = xml.GetDepth();
 	
 	if (!loadPrototypes)
 	{
-		if (toplevelIter == xml->EndTopLevel() || (*toplevelIter).compare("Layers") != 0)
+		if (!xml.ReadChildElement(topLevelDepth) || xml.GetName() != XML_LAYERS_ELEMENT)
 		{
 			ocError << "XML: Expected 'Layers'";
 			return false;
 		}
-		gLayerMgr.LoadLayers(toplevelIter);
-		++toplevelIter;
+		gLayerMgr.LoadLayers(xml);
 	}
 
-	if (toplevelIter == xml->EndTopLevel() || (*toplevelIter).compare("Entities") != 0)
+	if (!xml.ReadChildElement(topLevelDepth) || xml.GetName() != XML_ENTITIES_ELEMENT)
 	{
 		ocError << "XML: Expected 'Entities'";
 		return false;
@@ -822,15 +1028,16 @@ bool EntitySystem::EntityMgr::LoadEntitiesFromResource(ResourceSystem::ResourceP
 		gEditorMgr.GetHierarchyWindow()->DisableAddEntities();
 	}
 
-	for (ResourceSystem::XMLNodeIterator entIt = toplevelIter.IterateChildren(); entIt != toplevelIter.EndChildren(); ++entIt)
+	const uint32 entitiesDepth = xml.GetDepth();
+	while (xml.ReadChildElement(entitiesDepth))
 	{
-		if ((*entIt).compare("Entity") == 0)
+		if (xml.GetName() == XML_ENTITY_ELEMENT)
 		{
-			LoadEntityFromXML(entIt, loadPrototypes);
+			LoadEntityFromXML(xml, loadPrototypes);
 		}
 		else
 		{
-			ocError << "XML: Expected 'Entity', found '" << *entIt << "'";
+			ocError << "XML: Expected 'Entity', found '" << xml.GetName().ToString() << "'";
 			result = false;
 		}
 	}
@@ -844,15 +1051,16 @@ bool EntitySystem::EntityMgr::LoadEntitiesFromResource(ResourceSystem::ResourceP
 
 	if (!loadPrototypes && GlobalProperties::Get<bool>("DevelopMode"))
 	{
-		++toplevelIter;
-		if (toplevelIter == xml->EndTopLevel() || (*toplevelIter).compare("Hierarchy") != 0)
+		if (!xml.ReadChildElement(topLevelDepth) || xml.GetName() != XML_HIERARCHY_ELEMENT)
 		{
 			ocError << "XML: Expected 'Hierarchy' after 'Entities'";
 			return false;
 		}
-		gEditorMgr.GetHierarchyWindow()->LoadHierarchy(toplevelIter);
+		gEditorMgr.GetHierarchyWindow()->LoadHierarchy(xml);
 	}
 
+	if (xml.HasFailed()) result = false;
+
 	return result;
 }
 
@@ -961,6 +1169,314 @@ bool EntitySystem::EntityMgr::SaveEntitiesToStorage(ResourceSystem::XMLOutput& s
 	return result;
 }
 
+uint32 EntitySystem::EntityMgr::BinaryNameTable::GetIndex( const string& name )
+{
+	hash_map<string, uint32>::const_iterator it = indices.find(name);
+	if (it != indices.end()) return it->second;
+	const uint32 index = names.size();
+	indices[name] = index;
+	names.push_back(name);
+	return index;
+}
+
+bool EntitySystem::EntityMgr::LoadEntityFromBinary(ResourceSystem::BinaryInput& input, const vector<eComponentType>& componentTypes, 
+	const vector<StringKey>& propertyKeys, const bool isPrototype)
+{
+	// init the entity description
+	EntityDescription desc;
+	desc.Reset();
+	desc.SetName(input.ReadString());
+	desc.SetDesiredID(input.Read<EntityID>());
+	EntityTag tag = input.Read<EntityTag>();
+	desc.SetTransient(input.Read<bool>());
+	EntityID prototypeID = input.Read<EntityID>();
+	// note that the prototypes are taken into account only in the develop mode
+	if (GlobalProperties::Get<bool>("DevelopMode") && prototypeID != INVALID_ENTITY_ID) desc.SetPrototype(prototypeID);
+	if (isPrototype) desc.SetKind(EntityDescription::EK_PROTOTYPE);
+
+	// add component types
+	const uint32 componentsCount = input.Read<uint32>();
+	for (uint32 i=0; i<componentsCount && !input.HasFailed(); ++i)
+	{
+		const uint32 typeIndex = input.Read<uint32>();
+		if (typeIndex >= componentTypes.size()) return false;
+		desc.AddComponent(componentTypes[typeIndex]);
+	}
+	if (input.HasFailed()) return false;
+
+	// create the entity; if it fails, its properties are read anyway to get to the next entity
+	bool autoLink = false;
+	EntityHandle entity = CreateEntity(desc, Editor::HierarchyWindow::ADD_APPEND, autoLink);
+	if (entity.IsValid()) SetEntityTag(entity, tag);
+
+	// get the prototype stuff if available
+	PrototypeInfo* prototypeInfo = 0;
+	if (entity.IsValid() && isPrototype)
+	{
+		OC_ASSERT(mPrototypes.find(entity.GetID()) != mPrototypes.end());
+		prototypeInfo = mPrototypes[entity.GetID()];
+	}
+
+	// set properties loaded from the data
+	for (ComponentID componentID = 0; componentID < (ComponentID)componentsCount; ++componentID)
+	{
+		const uint32 propertiesCount = input.Read<uint32>();
+		for (uint32 i=0; i<propertiesCount; ++i)
+		{
+			const uint32 keyIndex = input.Read<uint32>();
+			const Reflection::ePropertyType propertyType = (Reflection::ePropertyType)input.Read<uint8>();
+			const Reflection::PropertyAccessFlags accessFlags = input.Read<Reflection::PropertyAccessFlags>();
+			const bool isValued = input.Read<bool>();
+			const string comment = isValued ? input.ReadString() : string();
+			ResourceSystem::BinaryInput valueInput = input.ReadBlock(input.Read<uint32>());
+			if (input.HasFailed() || keyIndex >= propertyKeys.size()) return false;
+			if (!entity.IsValid()) continue;
+
+			const StringKey propertyKey = propertyKeys[keyIndex];
+			if (!HasEntityComponentProperty(entity.GetID(), componentID, propertyKey, PA_INIT))
+			{
+				if (!isValued)
+				{
+					ocError << "Binary: Entity: Unknown entity property '" << propertyKey << "' (it might not be marked as initable (PA_INIT))";
+					continue;
+				}
+				if (!RegisterDynamicPropertyOfEntityComponent(propertyType, entity.GetID(), componentID, propertyKey, accessFlags, comment))
+				{
+					ocError << "Binary: Entity: Cannot register dynamic entity property '" << propertyKey << "'.";
+					continue;
+				}
+			}
+
+			// the property was stored in the data for the prototype, so it's a shared property
+			if (prototypeInfo) prototypeInfo->mSharedProperties.insert(propertyKey);
+
+			PropertyHolder prop = GetEntityComponentProperty(entity.GetID(), componentID, propertyKey);
+			if (prop.GetType() != propertyType)
+			{
+				ocError << "Binary: Entity: Property '" << propertyKey << "' was stored as '" << Reflection::PropertyTypes::GetStringName(propertyType)
+					<< "', but it is '" << Reflection::PropertyTypes::GetStringName(prop.GetType()) << "' now.";
+				continue;
+			}
+			prop.ReadValueBinary(valueInput);
+			if (valueInput.HasFailed()) ocError << "Binary: Entity: Corrupted value of property '" << propertyKey << "'.";
+		}
+	}
+	if (!entity.IsValid()) return !input.HasFailed();
+
+	// finish init
+	// note: the prototype copy can't be created here since all prototypes must be loaded first before any copy is created.
+	entity.FinishInit();
+
+	// link the entity to its prototype if it has any
+	// note that we disabled auto linking when creating the entity
+	if (!autoLink && mPrototypes.find(desc.mPrototype) != mPrototypes.end())
+	{
+		LinkEntityToPrototype(entity.GetID(), desc.mPrototype);
+	}
+
+	ocChannelTrace(LC_ENTITIES) << "Entity loaded from binary: " << entity;
+	return !input.HasFailed();
+}
+
+bool EntitySystem::EntityMgr::LoadEntitiesFromBinary(ResourceSystem::BinaryInput& input, const bool loadPrototypes)
+{
+	if (input.Read<uint32>() != BINARY_ENTITIES_MAGIC)
+	{
+		ocError << "Binary: The data doesn't contain entities";
+		return false;
+	}
+	const uint32 version = input.Read<uint32>();
+	if (version != BINARY_ENTITIES_VERSION)
+	{
+		ocError << "Binary: Unsupported version " << version << " of entities; expected " << BINARY_ENTITIES_VERSION;
+		return false;
+	}
+
+	const bool hasLayers = input.Read<bool>();
+	if (hasLayers == loadPrototypes)
+	{
+		ocError << (loadPrototypes ? "Binary: Expected prototypes" : "Binary: Expected 'Layers'");
+		return false;
+	}
+	if (hasLayers)
+	{
+		gLayerMgr.LoadLayers(input);
+	}
+
+	// the names are resolved only once per file instead of once per entity
+	vector<eComponentType> componentTypes(input.Read<uint32>());
+	for (uint32 i=0; i<componentTypes.size() && !input.HasFailed(); ++i)
+	{
+		componentTypes[i] = DetectComponentType(input.ReadString());
+	}
+	vector<StringKey> propertyKeys(input.Read<uint32>());
+	for (uint32 i=0; i<propertyKeys.size() && !input.HasFailed(); ++i)
+	{
+		propertyKeys[i] = StringKey(input.ReadString());
+	}
+	if (input.HasFailed())
+	{
+		ocError << "Binary: Unexpected end of data";
+		return false;
+	}
+
+	if (GlobalProperties::Get<bool>("DevelopMode"))
+	{
+		gEditorMgr.GetHierarchyWindow()->DisableAddEntities();
+	}
+
+	bool result = true;
+	const uint32 entitiesCount = input.Read<uint32>();
+	for (uint32 i=0; i<entitiesCount; ++i)
+	{
+		if (!LoadEntityFromBinary(input, componentTypes, propertyKeys, loadPrototypes))
+		{
+			ocError << "Binary: Corrupted data of entity " << i;
+			result = false;
+			break;
+		}
+	}
+
+	UpdatePrototypesInstances();
+
+	if (GlobalProperties::Get<bool>("DevelopMode"))
+	{
+		gEditorMgr.GetHierarchyWindow()->EnableAddEntities();
+	}
+
+	// hierarchy is stored as a block, so it can be skipped outside the develop mode
+	if (result && input.Read<bool>())
+	{
+		ResourceSystem::BinaryInput hierarchyInput = input.ReadBlock(input.Read<uint32>());
+		if (!loadPrototypes && GlobalProperties::Get<bool>("DevelopMode"))
+		{
+			gEditorMgr.GetHierarchyWindow()->LoadHierarchy(hierarchyInput);
+		}
+	}
+
+	return result;
+}
+
+void EntitySystem::EntityMgr::SaveEntityToBinary(const EntitySystem::EntityID entityID, ResourceSystem::BinaryOutput& storage, 
+	BinaryNameTable& componentNames, BinaryNameTable& propertyNames, const bool isPrototype) const
+{
+	const EntityInfo* info = mEntities.at(entityID);
+	const PrototypeInfo* protInfo = 0;
+	if (isPrototype)
+	{
+		protInfo = mPrototypes.at(entityID);
+		OC_ASSERT(protInfo);
+	}
+
+	// write header of the entity
+	storage.WriteString(info->mName);
+	storage.Write<EntityID>(entityID);
+	storage.Write<EntityTag>(info->mTag);
+	storage.Write<bool>(info->mTransient);
+	storage.Write<EntityID>(!isPrototype && info->mPrototype.IsValid() ? info->mPrototype.GetID() : INVALID_ENTITY_ID);
+
+	// component types must be known before the entity is created
+	const uint32 componentsCountPosition = storage.ReserveUInt32();
+	uint32 componentsCount = 0;
+	for (EntityComponentsIterator iter = mComponentMgr->GetEntityComponents(entityID); iter.HasMore(); ++iter)
+	{
+		storage.Write<uint32>(componentNames.GetIndex(GetComponentTypeName((*iter)->GetType())));
+		++componentsCount;
+	}
+	storage.WriteUInt32At(componentsCountPosition, componentsCount);
+
+	// components saving
+	for (EntityComponentsIterator iter = mComponentMgr->GetEntityComponents(entityID); iter.HasMore(); ++iter)
+	{
+		Component* comp = (*iter);
+		const uint32 propertiesCountPosition = storage.ReserveUInt32();
+		uint32 propertiesCount = 0;
+
+		PropertyList propertyList;
+		comp->EnumProperties(comp, propertyList);
+		if (!comp->IsTransient())
+		{
+			for (PropertyList::iterator it = propertyList.begin(); it != propertyList.end(); ++it)
+			{
+				if ((it->GetAccessFlags() & Reflection::PA_TRANSIENT) != 0) continue; // transient
+				if ((it->GetAccessFlags() & Reflection::PA_INIT) == 0) continue; // not initable, so we wouldn't be able to load that
+				bool protPropShared = protInfo && protInfo->mSharedProperties.find(it->GetKey()) != protInfo->mSharedProperties.end();
+				if (isPrototype && !protPropShared) continue; // not shared among prototype instances
+
+				storage.Write<uint32>(propertyNames.GetIndex(it->GetKey().ToString()));
+				storage.Write<uint8>((uint8)it->GetType());
+				storage.Write<Reflection::PropertyAccessFlags>(it->GetAccessFlags());
+				storage.Write<bool>(it->IsValued());
+				if (it->IsValued()) storage.WriteString(it->GetComment()); // property is dynamic, so it must be registered again
+
+				// write property value prefixed by its size, so it can be skipped if the property changes
+				const uint32 valueSizePosition = storage.ReserveUInt32();
+				it->WriteValueBinary(storage);
+				storage.WriteUInt32At(valueSizePosition, storage.GetSize() - valueSizePosition - sizeof(uint32));
+				++propertiesCount;
+			}
+		}
+		storage.WriteUInt32At(propertiesCountPosition, propertiesCount);
+	}
+}
+
+bool EntitySystem::EntityMgr::SaveEntitiesToBinary(ResourceSystem::BinaryOutput& storage, const bool savePrototypes,
+	const bool evenTransient) const
+{
+	// entities are written first, so that the name tables are complete when the header is written
+	BinaryNameTable componentNames;
+	BinaryNameTable propertyNames;
+	ResourceSystem::BinaryOutput entities;
+	const uint32 entitiesCountPosition = entities.ReserveUInt32();
+	uint32 entitiesCount = 0;
+	for (EntityMap::const_iterator i = mEntities.begin(); i != mEntities.end(); ++i)
+	{
+		if ((savePrototypes && mPrototypes.find(i->first) != mPrototypes.end())
+			|| (!savePrototypes && mPrototypes.find(i->first) == mPrototypes.end()))
+		{
+			if (!evenTransient && i->second->mTransient) continue;
+			SaveEntityToBinary(i->first, entities, componentNames, propertyNames, savePrototypes);
+			++entitiesCount;
+		}
+	}
+	entities.WriteUInt32At(entitiesCountPosition, entitiesCount);
+
+	storage.Write<uint32>(BINARY_ENTITIES_MAGIC);
+	storage.Write<uint32>(BINARY_ENTITIES_VERSION);
+
+	// layers
+	storage.Write<bool>(!savePrototypes);
+	if (!savePrototypes)
+	{
+		gLayerMgr.SaveLayers(storage);
+	}
+
+	// name tables
+	storage.Write<uint32>(componentNames.names.size());
+	for (vector<string>::const_iterator it = componentNames.names.begin(); it != componentNames.names.end(); ++it)
+	{
+		storage.WriteString(*it);
+	}
+	storage.Write<uint32>(propertyNames.names.size());
+	for (vector<string>::const_iterator it = propertyNames.names.begin(); it != propertyNames.names.end(); ++it)
+	{
+		storage.WriteString(*it);
+	}
+
+	storage.WriteBytes(entities.GetData(), entities.GetSize());
+
+	// hierarchy
+	const bool saveHierarchy = !savePrototypes && GlobalProperties::Get<bool>("DevelopMode");
+	storage.Write<bool>(saveHierarchy);
+	if (saveHierarchy)
+	{
+		const uint32 hierarchySizePosition = storage.ReserveUInt32();
+		gEditorMgr.GetHierarchyWindow()->SaveHierarchy(storage);
+		storage.WriteUInt32At(hierarchySizePosition, storage.GetSize() - hierarchySizePosition - sizeof(uint32));
+	}
+	return true;
+}
+
 bool EntitySystem::EntityMgr::EntityExists( const EntityHandle h ) const
 {
 	if (!h.IsValid())
@@ -985,6 +1501,15 @@ bool EntitySystem::EntityMgr::HasEntityComponentOfType(const EntityHandle entity
 	return false;
 }
 
+bool EntitySystem::EntityMgr::HasEntityMessageHandler(const EntityHandle entity, const EntityMessage::eType type)
+{
+	for (EntityComponentsIterator it=mComponentMgr->GetEntityComponents(entity.GetID()); it.HasMore(); ++it)
+	{
+		if ((*it)->HasMessageHandler(type)) return true;
+	}
+	return false;
+}
+
 eComponentType EntitySystem::EntityMgr::GetEntityComponentType(const EntityHandle entity, const ComponentID componentID)
 {
 	Component* component = mComponentMgr->GetEntityComponent(entity.GetID(), componentID);
@@ -1160,6 +1685,9 @@ EntitySystem::ComponentID EntitySystem::EntityMgr::AddComponentToEntity( const E
 	cmp->HandleMessage(EntityMessage(EntityMessage::INIT));
 	cmp->HandleMessage(EntityMessage(EntityMessage::POST_INIT));
 
+	// components of entities which are not inited yet are subscribed when the entity is
+	if (IsEntityInited(entity)) SubscribeComponent(entity.GetID(), cmp);
+
 	if (IsEntityPrototype(entity))
 	{
 		MarkPrototypePropertiesShared(entity, cmpID);
@@ -1168,7 +1696,7 @@ EntitySystem::ComponentID EntitySystem::EntityMgr::AddComponentToEntity( const E
 
 	PostMessage(entity, EntityMessage(EntityMessage::COMPONENT_CREATED, Reflection::PropertyFunctionParameters() << (uint32)componentType));
 
-	ocInfo << "Created component " << GetComponentTypeName(componentType) << " of " << entity;
+	ocChannelInfo(LC_ENTITIES) << "Created component " << GetComponentTypeName(componentType) << " of " << entity;
 
 	return cmpID;
 }
@@ -1261,7 +1789,7 @@ void EntitySystem::EntityMgr::DestroyEntityComponent( const EntityHandle entity,
 			// so if the user wants to remove the component linked to the prototype, we have to break the link
 			if (componentToDestroy < GetNumberOfEntityComponents(prototypeID))
 			{
-				ocInfo << "Unlinking " << entity << " from prototype " << prototypeID << " because of component destruction";
+				ocChannelInfo(LC_ENTITIES) << "Unlinking " << entity << " from prototype " << prototypeID << " because of component destruction";
 				UnlinkEntityFromPrototype(entity.GetID());
 			}
 		}
@@ -1289,13 +1817,18 @@ void EntitySystem::EntityMgr::DestroyEntityComponent( const EntityHandle entity,
 		}
 	}
 
-	eComponentType cmpType = mComponentMgr->GetEntityComponent(entity.GetID(), componentToDestroy)->GetType();
+	Component* cmp = mComponentMgr->GetEntityComponent(entity.GetID(), componentToDestroy);
+	eComponentType cmpType = cmp->GetType();
+
+	ComponentsList destroyedComponents;
+	destroyedComponents.push_back(cmp);
+	UnsubscribeComponents(destroyedComponents);
 
 	mComponentMgr->DestroyComponent(entity.GetID(), componentToDestroy);
 
 	PostMessage(entity, EntityMessage(EntityMessage::COMPONENT_DESTROYED, Reflection::PropertyFunctionParameters() << (uint32)cmpType));
 
-	ocInfo << "Destroyed component " << componentToDestroy << " of " << entity;
+	ocChannelInfo(LC_ENTITIES) << "Destroyed component " << componentToDestroy << " of " << entity;
 }
 
 int32 EntitySystem::EntityMgr::GetNumberOfEntityComponents( const EntityHandle entity ) const
@@ -1381,7 +1914,7 @@ bool EntitySystem::EntityMgr::GetEntityComponentProperties( const EntityHandle e
 	return true;
 }
 
-bool EntitySystem::EntityMgr::HasEntityComponentProperty( const EntityHandle entity, const ComponentID componentID, const StringKey propertyKey, const PropertyAccessFlags flagMask /*= PA_FULL_ACCESS*/ ) const
+bool EntitySystem::EntityMgr::HasEntityComponentProperty( const EntityHandle entity, const ComponentID componentID, const StringKey& propertyKey, const PropertyAccessFlags flagMask /*= PA_FULL_ACCESS*/ ) const
 {
 	OC_DASSERT(mComponentMgr);
 
@@ -1543,7 +2076,7 @@ EntitySystem::EntityHandle EntitySystem::EntityMgr::ExportEntityToPrototype( con
 	mEntities[entity.GetID()]->mPrototype = prototype;
 	LinkEntityToPrototype(entity, prototype);
 
-	ocInfo << "Created prototype " << prototype << " from " << entity;
+	ocChannelInfo(LC_ENTITIES) << "Created prototype " << prototype << " from " << entity;
 
 	return prototype;
 }
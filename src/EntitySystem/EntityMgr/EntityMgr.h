@@ -103,12 +103,19 @@ namespace EntitySystem
 		/// @name Entity persistance
 		//@{
 		
-		/// Loads all entities from a XML resource.
+		/// Loads all entities from a XML resource or a binary resource written by SaveEntitiesToBinary.
 		bool LoadEntitiesFromResource(ResourceSystem::ResourcePtr res, const bool loadPrototypes = false);
 
 		/// Saves all entities to a XML stream.
 		bool SaveEntitiesToStorage(ResourceSystem::XMLOutput& storage, const bool savePrototypes = false, const bool evenTransient = false) const;
 
+		/// Loads all entities from binary data written by SaveEntitiesToBinary.
+		bool LoadEntitiesFromBinary(ResourceSystem::BinaryInput& input, const bool loadPrototypes = false);
+
+		/// Saves all entities to binary data. The binary format is much faster to load than XML, but it's not meant
+		/// to be edited by hand.
+		bool SaveEntitiesToBinary(ResourceSystem::BinaryOutput& storage, const bool savePrototypes = false, const bool evenTransient = false) const;
+
 		/// Loads all prototypes from the default file.
 		bool LoadPrototypes();
 
@@ -205,16 +212,16 @@ namespace EntitySystem
 		bool GetEntityComponentProperties(const EntityHandle entity, const ComponentID component, PropertyList& out, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const;
 
 		/// Returns true if the entity has the given property.
-		bool HasEntityProperty(const EntityHandle entity, const StringKey key, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const;
+		bool HasEntityProperty(const EntityHandle entity, const StringKey& key, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const;
 
 		/// Returns true if the component of the entity has the given property.
-		bool HasEntityComponentProperty(const EntityHandle entity, const ComponentID componentID, const StringKey key, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const;
+		bool HasEntityComponentProperty(const EntityHandle entity, const ComponentID componentID, const StringKey& key, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const;
 
 		/// Retrieves a property of an entity. A filter related to properties' flags can be specified.
-		PropertyHolder GetEntityProperty(const EntityHandle entity, const StringKey key, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const;
+		PropertyHolder GetEntityProperty(const EntityHandle entity, const StringKey& key, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const;
 
 		/// Retrieves a property of a component of an entity. A filter related to properties' flags can be specified.
-		PropertyHolder GetEntityComponentProperty(const EntityHandle entity, const ComponentID component, const StringKey propertyKey, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const;
+		PropertyHolder GetEntityComponentProperty(const EntityHandle entity, const ComponentID component, const StringKey& propertyKey, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const;
 
 		/// Register a dynamic property to a component of an entity.
 		template <class T>
@@ -241,13 +248,15 @@ namespace EntitySystem
 		inline EntityMessage::eResult PostMessage(EntityHandle h, const EntityMessage& msg) { return PostMessage(h.GetID(), msg); }
 
 		/// Sends a message to all entities.
+		/// Components handling the message in parallel receive it first, spread over the worker threads. The rest of the
+		/// components (including scripts) receive it afterwards one by one on the calling thread.
 		void BroadcastMessage(const EntityMessage& msg);
 
 		/// Sends a message to all entities.
-		inline void BroadcastMessage(const EntityMessage::eType type) {  BroadcastMessage(EntityMessage(type, Reflection::PropertyFunctionParameters())); }
+		inline void BroadcastMessage(const EntityMessage::eType type) {  BroadcastMessage(EntityMessage(type)); }
 
 		/// Sends a message to all entities.
-		inline void BroadcastMessage(const EntityMessage::eType type, Reflection::PropertyFunctionParameters data) {  BroadcastMessage(EntityMessage(type, data)); }
+		inline void BroadcastMessage(const EntityMessage::eType type, const Reflection::PropertyFunctionParameters& data) {  BroadcastMessage(EntityMessage(type, data)); }
 
 		//@}
 
@@ -259,6 +268,9 @@ namespace EntitySystem
 		/// Returns true if the given entity has a component of the given type.
 		bool HasEntityComponentOfType(const EntityHandle entity, const eComponentType componentType);
 
+		/// Returns true if any component of the given entity handles messages of the given type.
+		bool HasEntityMessageHandler(const EntityHandle entity, const EntityMessage::eType type);
+
 		/// Returns the type of the given component in the given entity, or CT_INVALID if component is not found.
 		eComponentType GetEntityComponentType(const EntityHandle entity, const ComponentID componentID);
 
@@ -300,16 +312,47 @@ namespace EntitySystem
 		typedef hash_map<EntityID, EntityInfo*> EntityMap;
 		typedef hash_map<EntityID, PrototypeInfo*> PrototypeMap;
 		typedef vector<EntityID> EntityQueue;
+		typedef vector<Component*> MessageSubscribers;
 
 		ComponentMgr* mComponentMgr;
 		EntityMap mEntities;
 		PrototypeMap mPrototypes;
 		EntityQueue mEntityDestroyQueue;
+		Utils::JobPool* mJobPool;
+
+		/// Components of fully inited entities receiving broadcasts of each message type. Components of a single
+		/// entity are kept in the order of the entity's components. The components handling the message in parallel
+		/// are kept in the same list, so that the order of the handlers is the same whether they run in parallel or not.
+		MessageSubscribers mMessageSubscribers[EntityMessage::NUM_TYPES];
+
+		/// Number of broadcasts in progress. Subscribers removed meanwhile are only set to null, so that the lists
+		/// being walked keep their indices.
+		uint32 mBroadcastDepth;
+
+		/// True if some subscribers were set to null and the lists must be compacted after the broadcast.
+		bool mHasRemovedSubscribers;
+
+		/// Delivers the message to the subscribers in the range [begin, end) of a run of parallel subscribers.
+		static void HandleMessageInParallel(void* context, const uint32 begin, const uint32 end);
+
+		/// Adds the component to the broadcast lists of all message types it handles.
+		void SubscribeComponent(const EntityID entity, Component* cmp);
+
+		/// Adds all components of the entity to the broadcast lists.
+		void SubscribeEntityComponents(const EntityID entity);
+
+		/// Removes the components from the broadcast lists. The list is sorted during the process.
+		/// @remarks All subscriber lists are walked only once, so batch as many components as possible.
+		void UnsubscribeComponents(ComponentsList& components);
+
+		/// Removes the null subscribers left by UnsubscribeComponents during a broadcast.
+		void CompactSubscribers();
 
 		/// Posts a message to an entity. It is the only way entities can communicate with each other apart from the properties.
 		EntityMessage::eResult PostMessage(EntityID targetEntity, const EntityMessage& msg);
 
 		/// Destructs an entity completely and removes it from the system.
+		/// The components of the entity must be unsubscribed from broadcasts before.
 		/// @param erase If set to true, the entity will be removed from the entity map as well.
 		void DestroyEntityImmediately(const EntityID entityToDestroy, const bool erase);
 
@@ -322,14 +365,32 @@ namespace EntitySystem
 		/// Returns true if the property can be marked at shared when the prototype is created.
 		bool IsPrototypePropertyAppliableToBeShared(const PropertyHolder prop) const;
 
-		/// Load an entity from the XML file given a node iterator to its node.
-		void LoadEntityFromXML(ResourceSystem::XMLNodeIterator& entIt, const bool isPrototype);
+		/// Load an entity from the XML file given a reader positioned on its element.
+		void LoadEntityFromXML(ResourceSystem::XMLReader& xml, const bool isPrototype);
 
-		/// Load a property for the given entity from a XML file.
-		void LoadEntityPropertyFromXML(const EntityID entityID, const ComponentID componentID, PrototypeInfo* prototypeInfo, ResourceSystem::XMLNodeIterator& xmlPropertyIterator);
+		/// Load a property for the given entity from a XML file given a reader positioned on its element.
+		void LoadEntityPropertyFromXML(const EntityID entityID, const ComponentID componentID, PrototypeInfo* prototypeInfo, ResourceSystem::XMLReader& xml);
 
 		/// Save and entity to the XML file.
 		bool SaveEntityToStorage(const EntityID entityID, ResourceSystem::XMLOutput& storage, const bool isPrototype, const bool evenTransient) const;
+
+		/// Names stored once in the binary data and referenced by their indices.
+		struct BinaryNameTable
+		{
+			hash_map<string, uint32> indices;
+			vector<string> names;
+
+			/// Returns the index of the name. The name is added to the table if it's not there yet.
+			uint32 GetIndex(const string& name);
+		};
+
+		/// Load an entity from the binary data. Returns false if the data is corrupted.
+		bool LoadEntityFromBinary(ResourceSystem::BinaryInput& input, const vector<eComponentType>& componentTypes, 
+			const vector<StringKey>& propertyKeys, const bool isPrototype);
+
+		/// Save an entity to the binary data.
+		void SaveEntityToBinary(const EntityID entityID, ResourceSystem::BinaryOutput& storage, BinaryNameTable& componentNames,
+			BinaryNameTable& propertyNames, const bool isPrototype) const;
 	};
 }
 
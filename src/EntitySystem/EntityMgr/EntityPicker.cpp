@@ -1,5 +1,6 @@
 #include "Common.h"
 #include "EntityPicker.h"
+#include "PropertyKeys.h"
 #include <Box2D.h>
 
 using namespace EntitySystem;
@@ -78,7 +79,7 @@ EntitySystem::EntityHandle EntitySystem::EntityPicker::PickSingleEntity( void )
 
 		// check the layer
 		EntityHandle entity = *(EntityHandle*)shape->GetUserData();
-		int32 depth = entity.GetProperty("Layer").GetValue<int32>();
+		int32 depth = entity.GetProperty(PropertyKeys::Layer).GetValue<int32>();
 		if (depth >= mMinLayer && depth <= mMaxLayer && depth < lowestDepth)
 		{
 			depth = lowestDepth;
@@ -152,7 +153,7 @@ uint32 EntitySystem::EntityPicker::PickMultipleEntities( const Vector2& worldCur
 			EntityHandle entity = *(EntityHandle*)shape->GetUserData();
 			
 			// check the layer
-			int32 layer = entity.GetProperty("Layer").GetValue<int32>();
+			int32 layer = entity.GetProperty(PropertyKeys::Layer).GetValue<int32>();
 			if (layer >= mMinLayer && layer <= mMaxLayer)
 			{
 				out.push_back(entity);
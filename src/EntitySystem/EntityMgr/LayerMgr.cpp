@@ -1,9 +1,16 @@
 #include "Common.h"
 #include "LayerMgr.h"
-#include "ResourceSystem/XMLResource.h"
+#include "ResourceSystem/XMLReader.h"
+#include "ResourceSystem/BinaryInput.h"
+#include "ResourceSystem/BinaryOutput.h"
 
 using namespace EntitySystem;
 
+const StringKey XML_LAYER_ELEMENT("Layer");
+const StringKey XML_DIFFERENCE_ATTRIBUTE("Difference");
+const StringKey XML_ACTIVE_LAYER_ATTRIBUTE("ActiveLayer");
+const StringKey XML_VISIBLE_ATTRIBUTE("Visible");
+
 LayerMgr::LayerMgr() : mLayers(), mDifference(0), mActiveLayerID(0), mList()
 {
 	ocInfo << "*** LayerMgr init ***";
@@ -15,19 +22,20 @@ LayerMgr::~LayerMgr()
 
 }
 
-void LayerMgr::LoadLayers(ResourceSystem::XMLNodeIterator& xml)
+void LayerMgr::LoadLayers(ResourceSystem::XMLReader& xml)
 {
 	mLayers.clear();
 	mLayerVisibilities.clear();
 
-	mDifference = xml.GetAttribute<int32>("Difference");
-	mActiveLayerID = xml.GetAttribute<LayerID>("ActiveLayer");
+	mDifference = xml.GetAttribute<int32>(XML_DIFFERENCE_ATTRIBUTE);
+	mActiveLayerID = xml.GetAttribute<LayerID>(XML_ACTIVE_LAYER_ATTRIBUTE);
 
-	for (ResourceSystem::XMLNodeIterator iter = xml.IterateChildren(); iter != xml.EndChildren(); ++iter)
+	const uint32 depth = xml.GetDepth();
+	while (xml.ReadChildElement(depth))
 	{
-		if ((*iter).compare("Layer") != 0) continue;
-		mLayerVisibilities.push_back(iter.HasAttribute("Visible") ? iter.GetAttribute<bool>("Visible") : true);
-		mLayers.push_back(iter.GetChildValue<string>());
+		if (xml.GetName() != XML_LAYER_ELEMENT) continue;
+		mLayerVisibilities.push_back(xml.HasAttribute(XML_VISIBLE_ATTRIBUTE) ? xml.GetAttribute<bool>(XML_VISIBLE_ATTRIBUTE) : true);
+		mLayers.push_back(xml.ReadElementText());
 	}
 
 	if (mLayers.empty())
@@ -62,6 +70,48 @@ void LayerMgr::SaveLayers(ResourceSystem::XMLOutput& storage)
 	storage.EndElement();
 }
 
+void LayerMgr::LoadLayers(ResourceSystem::BinaryInput& input)
+{
+	mLayers.clear();
+	mLayerVisibilities.clear();
+
+	mDifference = input.Read<int32>();
+	mActiveLayerID = input.Read<LayerID>();
+
+	const uint32 layersCount = input.Read<uint32>();
+	for (uint32 i=0; i<layersCount && !input.HasFailed(); ++i)
+	{
+		mLayers.push_back(input.ReadString());
+		mLayerVisibilities.push_back(input.Read<bool>());
+	}
+
+	if (mLayers.empty() || input.HasFailed())
+	{ 
+		mLayers.clear();
+		mLayerVisibilities.clear();
+		mDifference = 0;
+		mActiveLayerID = 0;
+		PushBackLayer(gStringMgrSystem.GetTextData(GUISystem::GUIMgr::GUIGroup, "initial_layer").c_str());
+	}
+
+	RefreshList();
+}
+
+void LayerMgr::SaveLayers(ResourceSystem::BinaryOutput& storage)
+{
+	storage.Write<int32>(mDifference);
+	storage.Write<LayerID>(mActiveLayerID);
+	storage.Write<uint32>(mLayers.size());
+
+	Layers::const_iterator lit = mLayers.begin();
+	LayerVisibilities::const_iterator lvit = mLayerVisibilities.begin();
+	for (; lit != mLayers.end(); ++lit, ++lvit)
+	{
+		storage.WriteString(*lit);
+		storage.Write<bool>(*lvit);
+	}
+}
+
 bool LayerMgr::EntityHasLayer(EntityHandle handle) const
 {
 	return gEntityMgr.HasEntityComponentOfType(handle, CT_Transform);
@@ -30,11 +30,17 @@ namespace EntitySystem
 		void Clear();
 		
 		/// Loads layers from an XML input.
-		void LoadLayers(ResourceSystem::XMLNodeIterator& xml);
+		void LoadLayers(ResourceSystem::XMLReader& xml);
 
 		/// Saves layers to an XML output.
 		void SaveLayers(ResourceSystem::XMLOutput& storage);
 
+		/// Loads layers from a binary input.
+		void LoadLayers(ResourceSystem::BinaryInput& input);
+
+		/// Saves layers to a binary output.
+		void SaveLayers(ResourceSystem::BinaryOutput& storage);
+
 		/// Adds the layer top.
 		/// @return ID of the new layer, 0 in case of error.
 		LayerID AddTopLayer(const string& name);
@@ -0,0 +1,10 @@
+#include "Common.h"
+#include "PropertyKeys.h"
+
+const StringKey EntitySystem::PropertyKeys::Position("Position");
+const StringKey EntitySystem::PropertyKeys::Angle("Angle");
+const StringKey EntitySystem::PropertyKeys::Scale("Scale");
+const StringKey EntitySystem::PropertyKeys::Layer("Layer");
+const StringKey EntitySystem::PropertyKeys::Zoom("Zoom");
+const StringKey EntitySystem::PropertyKeys::Rotation("Rotation");
+const StringKey EntitySystem::PropertyKeys::PhysicalBody("PhysicalBody");
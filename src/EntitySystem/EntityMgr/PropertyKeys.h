@@ -0,0 +1,25 @@
+/// @file
+/// Keys of the entity properties used often by the engine.
+
+#ifndef PropertyKeys_h__
+#define PropertyKeys_h__
+
+#include "Base.h"
+
+namespace EntitySystem
+{
+	/// Keys of the entity properties accessed by the engine every frame or physics step. The keys are constructed
+	/// once during the static initialization, so the lookups using them don't have to search the global map of strings.
+	namespace PropertyKeys
+	{
+		extern const StringKey Position;
+		extern const StringKey Angle;
+		extern const StringKey Scale;
+		extern const StringKey Layer;
+		extern const StringKey Zoom;
+		extern const StringKey Rotation;
+		extern const StringKey PhysicalBody;
+	}
+}
+
+#endif // PropertyKeys_h__
@@ -1,5 +1,6 @@
 #include "Common.h"
 #include "Runner/UnitTests.h"
+#include "EntitySystem/Components/_ComponentHeaders.h"
 
 using namespace EntitySystem;
 
@@ -63,6 +64,14 @@ SUITE(EntityMgr)
 		::Test::CleanSubsystems();
 	}
 
+	TEST(HandledMessages)
+	{
+		CHECK(EntityComponents::Transform::GetClassRTTI()->HandlesMessage(EntityMessage::SYNC_PRE_PHYSICS));
+		CHECK(!EntityComponents::Transform::GetClassRTTI()->HandlesMessage(EntityMessage::UPDATE_LOGIC));
+		CHECK(!EntityComponents::Camera::GetClassRTTI()->HandlesMessage(EntityMessage::DRAW));
+		CHECK(EntityComponents::Script::GetClassRTTI()->HandlesMessage(EntityMessage::CHECK_ACTION));
+	}
+
 
 	TEST(EntityPersistance)
 	{
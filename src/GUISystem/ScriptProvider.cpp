@@ -51,7 +51,7 @@ bool ScriptCallback::operator()(const CEGUI::EventArgs &args) const
 	if (handle) ctx->SetUserData(handle);
 	ctx->SetArgObject(0, argument ? argument->window : 0);
 	gScriptMgr.ExecuteContext(ctx, 1000);
-	ctx->Release();
+	gScriptMgr.ReleaseContext(ctx);
 
 	return true;
 }
@@ -6,6 +6,8 @@
 #include "EntitySystem/Components/Sprite.h"
 #include "EntitySystem/Components/Model.h"
 #include "EntitySystem/Components/Transform.h"
+#include "EntitySystem/EntityMgr/PropertyKeys.h"
+#include "SDL/SDL_mutex.h"
 
 using namespace GfxSystem;
 
@@ -15,10 +17,37 @@ const float32 GfxRenderer::PIXELS_PER_WORLD_UNIT = 50;
 /// Depth of each layer.
 const float32 LAYER_Z_SIZE = 5.0f;
 
+/// Maximum number of quads reordered together. Each quad is tested for overlap with all previous quads of the run,
+/// so the limit keeps the cost linear.
+const size_t MAX_REORDERED_QUADS = 64;
 
-GfxSystem::GfxRenderer::GfxRenderer(): mCurrentRenderTargetID(InvalidRenderTargetID), mIsRendering(false), mSceneMgr(0)
+/// Orders quads by their textures.
+struct QuadTextureComparator
+{
+	bool operator()(const TexturedQuad& lhs, const TexturedQuad& rhs) const
+	{
+		return lhs.texture < rhs.texture;
+	}
+};
+
+/// Returns the radius of a circle containing the whole quad.
+float32 GetQuadRadius(const TexturedQuad& quad)
+{
+	return 0.5f * Vector2(quad.size.x * quad.scale.x, quad.size.y * quad.scale.y).Length() / GfxRenderer::PIXELS_PER_WORLD_UNIT;
+}
+
+/// Returns true if the quads may overlap.
+bool QuadsOverlap(const TexturedQuad& lhs, const float32 lhsRadius, const TexturedQuad& rhs, const float32 rhsRadius)
+{
+	const float32 distance = lhsRadius + rhsRadius;
+	return MathUtils::Abs(lhs.position.x - rhs.position.x) < distance && MathUtils::Abs(lhs.position.y - rhs.position.y) < distance;
+}
+
+
+GfxSystem::GfxRenderer::GfxRenderer(): mCurrentRenderTargetID(InvalidRenderTargetID), mInterpolationFactor(1.0f), mIsRendering(false), mSceneMgr(0)
 {
 	mSceneMgr = new GfxSceneMgr();
+	mImageLibraryMutex = SDL_CreateMutex();
 }
 
 GfxSystem::GfxRenderer::~GfxRenderer()
@@ -34,6 +63,7 @@ GfxSystem::GfxRenderer::~GfxRenderer()
 	{
 		delete mSceneMgr;
 	}
+	SDL_DestroyMutex(mImageLibraryMutex);
 }
 
 bool GfxSystem::GfxRenderer::BeginRendering()
@@ -200,10 +230,48 @@ void GfxSystem::GfxRenderer::DrawEntities()
 {
 	OC_ASSERT(mIsRendering);
 
-	mSceneMgr->DrawVisibleDrawables();
+	Vector2 worldMin, worldMax;
+	CalculateRenderTargetWorldBoundaries(mCurrentRenderTargetID, worldMin, worldMax);
+	mSceneMgr->DrawVisibleDrawables(worldMin, worldMax);
+	FlushQueuedQuads();
+}
+
+void GfxSystem::GfxRenderer::QueueTexturedQuad( const TexturedQuad& quad )
+{
+	// the quads at different depths are never reordered
+	if (!mQueuedQuads.empty() && mQueuedQuads.back().z != quad.z) FlushQueuedQuads();
+	mQueuedQuads.push_back(quad);
+}
+
+void GfxSystem::GfxRenderer::FlushQueuedQuads()
+{
+	if (mQueuedQuads.empty()) return;
+
+	// the queue is split into runs of quads not overlapping each other; their order doesn't matter, so each run
+	// is sorted by the textures
+	mQueuedQuadRadii.resize(mQueuedQuads.size());
+	size_t runStart = 0;
+	for (size_t i=0; i<mQueuedQuads.size(); ++i)
+	{
+		mQueuedQuadRadii[i] = GetQuadRadius(mQueuedQuads[i]);
+		bool overlaps = i - runStart >= MAX_REORDERED_QUADS;
+		for (size_t j=runStart; j<i && !overlaps; ++j)
+		{
+			overlaps = QuadsOverlap(mQueuedQuads[i], mQueuedQuadRadii[i], mQueuedQuads[j], mQueuedQuadRadii[j]);
+		}
+		if (overlaps)
+		{
+			std::stable_sort(mQueuedQuads.begin() + runStart, mQueuedQuads.begin() + i, QuadTextureComparator());
+			runStart = i;
+		}
+	}
+	std::stable_sort(mQueuedQuads.begin() + runStart, mQueuedQuads.end(), QuadTextureComparator());
+
+	DrawTexturedQuads(&mQueuedQuads[0], mQueuedQuads.size());
+	mQueuedQuads.clear();
 }
 
-void GfxSystem::GfxRenderer::DrawSprite( const EntitySystem::Component* spriteComponent, const EntitySystem::Component* transformComponent ) const
+void GfxSystem::GfxRenderer::DrawSprite( const EntitySystem::Component* spriteComponent, const EntitySystem::Component* transformComponent )
 {
 	if (spriteComponent->GetType() != EntitySystem::CT_Sprite || transformComponent->GetType() != EntitySystem::CT_Transform)
 	{
@@ -215,9 +283,9 @@ void GfxSystem::GfxRenderer::DrawSprite( const EntitySystem::Component* spriteCo
 	EntityComponents::Transform* transform = (EntityComponents::Transform*)transformComponent;
 
 	TexturedQuad quad;
-	quad.position = transform->GetPosition();
+	quad.position = transform->GetInterpolatedPosition(mInterpolationFactor);
 	quad.scale = transform->GetScale();
-	quad.angle = transform->GetAngle();
+	quad.angle = transform->GetInterpolatedAngle(mInterpolationFactor);
 	quad.z = LAYER_Z_SIZE * (float32)transform->GetLayer();
 	quad.transparency = sprite->GetTransparency();
 	TexturePtr tex = ((TexturePtr)sprite->GetTexture());
@@ -244,10 +312,10 @@ void GfxSystem::GfxRenderer::DrawSprite( const EntitySystem::Component* spriteCo
 		quad.texOffset.Set(0,0);
 	}
 
-	DrawTexturedQuad(quad);
+	QueueTexturedQuad(quad);
 }
 
-void GfxSystem::GfxRenderer::DrawModel( const EntitySystem::Component* modelComponent, const EntitySystem::Component* transformComponent ) const
+void GfxSystem::GfxRenderer::DrawModel( const EntitySystem::Component* modelComponent, const EntitySystem::Component* transformComponent )
 {
 	if (modelComponent->GetType() != EntitySystem::CT_Model || transformComponent->GetType() != EntitySystem::CT_Transform)
 	{
@@ -259,22 +327,25 @@ void GfxSystem::GfxRenderer::DrawModel( const EntitySystem::Component* modelComp
 	EntityComponents::Transform* transform = (EntityComponents::Transform*)transformComponent;
 
 	TexturedMesh mesh;
-	mesh.position = transform->GetPosition();
+	mesh.position = transform->GetInterpolatedPosition(mInterpolationFactor);
 	mesh.scale = transform->GetScale();
-	mesh.angle = transform->GetAngle();
+	mesh.angle = transform->GetInterpolatedAngle(mInterpolationFactor);
 	mesh.z = LAYER_Z_SIZE * (float32)transform->GetLayer();
 	mesh.yAngle = model->GetYAngle();
 	mesh.transparency = model->GetTransparency();
 	mesh.mesh = (((MeshPtr)model->GetMesh())->GetMesh());
 
+	// the sprites queued so far must be drawn below the model
+	FlushQueuedQuads();
 	DrawTexturedMesh(mesh);
 }
 
-void GfxSystem::GfxRenderer::DrawEntity( const EntitySystem::EntityHandle entity ) const
+void GfxSystem::GfxRenderer::DrawEntity( const EntitySystem::EntityHandle entity )
 {
 	if (gEntityMgr.HasEntityComponentOfType(entity, CT_Sprite))
 	{
 		DrawSprite(gEntityMgr.GetEntityComponentPtr(entity, EntitySystem::CT_Sprite), gEntityMgr.GetEntityComponentPtr(entity, CT_Transform));
+		FlushQueuedQuads();
 	}
 	if (gEntityMgr.HasEntityComponentOfType(entity, CT_Model))
 	{
@@ -311,7 +382,7 @@ float32 GfxSystem::GfxRenderer::GetRenderTargetCameraZoom( const RenderTargetID
 	EntitySystem::EntityHandle cameraHandle = GetRenderTargetCamera(renderTarget);
 	if (cameraHandle.IsValid())
 	{
-		return cameraHandle.GetProperty("Zoom").GetValue<float32>();
+		return cameraHandle.GetProperty(PropertyKeys::Zoom).GetValue<float32>();
 	}
 	return 0;
 }
@@ -321,7 +392,7 @@ bool GfxSystem::GfxRenderer::SetRenderTargetCameraZoom( const RenderTargetID ren
 	EntitySystem::EntityHandle cameraHandle = GetRenderTargetCamera(renderTarget);
 	if (cameraHandle.IsValid())
 	{
-		cameraHandle.GetProperty("Zoom").SetValue<float32>(newZoom);
+		cameraHandle.GetProperty(PropertyKeys::Zoom).SetValue<float32>(newZoom);
 		return true;
 	}
 	return false;
@@ -332,7 +403,7 @@ float32 GfxSystem::GfxRenderer::GetRenderTargetCameraRotation( const RenderTarge
 	EntitySystem::EntityHandle cameraHandle = GetRenderTargetCamera(renderTarget);
 	if (cameraHandle.IsValid())
 	{
-		return cameraHandle.GetProperty("Rotation").GetValue<float32>();
+		return cameraHandle.GetProperty(PropertyKeys::Rotation).GetValue<float32>();
 	}
 	return 0;
 }
@@ -342,7 +413,7 @@ Vector2 GfxSystem::GfxRenderer::GetRenderTargetCameraPosition( const RenderTarge
 	EntitySystem::EntityHandle cameraHandle = GetRenderTargetCamera(renderTarget);
 	if (cameraHandle.IsValid())
 	{
-		return cameraHandle.GetProperty("Position").GetValue<Vector2>();
+		return cameraHandle.GetProperty(PropertyKeys::Position).GetValue<Vector2>();
 	}
 	return Vector2();
 }
@@ -352,7 +423,7 @@ bool GfxSystem::GfxRenderer::SetRenderTargetCameraPosition( const RenderTargetID
 	EntitySystem::EntityHandle cameraHandle = GetRenderTargetCamera(renderTarget);
 	if (cameraHandle.IsValid())
 	{
-		cameraHandle.GetProperty("Position").SetValue<Vector2>(newPosition);
+		cameraHandle.GetProperty(PropertyKeys::Position).SetValue<Vector2>(newPosition);
 		return true;
 	}
 	return false;
@@ -362,10 +433,10 @@ Vector2 GfxSystem::GfxRenderer::GetInverseCameraTranform( const EntitySystem::En
 {
 	Vector2 result = vec;
 	// inverse camera transform
-	result *= 1.0f / cameraHandle.GetProperty("Zoom").GetValue<float32>();
-	Matrix22 rotationMatrix(cameraHandle.GetProperty("Rotation").GetValue<float32>());
+	result *= 1.0f / cameraHandle.GetProperty(PropertyKeys::Zoom).GetValue<float32>();
+	Matrix22 rotationMatrix(cameraHandle.GetProperty(PropertyKeys::Rotation).GetValue<float32>());
 	result = MathUtils::Multiply(rotationMatrix, result);
-	result += cameraHandle.GetProperty("Position").GetValue<Vector2>();
+	result += cameraHandle.GetProperty(PropertyKeys::Position).GetValue<Vector2>();
 	return result;
 }
 
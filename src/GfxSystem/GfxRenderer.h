@@ -9,6 +9,8 @@
 #include "GfxViewport.h"
 #include "RenderTarget.h"
 
+struct SDL_mutex;
+
 /// Macro for easier use.
 #define gGfxRenderer GfxSystem::GfxRenderer::GetSingleton()
 
@@ -71,32 +73,60 @@ namespace GfxSystem
 		virtual TextureHandle LoadTexture(const uint8* const buffer, const int32 buffer_length, const ePixelFormat force_channels, 
 			const uint32 reuse_texture_ID, int32* width, int32* height) const = 0;
 
+		/// Decodes an image from RAM into raw pixels. Unlike the other methods, this one can be called from any thread.
+		///	\param buffer the image data in RAM just as if it were still in a file
+		///	\param buffer_length the size of the buffer in bytes
+		///	\param force_channels 0-image format, 1-luminous, 2-luminous/alpha, 3-RGB, 4-RGBA
+		///	\param width, height, channels returns size and number of channels of the image
+		///	\return null-failed, otherwise the pixels which must be freed by FreeTextureImage
+		virtual uint8* DecodeTextureImage(const uint8* const buffer, const int32 buffer_length, const ePixelFormat force_channels,
+			int32* width, int32* height, int32* channels) const = 0;
+
+		/// Frees the pixels returned by DecodeTextureImage.
+		virtual void FreeTextureImage(uint8* pixels) const = 0;
+
+		/// Creates the platform specific texture from the pixels returned by DecodeTextureImage.
+		///	\param reuse_texture_ID 0-generate a new texture ID, otherwise reuse the texture ID (overwriting the old texture)
+		///	\return 0-failed, otherwise returns the OpenGL texture handle
+		virtual TextureHandle CreateTexture(const uint8* const pixels, const int32 width, const int32 height, const int32 channels,
+			const uint32 reuse_texture_ID) const = 0;
+
 		/// Creates a texture into which it can be rendered.
 		virtual TextureHandle CreateRenderTexture(const uint32 width, const uint32 height) const = 0;
 
 		/// Deletes the texture from the memory.
 		virtual void DeleteTexture(const TextureHandle& handle) const = 0;
 
-		/// Adds a textured quad to the queue for rendering.
-		void QueueTexturedQuad(const TexturedQuad spr);
+		/// Adds a textured quad to the queue for rendering. The quad is drawn in the next FlushQueuedQuads call.
+		/// The queue is flushed first if the quad is at another depth than the queued ones.
+		void QueueTexturedQuad(const TexturedQuad& quad);
+
+		/// Draws all quads in the queue and empties it. Only the quads which don't overlap are reordered by their
+		/// texture, so that the quads sharing a texture can be drawn at once while the result looks the same as if
+		/// they were drawn in the queued order.
+		void FlushQueuedQuads();
 
 		/// Draws all visible entities.
 		void DrawEntities();
 
+		/// Sets where in between their previous and current transform the entities are drawn. Zero means the state
+		/// before the last physics step, one means the current state.
+		inline void SetInterpolationFactor(const float32 factor) { mInterpolationFactor = factor; }
+
 		/// Draws a quad with its texture.
 		virtual void DrawTexturedQuad(const TexturedQuad& quad) const = 0;
 
 		/// Draws a 3d model.
 		virtual void DrawTexturedMesh(const TexturedMesh& mesh) const = 0;
 
-		/// Draws a sprite component.
-		void DrawSprite(const EntitySystem::Component* sprite, const EntitySystem::Component* transform) const;
+		/// Queues a sprite component for drawing.
+		void DrawSprite(const EntitySystem::Component* sprite, const EntitySystem::Component* transform);
 
-		/// Draws a 3d model component.
-		void DrawModel(const EntitySystem::Component* model, const EntitySystem::Component* transform) const;
+		/// Draws a 3d model component. The queued quads are drawn before it.
+		void DrawModel(const EntitySystem::Component* model, const EntitySystem::Component* transform);
 
 		/// Draws a single entity.
-		void DrawEntity(const EntitySystem::EntityHandle entity) const;
+		void DrawEntity(const EntitySystem::EntityHandle entity);
 
 		/// Draws a line. Verts must be an array of 2 Vector2s.
 		inline virtual void DrawLine(const Vector2* verts, const Color& color, const float32 width = 1.0f) const;
@@ -175,13 +205,23 @@ namespace GfxSystem
 		/// Called when the current camera is changed.
 		virtual void SetCameraImpl(const Vector2& position, const float32 zoom, const float32 rotation) const = 0;
 
+		/// Draws an array of quads in the given order. The consecutive quads with the same texture are drawn at once.
+		virtual void DrawTexturedQuads(const TexturedQuad* quads, const int32 count) = 0;
+
 	private:
 
+		// Quads waiting for rendering.
+		typedef vector<TexturedQuad> TexturedQuadsVector;
+		TexturedQuadsVector mQueuedQuads;
+		vector<float32> mQueuedQuadRadii;
+
 		// Render targets.
 		typedef vector<RenderTarget*> RenderTargetsVector;
 		RenderTargetsVector mRenderTargets;
 		RenderTargetID mCurrentRenderTargetID;
 
+		float32 mInterpolationFactor;
+
 	private:
 
 		/// Converts coordinates from the screen space to the world space.
@@ -209,6 +249,10 @@ namespace GfxSystem
 		/// Scene management.
 		GfxSceneMgr* mSceneMgr;
 
+		/// Guards reading the reason of the last failure of the image decoder, which is kept in a global variable.
+		/// The textures are decoded on the resource loading threads.
+		SDL_mutex* mImageLibraryMutex;
+
 	private:
 	
 		/// Disabled.
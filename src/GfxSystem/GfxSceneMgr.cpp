@@ -1,59 +1,390 @@
 #include "Common.h"
 #include "GfxSceneMgr.h"
+#include "SDL/SDL_mutex.h"
+#include "GfxSystem/Texture.h"
+#include "GfxSystem/Mesh.h"
+#include "GfxSystem/objloader/model_obj.h"
 #include "EntitySystem/EntityMgr/LayerMgr.h"
 #include "EntitySystem/Components/Transform.h"
+#include "EntitySystem/Components/Sprite.h"
+#include "EntitySystem/Components/Model.h"
 
 using namespace GfxSystem;
 
+/// Size of a cell of the spatial index in world units.
+const float32 GRID_CELL_SIZE = 8.0f;
 
-GfxSceneMgr::GfxSceneMgr()
+/// Number of bits of a drawable handle used for the slot index. The rest is used for the slot generation.
+const uint32 DRAWABLE_HANDLE_SLOT_BITS = 24;
+const uint32 DRAWABLE_HANDLE_SLOT_MASK = (1 << DRAWABLE_HANDLE_SLOT_BITS) - 1;
+
+
+GfxSceneMgr::GfxSceneMgr(): mBatchRemovalDepth(0), mAllTransformsDirty(false), mMaxDrawableRadius(0.0f), mNextDrawableSequence(0)
 {
+	mDirtyTransformsMutex = SDL_CreateMutex();
 }
 
 GfxSceneMgr::~GfxSceneMgr()
 {
+	SDL_DestroyMutex(mDirtyTransformsMutex);
+}
+
+DrawableHandle GfxSceneMgr::AddDrawable(const EntitySystem::Component* drawable, const EntitySystem::Component* transform)
+{
+	OC_ASSERT(drawable && transform);
+
+	SlotIndex slot;
+	if (mFreeSlots.empty())
+	{
+		slot = mSlots.size();
+		OC_ASSERT_MSG(slot <= DRAWABLE_HANDLE_SLOT_MASK, "Too many drawables");
+		DrawableSlot newSlot;
+		newSlot.generation = 1;
+		mSlots.push_back(newSlot);
+	}
+	else
+	{
+		slot = mFreeSlots.back();
+		mFreeSlots.pop_back();
+	}
+	mSlots[slot].index = mDrawables.size();
+
+	mDrawables.push_back(DrawableInfo());
+	DrawableInfo& info = mDrawables.back();
+	info.drawable = drawable;
+	info.transform = transform;
+	info.position = ((EntityComponents::Transform*)transform)->GetPosition();
+	info.radius = CalculateDrawableRadius(info);
+	info.cell = GetCellKey(info.position);
+	info.slot = slot;
+	info.sequence = mNextDrawableSequence++;
+	info.removed = false;
+	mGridCells[info.cell].push_back(slot);
+	mMaxDrawableRadius = MathUtils::Max(mMaxDrawableRadius, info.radius);
+
+	mTransformDrawables[transform].push_back(slot);
+
+	return ((DrawableHandle)mSlots[slot].generation << DRAWABLE_HANDLE_SLOT_BITS) | slot;
+}
+
+GfxSceneMgr::DrawableInfo* GfxSceneMgr::GetDrawable(const DrawableHandle handle)
+{
+	SlotIndex slot = handle & DRAWABLE_HANDLE_SLOT_MASK;
+	if (handle == InvalidDrawableHandle || slot >= mSlots.size()) return 0;
+	if (mSlots[slot].generation != (uint8)(handle >> DRAWABLE_HANDLE_SLOT_BITS)) return 0;
+	return &GetSlotDrawable(slot);
+}
+
+void GfxSceneMgr::FreeSlot(const SlotIndex slot)
+{
+	// zero generation is skipped, so no valid handle equals to InvalidDrawableHandle
+	uint8& generation = mSlots[slot].generation;
+	if (++generation == 0) generation = 1;
+	mFreeSlots.push_back(slot);
+}
+
+void GfxSceneMgr::RemoveFromTransform(const DrawableInfo& info)
+{
+	TransformDrawablesMap::iterator transformIt = mTransformDrawables.find(info.transform);
+	OC_DASSERT(transformIt != mTransformDrawables.end());
+	SlotIndexVector& transformDrawables = transformIt->second;
+	transformDrawables.erase(Containers::find(transformDrawables.begin(), transformDrawables.end(), info.slot));
+	if (transformDrawables.empty()) mTransformDrawables.erase(transformIt);
+}
+
+void GfxSceneMgr::RemoveDrawable(const DrawableHandle handle)
+{
+	DrawableInfo* info = GetDrawable(handle);
+	if (!info || info->removed) return;
+
+	if (mBatchRemovalDepth > 0)
+	{
+		info->removed = true;
+		mPendingRemovals.push_back(info->slot);
+		return;
+	}
+
+	RemoveFromGrid(*info);
+	RemoveFromTransform(*info);
+	SlotIndex slot = info->slot;
 
+	// move the last drawable to the place of the removed one
+	uint32 index = mSlots[slot].index;
+	if (index != mDrawables.size() - 1)
+	{
+		mDrawables[index] = mDrawables.back();
+		mSlots[mDrawables[index].slot].index = index;
+	}
+	mDrawables.pop_back();
+	FreeSlot(slot);
 }
 
-void GfxSceneMgr::AddDrawable(const EntitySystem::Component* drawable, const EntitySystem::Component* transform)
+void GfxSceneMgr::BeginBatchRemoval()
 {
-	mDrawables.push_back(DrawablePair(drawable, transform));
+	++mBatchRemovalDepth;
 }
 
-void GfxSceneMgr::RemoveDrawable(const EntitySystem::Component* drawable)
+void GfxSceneMgr::EndBatchRemoval()
 {
-	for (DrawableVector::iterator it=mDrawables.begin(); it!=mDrawables.end(); ++it)
+	OC_ASSERT(mBatchRemovalDepth > 0);
+	if (--mBatchRemovalDepth > 0 || mPendingRemovals.empty()) return;
+
+	// throw the removed drawables away from the cells in a single pass
+	for (GridCellMap::iterator cellIt=mGridCells.begin(); cellIt!=mGridCells.end();)
 	{
-		if (it->first == drawable)
+		GridCell& cell = cellIt->second;
+		for (size_t i=0; i<cell.size();)
 		{
-			mDrawables.erase(it);
-			break;
+			if (GetSlotDrawable(cell[i]).removed)
+			{
+				cell[i] = cell.back();
+				cell.pop_back();
+			}
+			else
+			{
+				++i;
+			}
 		}
+		if (cell.empty()) cellIt = mGridCells.erase(cellIt);
+		else ++cellIt;
+	}
+
+	for (SlotIndexVector::const_iterator it=mPendingRemovals.begin(); it!=mPendingRemovals.end(); ++it)
+	{
+		RemoveFromTransform(GetSlotDrawable(*it));
 	}
+
+	// compact the drawables
+	uint32 kept = 0;
+	for (uint32 i=0; i<mDrawables.size(); ++i)
+	{
+		if (mDrawables[i].removed) continue;
+		if (kept != i) mDrawables[kept] = mDrawables[i];
+		mSlots[mDrawables[kept].slot].index = kept;
+		++kept;
+	}
+	mDrawables.resize(kept);
+
+	for (SlotIndexVector::const_iterator it=mPendingRemovals.begin(); it!=mPendingRemovals.end(); ++it)
+	{
+		FreeSlot(*it);
+	}
+	mPendingRemovals.clear();
+}
+
+void GfxSceneMgr::UpdateDrawable(const DrawableHandle handle)
+{
+	DrawableInfo* info = GetDrawable(handle);
+	if (!info || info->removed) return;
+	RefreshDrawable(*info);
 }
 
-void GfxSceneMgr::DrawVisibleDrawables()
+void GfxSceneMgr::MarkTransformDirty(const EntitySystem::Component* transform)
 {
-	for(DrawableVector::iterator it = mDrawables.begin(); it != mDrawables.end(); ++it)
+	SDL_mutexP(mDirtyTransformsMutex);
+	if (!mAllTransformsDirty)
 	{
-		EntityComponents::Transform* transform = (EntityComponents::Transform*)it->second;
-		if (!gLayerMgr.IsLayerVisible(transform->GetLayer()))
-			continue;
-		const EntitySystem::Component* drawable = it->first; 
-		EntitySystem::eComponentType type = drawable->GetType();
+		// if there are too many changes we rather refresh all drawables at once
+		if (mDirtyTransforms.size() >= mDrawables.size())
+		{
+			mAllTransformsDirty = true;
+			mDirtyTransforms.clear();
+		}
+		else
+		{
+			mDirtyTransforms.push_back(transform);
+		}
+	}
+	SDL_mutexV(mDirtyTransformsMutex);
+}
+
+void GfxSceneMgr::ProcessDirtyTransforms()
+{
+	OC_ASSERT_MSG(mBatchRemovalDepth == 0, "Drawables can't be updated while removing them in a batch");
 
-		switch (type)
+	if (mAllTransformsDirty)
+	{
+		for (DrawableVector::iterator it=mDrawables.begin(); it!=mDrawables.end(); ++it)
 		{
-		case CT_Sprite:
-			gGfxRenderer.DrawSprite(drawable, transform);
-			break;
-			
-		case CT_Model:
-			gGfxRenderer.DrawModel(drawable, transform);
-			break;
-		default:
-			break;
+			RefreshDrawable(*it);
 		}
+		mAllTransformsDirty = false;
+		return;
+	}
 
+	for (ComponentVector::const_iterator it=mDirtyTransforms.begin(); it!=mDirtyTransforms.end(); ++it)
+	{
+		TransformDrawablesMap::const_iterator transformIt = mTransformDrawables.find(*it);
+		if (transformIt == mTransformDrawables.end()) continue;
+
+		const SlotIndexVector& transformDrawables = transformIt->second;
+		for (SlotIndexVector::const_iterator slotIt=transformDrawables.begin(); slotIt!=transformDrawables.end(); ++slotIt)
+		{
+			RefreshDrawable(GetSlotDrawable(*slotIt));
+		}
 	}
-}
\ No newline at end of file
+	mDirtyTransforms.clear();
+}
+
+void GfxSceneMgr::RefreshDrawable(DrawableInfo& info)
+{
+	info.position = ((EntityComponents::Transform*)info.transform)->GetPosition();
+	info.radius = CalculateDrawableRadius(info);
+	mMaxDrawableRadius = MathUtils::Max(mMaxDrawableRadius, info.radius);
+
+	GridCellKey cell = GetCellKey(info.position);
+	if (cell != info.cell)
+	{
+		RemoveFromGrid(info);
+		info.cell = cell;
+		mGridCells[cell].push_back(info.slot);
+	}
+}
+
+float32 GfxSceneMgr::CalculateDrawableRadius(const DrawableInfo& info) const
+{
+	Vector2 scale = ((EntityComponents::Transform*)info.transform)->GetScale();
+
+	switch (info.drawable->GetType())
+	{
+	case CT_Sprite:
+		{
+			EntityComponents::Sprite* sprite = (EntityComponents::Sprite*)info.drawable;
+			Vector2 size;
+			if (!sprite->GetFrameSize().IsZero())
+			{
+				size.Set((float32)sprite->GetFrameSize().x, (float32)sprite->GetFrameSize().y);
+			}
+			else
+			{
+				TexturePtr tex = (TexturePtr)sprite->GetTexture();
+				if (!tex) return 0.0f;
+				size.Set((float32)tex->GetWidth(), (float32)tex->GetHeight());
+			}
+			Vector2 halfSize(0.5f * size.x * scale.x, 0.5f * size.y * scale.y);
+			return halfSize.Length() / GfxRenderer::PIXELS_PER_WORLD_UNIT;
+		}
+	case CT_Model:
+		{
+			EntityComponents::Model* model = (EntityComponents::Model*)info.drawable;
+			MeshPtr mesh = (MeshPtr)model->GetMesh();
+			if (!mesh) return 0.0f;
+			ModelOBJ* objModel = (ModelOBJ*)mesh->GetMesh();
+			if (!objModel) return 0.0f;
+			return objModel->getRadius() * MathUtils::Max(scale.x, scale.y);
+		}
+	default:
+		return 0.0f;
+	}
+}
+
+void GfxSceneMgr::RemoveFromGrid(DrawableInfo& info)
+{
+	GridCellMap::iterator cellIt = mGridCells.find(info.cell);
+	OC_DASSERT(cellIt != mGridCells.end());
+
+	// the order of drawables in a cell does not matter
+	GridCell& cell = cellIt->second;
+	GridCell::iterator it = Containers::find(cell.begin(), cell.end(), info.slot);
+	OC_DASSERT(it != cell.end());
+	*it = cell.back();
+	cell.pop_back();
+
+	if (cell.empty()) mGridCells.erase(cellIt);
+}
+
+void GfxSceneMgr::DrawVisibleDrawables(const Vector2& worldMin, const Vector2& worldMax)
+{
+	ProcessDirtyTransforms();
+
+	// drawables are indexed by their centers, so the searched area must be extended by their maximum size
+	int32 minX = MathUtils::Floor((worldMin.x - mMaxDrawableRadius) / GRID_CELL_SIZE);
+	int32 minY = MathUtils::Floor((worldMin.y - mMaxDrawableRadius) / GRID_CELL_SIZE);
+	int32 maxX = MathUtils::Floor((worldMax.x + mMaxDrawableRadius) / GRID_CELL_SIZE);
+	int32 maxY = MathUtils::Floor((worldMax.y + mMaxDrawableRadius) / GRID_CELL_SIZE);
+
+	if ((float32)(maxX - minX + 1) * (float32)(maxY - minY + 1) > (float32)mGridCells.size())
+	{
+		// there are more cells in the view than the occupied ones, so walk the occupied cells instead
+		for (GridCellMap::const_iterator cellIt=mGridCells.begin(); cellIt!=mGridCells.end(); ++cellIt)
+		{
+			int32 x = (int32)(uint32)(cellIt->first >> 32);
+			int32 y = (int32)(uint32)(cellIt->first);
+			if (x < minX || x > maxX || y < minY || y > maxY) continue;
+
+			for (GridCell::const_iterator it=cellIt->second.begin(); it!=cellIt->second.end(); ++it)
+			{
+				CollectIfVisible(GetSlotDrawable(*it), worldMin, worldMax);
+			}
+		}
+	}
+	else
+	{
+		for (int32 x=minX; x<=maxX; ++x)
+		{
+			for (int32 y=minY; y<=maxY; ++y)
+			{
+				GridCellMap::const_iterator cellIt = mGridCells.find(GetCellKey(x, y));
+				if (cellIt == mGridCells.end()) continue;
+
+				for (GridCell::const_iterator it=cellIt->second.begin(); it!=cellIt->second.end(); ++it)
+				{
+					CollectIfVisible(GetSlotDrawable(*it), worldMin, worldMax);
+				}
+			}
+		}
+	}
+
+	// the order of the drawables in the grid changes as they move, so they are drawn in a stable order instead;
+	// the drawables of a layer then also follow each other, so the renderer can batch them
+	Containers::sort(mVisibleDrawables.begin(), mVisibleDrawables.end());
+	for (VisibleDrawableVector::const_iterator it=mVisibleDrawables.begin(); it!=mVisibleDrawables.end(); ++it)
+	{
+		DrawDrawable(*it->info);
+	}
+	mVisibleDrawables.clear();
+}
+
+void GfxSceneMgr::CollectIfVisible(const DrawableInfo& info, const Vector2& worldMin, const Vector2& worldMax)
+{
+	if (info.position.x + info.radius < worldMin.x || info.position.x - info.radius > worldMax.x
+		|| info.position.y + info.radius < worldMin.y || info.position.y - info.radius > worldMax.y)
+		return;
+
+	EntityComponents::Transform* transform = (EntityComponents::Transform*)info.transform;
+	if (!gLayerMgr.IsLayerVisible(transform->GetLayer()))
+		return;
+
+	VisibleDrawable visible;
+	visible.layer = transform->GetLayer();
+	visible.sequence = info.sequence;
+	visible.info = &info;
+	mVisibleDrawables.push_back(visible);
+}
+
+void GfxSceneMgr::DrawDrawable(const DrawableInfo& info) const
+{
+	EntityComponents::Transform* transform = (EntityComponents::Transform*)info.transform;
+	switch (info.drawable->GetType())
+	{
+	case CT_Sprite:
+		gGfxRenderer.DrawSprite(info.drawable, transform);
+		break;
+
+	case CT_Model:
+		gGfxRenderer.DrawModel(info.drawable, transform);
+		break;
+	default:
+		break;
+	}
+}
+
+GfxSceneMgr::GridCellKey GfxSceneMgr::GetCellKey(const Vector2& position)
+{
+	return GetCellKey(MathUtils::Floor(position.x / GRID_CELL_SIZE), MathUtils::Floor(position.y / GRID_CELL_SIZE));
+}
+
+GfxSceneMgr::GridCellKey GfxSceneMgr::GetCellKey(const int32 x, const int32 y)
+{
+	return ((GridCellKey)(uint32)x << 32) | (GridCellKey)(uint32)y;
+}
@@ -8,9 +8,16 @@
 #include "Singleton.h"
 #include "GfxStructures.h"
 
+struct SDL_mutex;
+
 namespace GfxSystem
 {
 	/// Manages objects in the game which have a visual representation. The purpose is to speed the rendering up.
+	/// @remarks
+	/// The drawables are kept in a loose uniform grid indexed by their positions, so only the drawables near
+	/// the rendered part of the world are visited while drawing. Transforms notify the manager when they move.
+	/// The drawables themselves are stored densely and referenced by handles of stable slots. The visible drawables
+	/// are drawn ordered by their layers and then by the order they were added in, no matter where they are in the grid.
 	class GfxSceneMgr
 	{
 	public:
@@ -20,21 +27,134 @@ namespace GfxSystem
 
 		/// Default destructor.
 		virtual ~GfxSceneMgr(void);
-		
-		/// Adds a drawable component to the manager.
-		void AddDrawable(const EntitySystem::Component* sprite, const EntitySystem::Component* transform);
-
-		/// Removes a drawable component from the manager.
-		void RemoveDrawable(const EntitySystem::Component* sprite);
-		
-		/// Renders all visible drawable components.
-		void DrawVisibleDrawables();
-
-	private:	
-		typedef pair<const EntitySystem::Component*, const EntitySystem::Component*> DrawablePair;
-		typedef vector<DrawablePair> DrawableVector;
+
+		/// Adds a drawable component to the manager. Returns a handle used to refer to the drawable later.
+		DrawableHandle AddDrawable(const EntitySystem::Component* drawable, const EntitySystem::Component* transform);
+
+		/// Removes a drawable from the manager. Invalid or already removed handles are ignored.
+		void RemoveDrawable(const DrawableHandle handle);
+
+		/// Starts removing drawables in a batch. The removed drawables are only marked and all of them are
+		/// thrown away at once in EndBatchRemoval. Use this when destroying a lot of drawables at once.
+		/// @remarks The calls can be nested. No drawing can be done during the batch.
+		void BeginBatchRemoval(void);
+
+		/// Finishes removing drawables in a batch.
+		void EndBatchRemoval(void);
+
+		/// Recomputes the bounds of a drawable. Must be called when the size of the drawable changes.
+		void UpdateDrawable(const DrawableHandle handle);
+
+		/// Returns the number of drawables in the manager.
+		inline uint32 GetDrawablesCount(void) const { return mDrawables.size() - mPendingRemovals.size(); }
+
+		/// Tells the manager that the transform has moved, so the drawables using it must be moved in the index.
+		/// @remarks This can be called from more threads at once, as transforms are moved by parallel message handlers.
+		void MarkTransformDirty(const EntitySystem::Component* transform);
+
+		/// Renders all visible drawable components intersecting the given rectangle in world coordinates.
+		void DrawVisibleDrawables(const Vector2& worldMin, const Vector2& worldMax);
+
+	private:
+
+		typedef uint64 GridCellKey;
+
+		typedef uint32 SlotIndex;
+
+		/// Drawable component with its bounds cached for the spatial index.
+		struct DrawableInfo
+		{
+			const EntitySystem::Component* drawable;
+			const EntitySystem::Component* transform;
+			Vector2 position;
+			float32 radius;
+			GridCellKey cell;
+			SlotIndex slot;
+			uint32 sequence; ///< Order in which the drawable was added.
+			bool removed;
+		};
+
+		/// Drawable found visible while drawing with the keys it's drawn in order by.
+		struct VisibleDrawable
+		{
+			int32 layer;
+			uint32 sequence;
+			const DrawableInfo* info;
+
+			inline bool operator<(const VisibleDrawable& rhs) const
+			{
+				if (layer != rhs.layer) return layer < rhs.layer;
+				return sequence < rhs.sequence;
+			}
+		};
+
+		/// Slot referenced by drawable handles. The generation is changed every time the slot is freed, so
+		/// handles to removed drawables are recognized.
+		struct DrawableSlot
+		{
+			uint32 index;
+			uint8 generation;
+		};
+
+		typedef vector<DrawableInfo> DrawableVector;
+		typedef vector<DrawableSlot> SlotVector;
+		typedef vector<SlotIndex> SlotIndexVector;
+		typedef vector<SlotIndex> GridCell;
+		typedef hash_map<GridCellKey, GridCell> GridCellMap;
+		typedef vector<const EntitySystem::Component*> ComponentVector;
+		typedef hash_map<const EntitySystem::Component*, SlotIndexVector> TransformDrawablesMap;
+		typedef vector<VisibleDrawable> VisibleDrawableVector;
+
 		DrawableVector mDrawables;
+		SlotVector mSlots;
+		SlotIndexVector mFreeSlots;
+		SlotIndexVector mPendingRemovals;
+		int32 mBatchRemovalDepth;
+		GridCellMap mGridCells;
+		TransformDrawablesMap mTransformDrawables;
+		ComponentVector mDirtyTransforms;
+		bool mAllTransformsDirty;
+		SDL_mutex* mDirtyTransformsMutex;
+		float32 mMaxDrawableRadius;
+		uint32 mNextDrawableSequence;
+		VisibleDrawableVector mVisibleDrawables;
+
+		/// Returns the drawable referenced by the handle or null if the handle is not valid.
+		DrawableInfo* GetDrawable(const DrawableHandle handle);
+
+		/// Returns the drawable stored in the slot.
+		inline DrawableInfo& GetSlotDrawable(const SlotIndex slot) { return mDrawables[mSlots[slot].index]; }
+
+		/// Marks the slot as free, so it can be reused and its handles are no longer valid.
+		void FreeSlot(const SlotIndex slot);
+
+		/// Removes the slot from the list of drawables of the transform.
+		void RemoveFromTransform(const DrawableInfo& info);
+
+		/// Moves the drawables of all dirty transforms to the right cells.
+		void ProcessDirtyTransforms(void);
+
+		/// Recomputes the bounds of the drawable and moves it to the right cell.
+		void RefreshDrawable(DrawableInfo& info);
+
+		/// Computes the radius of the circle enclosing the drawable.
+		float32 CalculateDrawableRadius(const DrawableInfo& info) const;
+
+		/// Removes the drawable from its cell.
+		void RemoveFromGrid(DrawableInfo& info);
+
+		/// Adds the drawable to the visible ones if it intersects the given rectangle.
+		void CollectIfVisible(const DrawableInfo& info, const Vector2& worldMin, const Vector2& worldMax);
+
+		/// Draws the drawable.
+		void DrawDrawable(const DrawableInfo& info) const;
+
+		/// Returns the key of the cell containing the given position.
+		static GridCellKey GetCellKey(const Vector2& position);
+
+		/// Returns the key of the cell with the given coordinates.
+		static GridCellKey GetCellKey(const int32 x, const int32 y);
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
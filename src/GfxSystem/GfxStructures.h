@@ -17,6 +17,12 @@ namespace GfxSystem
 	/// Invalid texture handle.
 	const TextureHandle InvalidTextureHandle = 0;
 
+	/// Handle to a drawable registered in the scene manager.
+	typedef uint32 DrawableHandle;
+
+	/// Invalid drawable handle.
+	const DrawableHandle InvalidDrawableHandle = 0;
+
 	/// Texture pixel format
 	enum ePixelFormat
 	{
@@ -2,92 +2,192 @@
 #include "Mesh.h"
 #include "Core/Application.h"
 #include "DataContainer.h"
+#include "ResourceSystem/BinaryInput.h"
+#include "ResourceSystem/BinaryOutput.h"
 #include "objloader/model_obj.h"
+#include <boost/filesystem.hpp>
 
 using namespace GfxSystem;
 
-Mesh::Mesh( void ): mModel(0) {}
+/// Identifier at the beginning of the mesh cache files.
+const uint32 MESH_CACHE_MAGIC = 0x4853454d;
 
-Mesh::~Mesh( void ) {}
+/// Version of the format of the mesh cache files. Increase it when the format or the processing of the imported
+/// models changes.
+const uint32 MESH_CACHE_VERSION = 1;
+
+Mesh::Mesh( void ): mModel(0), mPreparedModel(0), mPreparedDataSize(0) {}
+
+Mesh::~Mesh( void )
+{
+	DiscardPreparedData();
+}
 
 ResourceSystem::ResourcePtr Mesh::CreateMe()
 {
 	return ResourceSystem::ResourcePtr(new Mesh());
 }
 
-bool Mesh::LoadModelFromFilePath(const char* path)
+ModelOBJ* Mesh::ImportModel( const char* data, const size_t size )
+{
+	ModelOBJ* model = new ModelOBJ();
+	if (!model->import(data, size) || model->getNumberOfVertices() == 0)
+	{
+		delete model;
+		return 0;
+	}
+	model->normalize();
+	return model;
+}
+
+string Mesh::GetCachePath() const
+{
+	// the name is not unique across projects, so the cache remembers the source path and it's rewritten on mismatch
+	string cacheName = GetName();
+	for (string::iterator it=cacheName.begin(); it!=cacheName.end(); ++it)
+	{
+		if (!isalnum((uint8)*it) && *it != '.') *it = '_';
+	}
+	boost::filesystem::path cachePath = gApp.GetTempDirectory();
+	cachePath /= "MeshCache";
+	cachePath /= cacheName + ".bin";
+	return cachePath.string();
+}
+
+ModelOBJ* Mesh::LoadModelFromCache( const string& cachePath, const int64 sourceTime, const uint32 sourceSize )
+{
+	// the cache file is mapped and the buffers are copied from it without any parsing
+	DataContainer dc;
+	if (!MapRawInputData(cachePath, dc)) return 0;
+
+	ResourceSystem::BinaryInput input(dc.GetData(), dc.GetSize());
+	ModelOBJ* model = 0;
+	if (input.Read<uint32>() == MESH_CACHE_MAGIC && input.Read<uint32>() == MESH_CACHE_VERSION
+		&& input.ReadString() == GetFilePath() && input.Read<int64>() == sourceTime && input.Read<uint32>() == sourceSize
+		&& !input.HasFailed())
+	{
+		model = new ModelOBJ();
+		if (!model->readBinary(input))
+		{
+			ocWarning << "Mesh cache file '" << cachePath << "' is corrupted";
+			delete model;
+			model = 0;
+		}
+	}
+	dc.Release();
+	return model;
+}
+
+void Mesh::SaveModelToCache( const ModelOBJ* model, const string& cachePath, const int64 sourceTime, const uint32 sourceSize ) const
+{
+	try
+	{
+		boost::filesystem::create_directories(boost::filesystem::path(cachePath).parent_path());
+	}
+	catch (const boost::filesystem::filesystem_error& e)
+	{
+		ocWarning << "Can't create mesh cache directory: " << e.what();
+		return;
+	}
+
+	ResourceSystem::BinaryOutput output;
+	output.Write(MESH_CACHE_MAGIC);
+	output.Write(MESH_CACHE_VERSION);
+	output.WriteString(GetFilePath());
+	output.Write(sourceTime);
+	output.Write(sourceSize);
+	model->writeBinary(output);
+	if (!output.SaveToFile(cachePath)) ocWarning << "Can't write mesh cache file '" << cachePath << "'";
+}
+
+void Mesh::PrepareImpl()
 {
-	if (mModel->import(path))
+	OC_ASSERT(!mPreparedModel);
+	mPreparedDataSize = 0;
+
+	// the cache is valid only for the version of the source file it was created from
+	int64 sourceTime = 0;
+	uint32 sourceSize = 0;
+	bool sourceExists = true;
+	try
+	{
+		sourceTime = boost::filesystem::last_write_time(GetFilePath());
+		sourceSize = (uint32)boost::filesystem::file_size(GetFilePath());
+	}
+	catch (const boost::filesystem::filesystem_error&) { sourceExists = false; }
+
+	const string cachePath = GetCachePath();
+	if (sourceExists)
 	{
-		if (mModel->getNumberOfVertices() == 0)
+		mPreparedModel = LoadModelFromCache(cachePath, sourceTime, sourceSize);
+		if (mPreparedModel)
 		{
-			return false;
+			mPreparedDataSize = sourceSize;
+			return;
 		}
-		else
+	}
+
+	// the OBJ data is parsed right from the memory
+	DataContainer dc;
+	if (MapRawInputData(dc))
+	{
+		mPreparedModel = ImportModel((const char*)dc.GetData(), dc.GetSize());
+		mPreparedDataSize = dc.GetSize();
+		dc.Release();
+		if (mPreparedModel && sourceExists) SaveModelToCache(mPreparedModel, cachePath, sourceTime, sourceSize);
+	}
+}
+
+void Mesh::DiscardPreparedData()
+{
+	if (mPreparedModel)
+	{
+		delete mPreparedModel;
+		mPreparedModel = 0;
+	}
+}
+
+void Mesh::AddModelTextures()
+{
+	// create textures for the meshes
+	string fileDir = GetRelativeFileDir();
+	for (int i=0; i<mModel->getNumberOfMaterials(); ++i)
+	{
+		ModelOBJ::Material* objMaterial = &mModel->getMaterial(i);
+		if (!objMaterial->colorMapFilename.empty())
 		{
-			mModel->normalize();
-
-			// create textures for the meshes
-			for (int i=0; i<mModel->getNumberOfMaterials(); ++i)
-			{
-				ModelOBJ::Material* objMaterial = &mModel->getMaterial(i);
-				if (!objMaterial->colorMapFilename.empty())
-				{
-					boost::filesystem::path filePath(path);
-					string fileDir = GetRelativeFileDir();
-
-					objMaterial->colorMapFilename = fileDir + objMaterial->colorMapFilename;
-					gResourceMgr.AddResourceFileToGroup(objMaterial->colorMapFilename, "MeshTextures", ResourceSystem::RESTYPE_TEXTURE, GetBasePathType());
-				}
-			}
+			objMaterial->colorMapFilename = fileDir + objMaterial->colorMapFilename;
+			gResourceMgr.AddResourceFileToGroup(objMaterial->colorMapFilename, "MeshTextures", ResourceSystem::RESTYPE_TEXTURE, GetBasePathType());
 		}
-		return true;
 	}
-	else
-		return false;
-		
 }
 
 size_t Mesh::LoadImpl()
 {
-	DataContainer dc;
-	GetRawInputData(dc);
-	size_t dataSize = dc.GetSize();
-
-	// this is not very nice but it's the fastest way to make OBJ loading working
-	string tmpFilePath = gApp.GetTempDirectory() + "/model.tmp";
-	boost::filesystem::ofstream* ofs = new boost::filesystem::ofstream(tmpFilePath, std::ios_base::out | std::ios_base::binary);
-	ofs->write((char*)dc.GetData(), dc.GetSize());
-	ofs->close();
-	dc.Release();
+	size_t dataSize = mPreparedDataSize;
+	mModel = mPreparedModel;
+	mPreparedModel = 0;
 
-	mModel = new ModelOBJ();
-	if (!LoadModelFromFilePath(tmpFilePath.c_str()))
+	if (!mModel)
 	{
-		delete mModel;
-
 		ocWarning << "Model '" << GetName() << "' cannot be loaded. Loading NullModel instead!";
 
 		ResourceSystem::ResourcePtr nullModHandle = gResourceMgr.GetResource("General", ResourceSystem::RES_NULL_MODEL);
 		string filePath = nullModHandle->GetFilePath();
 
-		// used only for determining size of data
-		GetRawInputData(filePath, dc);
+		DataContainer dc;
+		if (MapRawInputData(filePath, dc)) mModel = ImportModel((const char*)dc.GetData(), dc.GetSize());
 		dataSize = dc.GetSize();
 		dc.Release();
 
-		mModel = new ModelOBJ();
-		if (!LoadModelFromFilePath(filePath.c_str()))
+		if (!mModel)
 		{
 			ocError << "Cannot load NullModel!";
-			delete mModel;
-
-			mModel = NULL;
 			dataSize = 0;
 		}
 	}
 
-	boost::filesystem::remove(tmpFilePath);
+	if (mModel) AddModelTextures();
 
 	return dataSize;
 }
@@ -96,7 +196,8 @@ bool Mesh::UnloadImpl()
 {
 	if (mModel)
 	{
-		delete mModel;	
+		delete mModel;
+		mModel = 0;
 	}
 	return true;
 }
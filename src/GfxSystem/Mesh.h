@@ -31,15 +31,37 @@ namespace GfxSystem
 		/// Returns the resource type associated with this class.
 		static ResourceSystem::eResourceType GetResourceType() { return ResourceSystem::RESTYPE_MESH; }
 
+		/// The model is parsed or restored from the cache in PrepareImpl.
+		virtual bool IsPreparable(void) const { return true; }
+
 	protected:
 
+		virtual void PrepareImpl(void);
+		virtual void DiscardPreparedData(void);
 		virtual size_t LoadImpl(void);
 		virtual bool UnloadImpl(void);
 
 	private:
-		bool LoadModelFromFilePath(const char* path);
+
+		/// Parses the model from the OBJ data in memory and normalizes it. Returns null if the data is not a valid model.
+		static ModelOBJ* ImportModel(const char* data, const size_t size);
+
+		/// Returns the path of the file the imported model is cached in.
+		string GetCachePath(void) const;
+
+		/// Restores the model from the cache if the cache was created from the same version of the source file.
+		/// Returns null otherwise.
+		ModelOBJ* LoadModelFromCache(const string& cachePath, const int64 sourceTime, const uint32 sourceSize);
+
+		/// Saves the imported model to the cache, so it doesn't have to be parsed next time.
+		void SaveModelToCache(const ModelOBJ* model, const string& cachePath, const int64 sourceTime, const uint32 sourceSize) const;
+
+		/// Adds the textures used by the materials of the model to the resource manager.
+		void AddModelTextures(void);
 
 		ModelOBJ* mModel;
+		ModelOBJ* mPreparedModel;
+		size_t mPreparedDataSize;
 	};
 }
 
@@ -0,0 +1,129 @@
+#include "Common.h"
+#include "NullRenderer.h"
+#include "SOIL.h"
+#include "stb_image_aug.h"
+#include "SDL/SDL_mutex.h"
+
+using namespace GfxSystem;
+
+void NullRenderer::Init()
+{
+	ocInfo << "*** Null renderer init ***";
+}
+
+void NullRenderer::SetCameraImpl( const Vector2& position, const float32 zoom, const float32 rotation ) const
+{
+	OC_UNUSED(position);
+	OC_UNUSED(zoom);
+	OC_UNUSED(rotation);
+}
+
+TextureHandle NullRenderer::LoadTexture( const uint8* const buffer, const int32 buffer_length, const ePixelFormat force_channels, 
+										const uint32 reuse_texture_ID, int32* width, int32* height ) const
+{
+	int32 channels = 0;
+	uint8* img = DecodeTextureImage(buffer, buffer_length, force_channels, width, height, &channels);
+	if (!img) return 0;
+	FreeTextureImage(img);
+	return GenerateTextureHandle(reuse_texture_ID);
+}
+
+uint8* NullRenderer::DecodeTextureImage( const uint8* const buffer, const int32 buffer_length, const ePixelFormat force_channels,
+										int32* width, int32* height, int32* channels ) const
+{
+	// the size of the textures is used by the game, so the images must be decoded anyway
+	// the decoder is called directly, as SOIL would set its global result on every call from the loading threads
+	uint8* img = stbi_load_from_memory(buffer, buffer_length, (int*)width, (int*)height, (int*)channels, force_channels);
+	string loadResult;
+	if (!img)
+	{
+		SDL_mutexP(mImageLibraryMutex);
+		loadResult = stbi_failure_reason();
+		SDL_mutexV(mImageLibraryMutex);
+	}
+	if (!img)
+	{
+		ocError << "Image decoding error: " << loadResult;
+		*width = *height = 0;
+		return 0;
+	}
+	if ((force_channels >= 1) && (force_channels <= 4))
+	{
+		*channels = force_channels;
+	}
+	return img;
+}
+
+void NullRenderer::FreeTextureImage( uint8* pixels ) const
+{
+	stbi_image_free(pixels);
+}
+
+TextureHandle NullRenderer::CreateTexture( const uint8* const pixels, const int32 width, const int32 height, const int32 channels,
+										  const uint32 reuse_texture_ID ) const
+{
+	OC_UNUSED(pixels);
+	OC_UNUSED(width);
+	OC_UNUSED(height);
+	OC_UNUSED(channels);
+	return GenerateTextureHandle(reuse_texture_ID);
+}
+
+TextureHandle NullRenderer::CreateRenderTexture( const uint32 width, const uint32 height ) const
+{
+	OC_UNUSED(width);
+	OC_UNUSED(height);
+	return GenerateTextureHandle(0);
+}
+
+void NullRenderer::DrawLine( const Vector2& a, const Vector2& b, const Color& color, const float32 width ) const
+{
+	OC_UNUSED(a);
+	OC_UNUSED(b);
+	OC_UNUSED(color);
+	OC_UNUSED(width);
+}
+
+void NullRenderer::DrawPolygon( const Vector2* verts, const int32 n, const Color& color, const bool fill, const float32 outlineWidth ) const
+{
+	OC_UNUSED(verts);
+	OC_UNUSED(n);
+	OC_UNUSED(color);
+	OC_UNUSED(fill);
+	OC_UNUSED(outlineWidth);
+}
+
+void NullRenderer::DrawCircle( const Vector2& position, const float32 radius, const Color& color, const bool fill ) const
+{
+	OC_UNUSED(position);
+	OC_UNUSED(radius);
+	OC_UNUSED(color);
+	OC_UNUSED(fill);
+}
+
+void NullRenderer::DrawRect( const Vector2& topleft, const Vector2& bottomright, const float32 rotation, const Color& color, const bool fill ) const
+{
+	OC_UNUSED(topleft);
+	OC_UNUSED(bottomright);
+	OC_UNUSED(rotation);
+	OC_UNUSED(color);
+	OC_UNUSED(fill);
+}
+
+void NullRenderer::ClearViewport( const GfxViewport& viewport, const Color& color ) const
+{
+	OC_UNUSED(viewport);
+	OC_UNUSED(color);
+}
+
+void NullRenderer::DrawTexturedQuads( const TexturedQuad* quads, const int32 count )
+{
+	OC_UNUSED(quads);
+	OC_UNUSED(count);
+}
+
+TextureHandle NullRenderer::GenerateTextureHandle( const uint32 reuse_texture_ID ) const
+{
+	if (reuse_texture_ID != 0) return reuse_texture_ID;
+	return ++mLastTextureHandle;
+}
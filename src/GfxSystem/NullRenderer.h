@@ -0,0 +1,81 @@
+/// @file
+/// Renderer which draws nothing.
+
+#ifndef _NULLRENDERER_H_
+#define _NULLRENDERER_H_
+
+#include "Base.h"
+#include "Singleton.h"
+#include "GfxRenderer.h"
+
+namespace GfxSystem
+{
+	/// Renderer which draws nothing. It's used when the application runs without a window.
+	/// @remarks
+	/// The rendering never begins, so nothing is drawn at all. Textures are decoded to get their size, but they are
+	/// represented only by unique handles.
+	class NullRenderer : public GfxRenderer
+	{
+	public:
+
+		NullRenderer(void): mLastTextureHandle(0) {}
+
+		virtual void Init();
+
+		virtual bool BeginRenderingImpl() const { return false; }
+
+		virtual void EndRenderingImpl() const {}
+
+		virtual void SetViewportImpl(const GfxViewport* viewport) { OC_UNUSED(viewport); }
+
+		virtual void SetCameraImpl(const Vector2& position, const float32 zoom, const float32 rotation) const;
+
+		virtual void FinalizeRenderTargetImpl() const {}
+
+		virtual void FlushGraphics() const {}
+
+		virtual TextureHandle LoadTexture(const uint8* const buffer, const int32 buffer_length, const ePixelFormat force_channels, 
+			const uint32 reuse_texture_ID, int32* width, int32* height) const;
+
+		virtual uint8* DecodeTextureImage(const uint8* const buffer, const int32 buffer_length, const ePixelFormat force_channels,
+			int32* width, int32* height, int32* channels) const;
+
+		virtual void FreeTextureImage(uint8* pixels) const;
+
+		virtual TextureHandle CreateTexture(const uint8* const pixels, const int32 width, const int32 height, const int32 channels,
+			const uint32 reuse_texture_ID) const;
+
+		virtual TextureHandle CreateRenderTexture(const uint32 width, const uint32 height) const;
+
+		virtual void DeleteTexture(const TextureHandle& handle) const { OC_UNUSED(handle); }
+
+		virtual void DrawTexturedQuad(const TexturedQuad& quad) const { OC_UNUSED(quad); }
+
+		virtual void DrawTexturedMesh(const TexturedMesh& mesh) const { OC_UNUSED(mesh); }
+
+		virtual void DrawLine(const Vector2& a, const Vector2& b, const Color& color, const float32 width = 1.0f) const;
+
+		virtual void DrawPolygon(const Vector2* verts, const int32 n, const Color& color, const bool fill, const float32 outlineWidth = 1.0f ) const;
+
+		virtual void DrawCircle(const Vector2& position, const float32 radius, const Color& color, const bool fill) const;
+
+		virtual void DrawRect(const Vector2& topleft, const Vector2& bottomright, const float32 rotation, const Color& color, const bool fill) const;
+
+		virtual void ClearScreen(const Color& color) const { OC_UNUSED(color); }
+
+		virtual void ClearViewport(const GfxViewport& viewport, const Color& color) const;
+
+	protected:
+
+		virtual void DrawTexturedQuads(const TexturedQuad* quads, const int32 count);
+
+	private:
+
+		/// Returns a new unique texture handle or the reused one.
+		TextureHandle GenerateTextureHandle(const uint32 reuse_texture_ID) const;
+
+		mutable TextureHandle mLastTextureHandle;
+	};
+}
+
+#endif
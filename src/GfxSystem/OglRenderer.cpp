@@ -12,6 +12,7 @@
 #include "glew/GL/glew.h"
 #include "SDL/SDL.h"
 #include "SOIL.h"
+#include "stb_image_aug.h"
 
 using namespace GfxSystem;
 
@@ -177,28 +178,61 @@ GfxSystem::TextureHandle GfxSystem::OglRenderer::CreateRenderTexture( const uint
 TextureHandle OglRenderer::LoadTexture( const uint8* const buffer, const int32 buffer_length, const ePixelFormat force_channels, 
 									   const uint32 reuse_texture_ID, int32* width, int32* height ) const
 {
-	uint8* img;
-	int channels = 0;
-	img = SOIL_load_image_from_memory(buffer, buffer_length, (int*)width, (int*)height, &channels, force_channels);
+	int32 channels = 0;
+	uint8* img = DecodeTextureImage(buffer, buffer_length, force_channels, width, height, &channels);
 	if( NULL == img )
 	{
-		ocError << "SOIL error: " << SOIL_last_result();
+		return 0;
+	}
+
+	TextureHandle result = CreateTexture(img, *width, *height, channels, reuse_texture_ID);
+
+	FreeTextureImage( img );
+
+	if( 0 == result )
+	{
+		*width = *height = 0;
+	}
+	return result;
+}
+
+uint8* OglRenderer::DecodeTextureImage( const uint8* const buffer, const int32 buffer_length, const ePixelFormat force_channels,
+									   int32* width, int32* height, int32* channels ) const
+{
+	// the decoder is called directly, as SOIL would set its global result on every call from the loading threads
+	uint8* img = stbi_load_from_memory(buffer, buffer_length, (int*)width, (int*)height, (int*)channels, force_channels);
+	string loadResult;
+	if (!img)
+	{
+		SDL_mutexP(mImageLibraryMutex);
+		loadResult = stbi_failure_reason();
+		SDL_mutexV(mImageLibraryMutex);
+	}
+	if( NULL == img )
+	{
+		ocError << "Image decoding error: " << loadResult;
 		*width = *height = 0;
 		return 0;
 	}
 	if( (force_channels >= 1) && (force_channels <= 4) )
 	{
-		channels = force_channels;
+		*channels = force_channels;
 	}
+	return img;
+}
 
-	TextureHandle result = SOIL_create_OGL_texture(img, *width, *height, channels, reuse_texture_ID, 0);
-
-	SOIL_free_image_data( img );
+void OglRenderer::FreeTextureImage( uint8* pixels ) const
+{
+	stbi_image_free( pixels );
+}
 
+TextureHandle OglRenderer::CreateTexture( const uint8* const pixels, const int32 width, const int32 height, const int32 channels,
+										 const uint32 reuse_texture_ID ) const
+{
+	TextureHandle result = SOIL_create_OGL_texture(pixels, width, height, channels, reuse_texture_ID, 0);
 	if( 0 == result )
 	{
 		ocError << "SOIL loading error: " << SOIL_last_result();
-		*width = *height = 0;
 	}
 	return result;
 }
@@ -245,6 +279,76 @@ void OglRenderer::DrawTexturedQuad(const TexturedQuad& quad) const
 	glPopMatrix();
 }
 
+void GfxSystem::OglRenderer::DrawTexturedQuads( const TexturedQuad* quads, const int32 count )
+{
+	OC_ASSERT(quads);
+
+	// transform all quads into a single vertex array
+	mQuadVertices.resize(4 * count);
+	QuadVertex* vertex = &mQuadVertices[0];
+	for (int32 i=0; i<count; ++i)
+	{
+		const TexturedQuad& quad = quads[i];
+		float32 x = 0.5f * quad.size.x * quad.scale.x / PIXELS_PER_WORLD_UNIT;
+		float32 y = 0.5f * quad.size.y * quad.scale.y / PIXELS_PER_WORLD_UNIT;
+		float32 cosAngle = MathUtils::Cos(quad.angle);
+		float32 sinAngle = MathUtils::Sin(quad.angle);
+		// glColor clamps the value by itself, but the conversion to a byte must not overflow
+		uint8 alpha = (uint8)(255.0f * (1.0f - MathUtils::Clamp(quad.transparency, 0.0f, 1.0f)));
+
+		const float32 cornersX[4] = { -x, -x, x, x };
+		const float32 cornersY[4] = { y, -y, -y, y };
+		const float32 texCoordsU[4] = { quad.texOffset.x, quad.texOffset.x, quad.texOffset.x + quad.frameSize.x, quad.texOffset.x + quad.frameSize.x };
+		const float32 texCoordsV[4] = { quad.texOffset.y + quad.frameSize.y, quad.texOffset.y, quad.texOffset.y, quad.texOffset.y + quad.frameSize.y };
+
+		for (int32 j=0; j<4; ++j, ++vertex)
+		{
+			vertex->x = quad.position.x + cosAngle * cornersX[j] - sinAngle * cornersY[j];
+			vertex->y = quad.position.y + sinAngle * cornersX[j] + cosAngle * cornersY[j];
+			vertex->z = quad.z;
+			vertex->u = texCoordsU[j];
+			vertex->v = texCoordsV[j];
+			vertex->r = vertex->g = vertex->b = 255;
+			vertex->a = alpha;
+		}
+	}
+
+	// the current color is undefined after drawing with the color array, so it's restored afterwards
+	glPushAttrib(GL_CURRENT_BIT);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(3, GL_FLOAT, sizeof(QuadVertex), &mQuadVertices[0].x);
+	glTexCoordPointer(2, GL_FLOAT, sizeof(QuadVertex), &mQuadVertices[0].u);
+	glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(QuadVertex), &mQuadVertices[0].r);
+
+	// draw each run of quads with the same texture at once
+	int32 runStart = 0;
+	while (runStart < count)
+	{
+		int32 runEnd = runStart + 1;
+		while (runEnd < count && quads[runEnd].texture == quads[runStart].texture) ++runEnd;
+
+		glBindTexture(GL_TEXTURE_2D, quads[runStart].texture);
+
+		// Set texture wraping
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		// Disables texture filtering (filtering could cause artifacts at the edge between parts where Alpha=0 and Alpha=1)
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+		glDrawArrays(GL_QUADS, 4 * runStart, 4 * (runEnd - runStart));
+		runStart = runEnd;
+	}
+
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glPopAttrib();
+}
+
 void GfxSystem::OglRenderer::DrawTexturedMesh( const TexturedMesh& mesh ) const
 {
 	glPushMatrix();
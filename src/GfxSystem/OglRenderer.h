@@ -32,6 +32,14 @@ namespace GfxSystem
 		virtual TextureHandle LoadTexture(const uint8* const buffer, const int32 buffer_length, const ePixelFormat force_channels, 
 			const uint32 reuse_texture_ID, int32* width, int32* height) const;
 
+		virtual uint8* DecodeTextureImage(const uint8* const buffer, const int32 buffer_length, const ePixelFormat force_channels,
+			int32* width, int32* height, int32* channels) const;
+
+		virtual void FreeTextureImage(uint8* pixels) const;
+
+		virtual TextureHandle CreateTexture(const uint8* const pixels, const int32 width, const int32 height, const int32 channels,
+			const uint32 reuse_texture_ID) const;
+
 		virtual TextureHandle CreateRenderTexture(const uint32 width, const uint32 height) const;
 
 		virtual void DeleteTexture(const TextureHandle& handle) const;
@@ -52,13 +60,26 @@ namespace GfxSystem
 
 		virtual void ClearViewport(const GfxViewport& viewport, const Color& color) const;
 
+	protected:
+
+		virtual void DrawTexturedQuads(const TexturedQuad* quads, const int32 count);
 
 	private:
 
 		typedef unsigned int OpenGLHandle;
 
+		/// Vertex of a quad in the interleaved vertex array.
+		struct QuadVertex
+		{
+			float32 x, y, z;
+			float32 u, v;
+			uint8 r, g, b, a;
+		};
+		typedef vector<QuadVertex> QuadVertexVector;
+
 		const GfxViewport* mCurrentViewport;
 		OpenGLHandle mFrameBuffer;
+		QuadVertexVector mQuadVertices;
 	};
 }
 
@@ -4,9 +4,12 @@
 
 using namespace GfxSystem;
 
-Texture::Texture( void ): mHandle(0) {}
+Texture::Texture( void ): mHandle(0), mPreparedPixels(0), mPreparedDataSize(0) {}
 
-Texture::~Texture( void ) {}
+Texture::~Texture( void )
+{
+	DiscardPreparedData();
+}
 
 ResourceSystem::ResourcePtr Texture::CreateMe()
 {
@@ -18,25 +21,48 @@ void Texture::Init()
 	mHandle = 0;
 }
 
+void Texture::PrepareImpl()
+{
+	OC_ASSERT(!mPreparedPixels);
+	mPreparedDataSize = 0;
+
+	// get texture data; the file is only decoded, so it doesn't have to be copied to memory
+	DataContainer dc;
+	if (MapRawInputData(dc))
+	{
+		// decode it so that only the upload is left for the main thread
+		mPreparedPixels = gGfxRenderer.DecodeTextureImage((const unsigned char*)dc.GetData(), dc.GetSize(), PF_RGBA,
+			&mPreparedWidth, &mPreparedHeight, &mPreparedChannels);
+		mPreparedDataSize = dc.GetSize();
+		// we don't need the data buffer anymore
+		dc.Release();
+	}
+}
+
+void Texture::DiscardPreparedData()
+{
+	if (mPreparedPixels)
+	{
+		gGfxRenderer.FreeTextureImage(mPreparedPixels);
+		mPreparedPixels = 0;
+	}
+}
+
 size_t Texture::LoadImpl()
 {
 	mHandle = 0;
-	// get texture data
 	DataContainer dc;
 	
 	int32 width = 0, height = 0;
 	size_t dataSize = 0;
-	if (GetRawInputData(dc))
+	if (mPreparedPixels)
 	{
-		// load it to low-level renderer
-		mHandle = gGfxRenderer.LoadTexture((const unsigned char*)dc.GetData(),
-											dc.GetSize(),
-											PF_RGBA, 0,			//pixel format, reuse texture handle (0 = create new)
-											&width, &height);
-		
-		dataSize = dc.GetSize();
-		// we don't need the data buffer anymore
-		dc.Release();
+		// load the prepared image to low-level renderer
+		mHandle = gGfxRenderer.CreateTexture(mPreparedPixels, mPreparedWidth, mPreparedHeight, mPreparedChannels, 0);
+		width = mPreparedWidth;
+		height = mPreparedHeight;
+		dataSize = mPreparedDataSize;
+		DiscardPreparedData();
 	}
 
 	// if loading texture fails, load NullTexture instead
@@ -47,7 +73,7 @@ size_t Texture::LoadImpl()
 		ResourceSystem::ResourcePtr nullTexHandle = gResourceMgr.GetResource("General", ResourceSystem::RES_NULL_TEXTURE);
 		string filePath = nullTexHandle->GetFilePath();
 
-		if (!GetRawInputData(filePath, dc))
+		if (!MapRawInputData(filePath, dc))
 			ocError << "Cannot load NullTexture!";
 
 		mHandle = gGfxRenderer.LoadTexture((const unsigned char*)dc.GetData(),
@@ -35,10 +35,15 @@ namespace GfxSystem
 		/// Returns the resource type associated with this class.
 		static ResourceSystem::eResourceType GetResourceType() { return ResourceSystem::RESTYPE_TEXTURE; }
 
+		/// The image is read and decoded in PrepareImpl, so only the upload to the renderer is left for LoadImpl.
+		virtual bool IsPreparable(void) const { return true; }
+
 	protected:
 
 		friend class GfxRenderer;
 
+		virtual void PrepareImpl(void);
+		virtual void DiscardPreparedData(void);
 		virtual size_t LoadImpl(void);
 		virtual bool UnloadImpl(void);
 
@@ -47,6 +52,11 @@ namespace GfxSystem
 		ePixelFormat mFormat;
 		uint32 mHeight, mWidth;
 
+		/// Decoded image waiting for LoadImpl.
+		uint8* mPreparedPixels;
+		int32 mPreparedWidth, mPreparedHeight, mPreparedChannels;
+		size_t mPreparedDataSize;
+
 		void Init(void);
 	};
 }
@@ -38,11 +38,16 @@
 #include "Common.h"
 
 #include <algorithm>
+#include <cctype>
 #include <cmath>
+#include <cstdarg>
+#include <cstdlib>
 #include <cstring>
 #include <limits>
 #include <string>
 #include "model_obj.h"
+#include "ResourceSystem/BinaryInput.h"
+#include "ResourceSystem/BinaryOutput.h"
 
 namespace
 {
@@ -50,8 +55,202 @@ namespace
     {
         return lhs.pMaterial->alpha > rhs.pMaterial->alpha;
     }
+
+    bool isSpace(char c)
+    {
+        return isspace(static_cast<unsigned char>(c)) != 0;
+    }
+
+    bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    // Returns true if the input has enough data left for the given number of
+    // items, so that a corrupted count can't cause a huge allocation.
+    bool fitsInput(const ResourceSystem::BinaryInput &input, uint32 count, size_t itemSize)
+    {
+        return count <= (input.GetSize() - input.GetPosition()) / itemSize;
+    }
 }
 
+//-----------------------------------------------------------------------------
+// Reads the OBJ data from a buffer in memory. The methods mimic fscanf() and
+// fgets(), so the file is parsed the same way as before, but it's never
+// written to a temporary file nor read from the disk twice.
+//-----------------------------------------------------------------------------
+
+class ModelOBJ::Reader
+{
+public:
+    Reader(const char *pData, size_t size)
+        : m_pBegin(pData), m_pPos(pData), m_pEnd(pData + size) {}
+
+    void rewind()
+    {
+        m_pPos = m_pBegin;
+    }
+
+    // Like reader.scan("%s", pBuffer). Returns false at the end of data.
+    bool readWord(char *pBuffer, size_t bufferSize)
+    {
+        skipSpaces();
+
+        if (m_pPos == m_pEnd)
+            return false;
+
+        size_t length = 0;
+
+        while (m_pPos != m_pEnd && !isSpace(*m_pPos))
+        {
+            if (length + 1 < bufferSize)
+                pBuffer[length++] = *m_pPos;
+            ++m_pPos;
+        }
+
+        pBuffer[length] = '\0';
+        return true;
+    }
+
+    // Like fgets(). The rest of a line too long for the buffer is skipped.
+    void readLine(char *pBuffer, size_t bufferSize)
+    {
+        size_t length = 0;
+
+        while (m_pPos != m_pEnd)
+        {
+            char c = *m_pPos++;
+
+            if (length + 1 < bufferSize)
+                pBuffer[length++] = c;
+
+            if (c == '\n')
+                break;
+        }
+
+        pBuffer[length] = '\0';
+    }
+
+    // Like fscanf() limited to the %d and %f conversions. Returns the number
+    // of converted values or EOF if the data ends before the first one.
+    int scan(const char *pszFormat, ...)
+    {
+        va_list args;
+        va_start(args, pszFormat);
+
+        int converted = 0;
+
+        for (const char *pFormat = pszFormat; *pFormat; ++pFormat)
+        {
+            if (*pFormat == '%')
+            {
+                skipSpaces();
+
+                if (m_pPos == m_pEnd)
+                {
+                    if (converted == 0)
+                        converted = EOF;
+                    break;
+                }
+
+                bool ok = false;
+
+                switch (*++pFormat)
+                {
+                case 'd':
+                    ok = readInt(*va_arg(args, int *));
+                    break;
+
+                case 'f':
+                    ok = readFloat(*va_arg(args, float *));
+                    break;
+
+                default:
+                    break;
+                }
+
+                if (!ok)
+                    break;
+
+                ++converted;
+            }
+            else if (isSpace(*pFormat))
+            {
+                skipSpaces();
+            }
+            else if (m_pPos != m_pEnd && *m_pPos == *pFormat)
+            {
+                ++m_pPos;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        va_end(args);
+        return converted;
+    }
+
+private:
+    void skipSpaces()
+    {
+        while (m_pPos != m_pEnd && isSpace(*m_pPos))
+            ++m_pPos;
+    }
+
+    bool readInt(int &value)
+    {
+        const char *pPos = m_pPos;
+        bool negative = false;
+
+        if (pPos != m_pEnd && (*pPos == '-' || *pPos == '+'))
+            negative = (*pPos++ == '-');
+
+        if (pPos == m_pEnd || !isDigit(*pPos))
+            return false;
+
+        int result = 0;
+
+        while (pPos != m_pEnd && isDigit(*pPos))
+            result = result * 10 + (*pPos++ - '0');
+
+        value = negative ? -result : result;
+        m_pPos = pPos;
+        return true;
+    }
+
+    bool readFloat(float &value)
+    {
+        // strtod() needs a null terminated string, so the number is copied.
+        char number[64];
+        size_t length = 0;
+
+        while (m_pPos + length != m_pEnd && length + 1 < sizeof(number)
+            && m_pPos[length] != '\0' && strchr("+-.0123456789eE", m_pPos[length]))
+        {
+            number[length] = m_pPos[length];
+            ++length;
+        }
+
+        number[length] = '\0';
+
+        char *pNumberEnd = 0;
+        double result = strtod(number, &pNumberEnd);
+
+        if (pNumberEnd == number)
+            return false;
+
+        value = static_cast<float>(result);
+        m_pPos += pNumberEnd - number;
+        return true;
+    }
+
+    const char *m_pBegin;
+    const char *m_pPos;
+    const char *m_pEnd;
+};
+
 ModelOBJ::ModelOBJ()
 {
     m_hasPositions = false;
@@ -145,8 +344,6 @@ void ModelOBJ::destroy()
     m_center[0] = m_center[1] = m_center[2] = 0.0f;
     m_width = m_height = m_length = m_radius = 0.0f;
 
-    m_directoryPath.clear();
-
     m_meshes.clear();
     m_materials.clear();
     m_vertexBuffer.clear();
@@ -161,47 +358,17 @@ void ModelOBJ::destroy()
     m_vertexCache.clear();
 }
 
-bool ModelOBJ::import(const char *pszFilename, bool rebuildNormals)
+bool ModelOBJ::import(const char *pData, size_t size, bool rebuildNormals)
 {
-    FILE *pFile = fopen(pszFilename, "r");
-
-    if (!pFile)
-        return false;
-
-    // Extract the directory the OBJ file is in from the file name.
-    // This directory path will be used to load the OBJ's associated MTL file.
-
-//    m_directoryPath.clear();
-
-    std::string filename = pszFilename;
-    std::string::size_type offset = filename.find_last_of('\\');
-
-    if (offset != std::string::npos)
-    {
-        m_directoryPath = filename.substr(0, ++offset);
-    }
-    else
-    {
-        offset = filename.find_last_of('/');
-
-        if (offset != std::string::npos)
-            m_directoryPath = filename.substr(0, ++offset);
-    }
+    Reader reader(pData, size);
 
     // Import the OBJ file.
 
-    if (!importGeometryFirstPass(pFile))
-	{
-		fclose(pFile);
-		return false;
-	}
-    rewind(pFile);
-    if (!importGeometrySecondPass(pFile))
-	{
-		fclose(pFile);
-		return false;
-	}
-    fclose(pFile);
+    if (!importGeometryFirstPass(reader))
+        return false;
+    reader.rewind();
+    if (!importGeometrySecondPass(reader))
+        return false;
 
     // Perform post import tasks.
 
@@ -294,6 +461,175 @@ void ModelOBJ::reverseWinding()
     }
 }
 
+void ModelOBJ::writeBinary(ResourceSystem::BinaryOutput &output) const
+{
+    output.Write<uint8>(m_hasPositions);
+    output.Write<uint8>(m_hasTextureCoords);
+    output.Write<uint8>(m_hasNormals);
+    output.Write<uint8>(m_hasTangents);
+
+    output.WriteBytes(m_center, sizeof(m_center));
+    output.Write(m_width);
+    output.Write(m_height);
+    output.Write(m_length);
+    output.Write(m_radius);
+
+    output.Write<uint32>(m_materials.size());
+
+    for (int i = 0; i < static_cast<int>(m_materials.size()); ++i)
+    {
+        const Material &material = m_materials[i];
+
+        output.WriteBytes(material.ambient, sizeof(material.ambient));
+        output.WriteBytes(material.diffuse, sizeof(material.diffuse));
+        output.WriteBytes(material.specular, sizeof(material.specular));
+        output.Write(material.shininess);
+        output.Write(material.alpha);
+        output.WriteString(material.name);
+        output.WriteString(material.colorMapFilename);
+        output.WriteString(material.bumpMapFilename);
+    }
+
+    // Meshes refer to the materials by their indices.
+    output.Write<uint32>(m_meshes.size());
+
+    for (int i = 0; i < static_cast<int>(m_meshes.size()); ++i)
+    {
+        output.Write<int32>(m_meshes[i].startIndex);
+        output.Write<int32>(m_meshes[i].triangleCount);
+        output.Write<uint32>(m_meshes[i].pMaterial - &m_materials[0]);
+    }
+
+    // The vertex and index buffers are written as they are in memory.
+    output.Write<uint32>(m_vertexBuffer.size());
+
+    if (!m_vertexBuffer.empty())
+        output.WriteBytes(&m_vertexBuffer[0], m_vertexBuffer.size() * sizeof(Vertex));
+
+    output.Write<uint32>(m_indexBuffer.size());
+
+    if (!m_indexBuffer.empty())
+        output.WriteBytes(&m_indexBuffer[0], m_indexBuffer.size() * sizeof(int));
+}
+
+bool ModelOBJ::readBinary(ResourceSystem::BinaryInput &input)
+{
+    destroy();
+
+    m_hasPositions = input.Read<uint8>() != 0;
+    m_hasTextureCoords = input.Read<uint8>() != 0;
+    m_hasNormals = input.Read<uint8>() != 0;
+    m_hasTangents = input.Read<uint8>() != 0;
+
+    input.ReadBytes(m_center, sizeof(m_center));
+    m_width = input.Read<float>();
+    m_height = input.Read<float>();
+    m_length = input.Read<float>();
+    m_radius = input.Read<float>();
+
+    uint32 count = input.Read<uint32>();
+
+    if (!fitsInput(input, count, 1))
+    {
+        destroy();
+        return false;
+    }
+
+    m_materials.resize(count);
+
+    for (int i = 0; i < static_cast<int>(m_materials.size()); ++i)
+    {
+        Material &material = m_materials[i];
+
+        input.ReadBytes(material.ambient, sizeof(material.ambient));
+        input.ReadBytes(material.diffuse, sizeof(material.diffuse));
+        input.ReadBytes(material.specular, sizeof(material.specular));
+        material.shininess = input.Read<float>();
+        material.alpha = input.Read<float>();
+        material.name = input.ReadString();
+        material.colorMapFilename = input.ReadString();
+        material.bumpMapFilename = input.ReadString();
+
+        m_materialCache[material.name] = i;
+    }
+
+    count = input.Read<uint32>();
+
+    if (!fitsInput(input, count, 3 * sizeof(uint32)))
+    {
+        destroy();
+        return false;
+    }
+
+    m_meshes.resize(count);
+
+    for (int i = 0; i < static_cast<int>(m_meshes.size()); ++i)
+    {
+        m_meshes[i].startIndex = input.Read<int32>();
+        m_meshes[i].triangleCount = input.Read<int32>();
+
+        uint32 material = input.Read<uint32>();
+
+        if (material >= m_materials.size())
+        {
+            destroy();
+            return false;
+        }
+
+        m_meshes[i].pMaterial = &m_materials[material];
+    }
+
+    count = input.Read<uint32>();
+
+    if (!fitsInput(input, count, sizeof(Vertex)))
+    {
+        destroy();
+        return false;
+    }
+
+    m_vertexBuffer.resize(count);
+
+    if (count > 0)
+        input.ReadBytes(&m_vertexBuffer[0], count * sizeof(Vertex));
+
+    count = input.Read<uint32>();
+
+    if (!fitsInput(input, count, sizeof(int)))
+    {
+        destroy();
+        return false;
+    }
+
+    m_indexBuffer.resize(count);
+
+    if (count > 0)
+        input.ReadBytes(&m_indexBuffer[0], count * sizeof(int));
+
+    m_numberOfMaterials = static_cast<int>(m_materials.size());
+    m_numberOfMeshes = static_cast<int>(m_meshes.size());
+    m_numberOfTriangles = static_cast<int>(m_indexBuffer.size()) / 3;
+
+    // The buffers are passed to the renderer directly, so they must be
+    // consistent even if the data is corrupted.
+    bool valid = !input.HasFailed();
+
+    for (int i = 0; valid && i < m_numberOfMeshes; ++i)
+    {
+        valid = m_meshes[i].startIndex >= 0 && m_meshes[i].triangleCount >= 0
+            && m_meshes[i].triangleCount <= (m_numberOfTriangles * 3 - m_meshes[i].startIndex) / 3;
+    }
+
+    for (int i = 0; valid && i < static_cast<int>(m_indexBuffer.size()); ++i)
+    {
+        valid = m_indexBuffer[i] >= 0 && m_indexBuffer[i] < static_cast<int>(m_vertexBuffer.size());
+    }
+
+    if (!valid)
+        destroy();
+
+    return valid;
+}
+
 void ModelOBJ::scale(float scaleFactor, float offset[3])
 {
     float *pPosition = 0;
@@ -886,7 +1222,7 @@ void ModelOBJ::generateTangents()
     m_hasTangents = true;
 }
 
-bool ModelOBJ::importGeometryFirstPass(FILE *pFile)
+bool ModelOBJ::importGeometryFirstPass(Reader &reader)
 {
     m_hasTextureCoords = false;
     m_hasNormals = false;
@@ -900,9 +1236,8 @@ bool ModelOBJ::importGeometryFirstPass(FILE *pFile)
     int vt = 0;
     int vn = 0;
     char buffer[256] = {0};
-    std::string name;
 
-    while (fscanf(pFile, "%s", buffer) != EOF)
+    while (reader.readWord(buffer, sizeof(buffer)))
     {
         switch (buffer[0])
         {
@@ -910,43 +1245,43 @@ bool ModelOBJ::importGeometryFirstPass(FILE *pFile)
 			if (strcmp(buffer, "f") != 0)
 					return false;
 
-            fscanf(pFile, "%s", buffer);
+            reader.readWord(buffer, sizeof(buffer));
 
             if (strstr(buffer, "//")) // v//vn
             {
                 sscanf(buffer, "%d//%d", &v, &vn);
-                fscanf(pFile, "%d//%d", &v, &vn);
-                fscanf(pFile, "%d//%d", &v, &vn);
+                reader.scan("%d//%d", &v, &vn);
+                reader.scan("%d//%d", &v, &vn);
                 ++m_numberOfTriangles;
 
-                while (fscanf(pFile, "%d//%d", &v, &vn) > 0)
+                while (reader.scan("%d//%d", &v, &vn) > 0)
                     ++m_numberOfTriangles;
             }
             else if (sscanf(buffer, "%d/%d/%d", &v, &vt, &vn) == 3) // v/vt/vn
             {
-                fscanf(pFile, "%d/%d/%d", &v, &vt, &vn);
-                fscanf(pFile, "%d/%d/%d", &v, &vt, &vn);
+                reader.scan("%d/%d/%d", &v, &vt, &vn);
+                reader.scan("%d/%d/%d", &v, &vt, &vn);
                 ++m_numberOfTriangles;
 
-                while (fscanf(pFile, "%d/%d/%d", &v, &vt, &vn) > 0)
+                while (reader.scan("%d/%d/%d", &v, &vt, &vn) > 0)
                     ++m_numberOfTriangles;
             }
             else if (sscanf(buffer, "%d/%d", &v, &vt) == 2) // v/vt
             {
-                fscanf(pFile, "%d/%d", &v, &vt);
-                fscanf(pFile, "%d/%d", &v, &vt);
+                reader.scan("%d/%d", &v, &vt);
+                reader.scan("%d/%d", &v, &vt);
                 ++m_numberOfTriangles;
 
-                while (fscanf(pFile, "%d/%d", &v, &vt) > 0)
+                while (reader.scan("%d/%d", &v, &vt) > 0)
                     ++m_numberOfTriangles;
             }
             else // v
             {
-                fscanf(pFile, "%d", &v);
-                fscanf(pFile, "%d", &v);
+                reader.scan("%d", &v);
+                reader.scan("%d", &v);
                 ++m_numberOfTriangles;
 
-                while (fscanf(pFile, "%d", &v) > 0)
+                while (reader.scan("%d", &v) > 0)
                     ++m_numberOfTriangles;
             }
             break;
@@ -954,19 +1289,15 @@ bool ModelOBJ::importGeometryFirstPass(FILE *pFile)
         case 'm':   // mtllib
 			if (strcmp(buffer, "mtllib") != 0)
 				return false;
-            fgets(buffer, sizeof(buffer), pFile);
-			importMaterials(pFile);
-            /*sscanf(buffer, "%s %s", buffer, buffer);
-            name = m_directoryPath;
-            name += buffer;
-            importMaterials(name.c_str());*/
+            reader.readLine(buffer, sizeof(buffer));
+			importMaterials(reader);
             break;
 
         case 'v':   // v, vt, or vn
             switch (buffer[1])
             {
             case '\0':
-                fgets(buffer, sizeof(buffer), pFile);
+                reader.readLine(buffer, sizeof(buffer));
                 ++m_numberOfVertexCoords;
                 break;
 
@@ -974,7 +1305,7 @@ bool ModelOBJ::importGeometryFirstPass(FILE *pFile)
 				if (strcmp(buffer, "vn") != 0)
 					return false;
 
-                fgets(buffer, sizeof(buffer), pFile);
+                reader.readLine(buffer, sizeof(buffer));
                 ++m_numberOfNormals;
                 break;
 
@@ -982,7 +1313,7 @@ bool ModelOBJ::importGeometryFirstPass(FILE *pFile)
 				if (strcmp(buffer, "vt") != 0)
 					return false;
 
-                fgets(buffer, sizeof(buffer), pFile);
+                reader.readLine(buffer, sizeof(buffer));
                 ++m_numberOfTextureCoords;
 				break;
 
@@ -992,7 +1323,7 @@ bool ModelOBJ::importGeometryFirstPass(FILE *pFile)
             break;
 
         default:
-            fgets(buffer, sizeof(buffer), pFile);
+            reader.readLine(buffer, sizeof(buffer));
             break;
         }
     }
@@ -1029,7 +1360,7 @@ bool ModelOBJ::importGeometryFirstPass(FILE *pFile)
 	return true;
 }
 
-bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
+bool ModelOBJ::importGeometrySecondPass(Reader &reader)
 {
     int v[3] = {0};
     int vt[3] = {0};
@@ -1043,7 +1374,7 @@ bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
     std::string name;
     std::map<std::string, int>::const_iterator iter;
 
-    while (fscanf(pFile, "%s", buffer) != EOF)
+    while (reader.readWord(buffer, sizeof(buffer)))
     {
         switch (buffer[0])
         {
@@ -1052,13 +1383,13 @@ bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
             vt[0] = vt[1] = vt[2] = 0;
             vn[0] = vn[1] = vn[2] = 0;
 
-            fscanf(pFile, "%s", buffer);
+            reader.readWord(buffer, sizeof(buffer));
 
             if (strstr(buffer, "//")) // v//vn
             {
                 sscanf(buffer, "%d//%d", &v[0], &vn[0]);
-                fscanf(pFile, "%d//%d", &v[1], &vn[1]);
-                fscanf(pFile, "%d//%d", &v[2], &vn[2]);
+                reader.scan("%d//%d", &v[1], &vn[1]);
+                reader.scan("%d//%d", &v[2], &vn[2]);
 
                 v[0] = (v[0] < 0) ? v[0] + numVertices - 1 : v[0] - 1;
                 v[1] = (v[1] < 0) ? v[1] + numVertices - 1 : v[1] - 1;
@@ -1075,7 +1406,7 @@ bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
                 v[1] = v[2];
                 vn[1] = vn[2];
 
-                while (fscanf(pFile, "%d//%d", &v[2], &vn[2]) > 0)
+                while (reader.scan("%d//%d", &v[2], &vn[2]) > 0)
                 {
                     v[2] = (v[2] < 0) ? v[2] + numVertices - 1 : v[2] - 1;
                     vn[2] = (vn[2] < 0) ? vn[2] + numNormals - 1 : vn[2] - 1;
@@ -1090,8 +1421,8 @@ bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
             }
             else if (sscanf(buffer, "%d/%d/%d", &v[0], &vt[0], &vn[0]) == 3) // v/vt/vn
             {
-                fscanf(pFile, "%d/%d/%d", &v[1], &vt[1], &vn[1]);
-                fscanf(pFile, "%d/%d/%d", &v[2], &vt[2], &vn[2]);
+                reader.scan("%d/%d/%d", &v[1], &vt[1], &vn[1]);
+                reader.scan("%d/%d/%d", &v[2], &vt[2], &vn[2]);
 
                 v[0] = (v[0] < 0) ? v[0] + numVertices - 1 : v[0] - 1;
                 v[1] = (v[1] < 0) ? v[1] + numVertices - 1 : v[1] - 1;
@@ -1113,7 +1444,7 @@ bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
                 vt[1] = vt[2];
                 vn[1] = vn[2];
 
-                while (fscanf(pFile, "%d/%d/%d", &v[2], &vt[2], &vn[2]) > 0)
+                while (reader.scan("%d/%d/%d", &v[2], &vt[2], &vn[2]) > 0)
                 {
                     v[2] = (v[2] < 0) ? v[2] + numVertices - 1 : v[2] - 1;
                     vt[2] = (vt[2] < 0) ? vt[2] + numTexCoords - 1 : vt[2] - 1;
@@ -1130,8 +1461,8 @@ bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
             }
             else if (sscanf(buffer, "%d/%d", &v[0], &vt[0]) == 2) // v/vt
             {
-                fscanf(pFile, "%d/%d", &v[1], &vt[1]);
-                fscanf(pFile, "%d/%d", &v[2], &vt[2]);
+                reader.scan("%d/%d", &v[1], &vt[1]);
+                reader.scan("%d/%d", &v[2], &vt[2]);
 
                 v[0] = (v[0] < 0) ? v[0] + numVertices - 1 : v[0] - 1;
                 v[1] = (v[1] < 0) ? v[1] + numVertices - 1 : v[1] - 1;
@@ -1148,7 +1479,7 @@ bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
                 v[1] = v[2];
                 vt[1] = vt[2];
 
-                while (fscanf(pFile, "%d/%d", &v[2], &vt[2]) > 0)
+                while (reader.scan("%d/%d", &v[2], &vt[2]) > 0)
                 {
                     v[2] = (v[2] < 0) ? v[2] + numVertices - 1 : v[2] - 1;
                     vt[2] = (vt[2] < 0) ? vt[2] + numTexCoords - 1 : vt[2] - 1;
@@ -1164,8 +1495,8 @@ bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
             else // v
             {
                 sscanf(buffer, "%d", &v[0]);
-                fscanf(pFile, "%d", &v[1]);
-                fscanf(pFile, "%d", &v[2]);
+                reader.scan("%d", &v[1]);
+                reader.scan("%d", &v[2]);
 
                 v[0] = (v[0] < 0) ? v[0] + numVertices - 1 : v[0] - 1;
                 v[1] = (v[1] < 0) ? v[1] + numVertices - 1 : v[1] - 1;
@@ -1176,7 +1507,7 @@ bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
 
                 v[1] = v[2];
 
-                while (fscanf(pFile, "%d", &v[2]) > 0)
+                while (reader.scan("%d", &v[2]) > 0)
                 {
                     v[2] = (v[2] < 0) ? v[2] + numVertices - 1 : v[2] - 1;
 
@@ -1188,7 +1519,7 @@ bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
             break;
 
         case 'u': // usemtl
-            fgets(buffer, sizeof(buffer), pFile);
+            reader.readLine(buffer, sizeof(buffer));
             sscanf(buffer, "%s %s", buffer, buffer);
             name = buffer;
             iter = m_materialCache.find(buffer);
@@ -1199,7 +1530,7 @@ bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
             switch (buffer[1])
             {
             case '\0': // v
-                fscanf(pFile, "%f %f %f",
+                reader.scan("%f %f %f",
                     &m_vertexCoords[3 * numVertices],
                     &m_vertexCoords[3 * numVertices + 1],
                     &m_vertexCoords[3 * numVertices + 2]);
@@ -1207,7 +1538,7 @@ bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
                 break;
 
             case 'n': // vn
-                fscanf(pFile, "%f %f %f",
+                reader.scan("%f %f %f",
                     &m_normals[3 * numNormals],
                     &m_normals[3 * numNormals + 1],
                     &m_normals[3 * numNormals + 2]);
@@ -1215,7 +1546,7 @@ bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
                 break;
 
             case 't': // vt
-                fscanf(pFile, "%f %f",
+                reader.scan("%f %f",
                     &m_textureCoords[2 * numTexCoords],
                     &m_textureCoords[2 * numTexCoords + 1]);
                 ++numTexCoords;
@@ -1227,18 +1558,15 @@ bool ModelOBJ::importGeometrySecondPass(FILE *pFile)
             break;
 
         default:
-            fgets(buffer, sizeof(buffer), pFile);
+            reader.readLine(buffer, sizeof(buffer));
             break;
         }
     }
 	return true;
 }
 
-bool ModelOBJ::importMaterials(FILE *pFile)
+bool ModelOBJ::importMaterials(Reader &reader)
 {
-    if (!pFile)
-        return false;
-
 	int illum;
     char buffer[256] = {0};
 
@@ -1247,7 +1575,7 @@ bool ModelOBJ::importMaterials(FILE *pFile)
 
     // Load the materials in the MTL file.
 	bool done = false;
-    while (!done && fscanf(pFile, "%s", buffer) != EOF)
+    while (!done && reader.readWord(buffer, sizeof(buffer)))
     {
         switch (buffer[0])
         {
@@ -1255,7 +1583,7 @@ bool ModelOBJ::importMaterials(FILE *pFile)
 			done = true;
 			break;
         case 'N': // Ns
-            fscanf(pFile, "%f", &currentMaterial->shininess);
+            reader.scan("%f", &currentMaterial->shininess);
 
             // Wavefront .MTL file shininess is from [0,1000].
             // Scale back to a generic [0,1] range.
@@ -1266,7 +1594,7 @@ bool ModelOBJ::importMaterials(FILE *pFile)
             switch (buffer[1])
             {
             case 'a': // Ka
-                fscanf(pFile, "%f %f %f",
+                reader.scan("%f %f %f",
                     &currentMaterial->ambient[0],
                     &currentMaterial->ambient[1],
                     &currentMaterial->ambient[2]);
@@ -1274,7 +1602,7 @@ bool ModelOBJ::importMaterials(FILE *pFile)
                 break;
 
             case 'd': // Kd
-                fscanf(pFile, "%f %f %f",
+                reader.scan("%f %f %f",
                     &currentMaterial->diffuse[0],
                     &currentMaterial->diffuse[1],
                     &currentMaterial->diffuse[2]);
@@ -1282,7 +1610,7 @@ bool ModelOBJ::importMaterials(FILE *pFile)
                 break;
 
             case 's': // Ks
-                fscanf(pFile, "%f %f %f",
+                reader.scan("%f %f %f",
                     &currentMaterial->specular[0],
                     &currentMaterial->specular[1],
                     &currentMaterial->specular[2]);
@@ -1290,7 +1618,7 @@ bool ModelOBJ::importMaterials(FILE *pFile)
                 break;
 
             default:
-                fgets(buffer, sizeof(buffer), pFile);
+                reader.readLine(buffer, sizeof(buffer));
                 break;
             }
             break;
@@ -1299,22 +1627,22 @@ bool ModelOBJ::importMaterials(FILE *pFile)
             switch (buffer[1])
             {
             case 'r': // Tr
-                fscanf(pFile, "%f", &currentMaterial->alpha);
+                reader.scan("%f", &currentMaterial->alpha);
                 currentMaterial->alpha = 1.0f - currentMaterial->alpha;
                 break;
 
             default:
-                fgets(buffer, sizeof(buffer), pFile);
+                reader.readLine(buffer, sizeof(buffer));
                 break;
             }
             break;
 
         case 'd':
-            fscanf(pFile, "%f", &currentMaterial->alpha);
+            reader.scan("%f", &currentMaterial->alpha);
             break;
 
         case 'i': // illum
-            fscanf(pFile, "%d", &illum);
+            reader.scan("%d", &illum);
 
             if (illum == 1)
             {
@@ -1328,24 +1656,24 @@ bool ModelOBJ::importMaterials(FILE *pFile)
         case 'm': // map_Kd, map_bump
             if (strstr(buffer, "map_Kd") != 0)
             {
-                fgets(buffer, sizeof(buffer), pFile);
+                reader.readLine(buffer, sizeof(buffer));
                 sscanf(buffer, "%s %s", buffer, buffer);
                 currentMaterial->colorMapFilename = buffer;
             }
             else if (strstr(buffer, "map_bump") != 0)
             {
-                fgets(buffer, sizeof(buffer), pFile);
+                reader.readLine(buffer, sizeof(buffer));
                 sscanf(buffer, "%s %s", buffer, buffer);
                 currentMaterial->bumpMapFilename = buffer;
             }
             else
             {
-                fgets(buffer, sizeof(buffer), pFile);
+                reader.readLine(buffer, sizeof(buffer));
             }
             break;
 
         case 'n': // newmtl
-            fgets(buffer, sizeof(buffer), pFile);
+            reader.readLine(buffer, sizeof(buffer));
             sscanf(buffer, "%s %s", buffer, buffer);
 
 			m_materials.push_back(Material());
@@ -1373,7 +1701,7 @@ bool ModelOBJ::importMaterials(FILE *pFile)
             break;
 
         default:
-            fgets(buffer, sizeof(buffer), pFile);
+            reader.readLine(buffer, sizeof(buffer));
             break;
         }
     }
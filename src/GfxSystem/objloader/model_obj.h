@@ -28,6 +28,12 @@
 #include <string>
 #include <vector>
 
+namespace ResourceSystem
+{
+    class BinaryInput;
+    class BinaryOutput;
+}
+
 //-----------------------------------------------------------------------------
 // Alias|Wavefront OBJ file loader.
 //
@@ -40,6 +46,9 @@
 //    it isn't then the MTL file will fail to load and a default material is
 //    used instead.
 // 4. This loader triangulates all polygonal faces during importing.
+//
+// The OBJ file is parsed from a buffer in memory. The imported model can be
+// written in a binary form and read back later without parsing it again.
 //-----------------------------------------------------------------------------
 
 class ModelOBJ
@@ -78,10 +87,15 @@ public:
     ~ModelOBJ();
 
     void destroy();
-    bool import(const char *pszFilename, bool rebuildNormals = false);
+    bool import(const char *pData, size_t size, bool rebuildNormals = false);
     void normalize(float scaleTo = 1.0f, bool center = true);
     void reverseWinding();
 
+    // Binary form of the imported model.
+
+    void writeBinary(ResourceSystem::BinaryOutput &output) const;
+    bool readBinary(ResourceSystem::BinaryInput &input);
+
     // Getter methods.
 
     void getCenter(float &x, float &y, float &z) const;
@@ -102,8 +116,6 @@ public:
     int getNumberOfTriangles() const;
     int getNumberOfVertices() const;
 
-    const std::string &getPath() const;
-
     const Vertex &getVertex(int i) const;
     const Vertex *getVertexBuffer() const;
     int getVertexSize() const;
@@ -114,6 +126,8 @@ public:
     bool hasTextureCoords() const;
 
 private:
+    class Reader;
+
     bool addTrianglePos(int index, int material,
         int v0, int v1, int v2);
     bool addTrianglePosNormal(int index, int material,
@@ -132,9 +146,9 @@ private:
     void buildMeshes();
     void generateNormals();
     void generateTangents();
-    bool importGeometryFirstPass(FILE *pFile);
-    bool importGeometrySecondPass(FILE *pFile);
-    bool importMaterials(FILE *pFile);
+    bool importGeometryFirstPass(Reader &reader);
+    bool importGeometrySecondPass(Reader &reader);
+    bool importMaterials(Reader &reader);
     void scale(float scaleFactor, float offset[3]);
 
     bool m_hasPositions;
@@ -155,8 +169,6 @@ private:
     float m_length;
     float m_radius;
 
-    std::string m_directoryPath;
-
     std::vector<Mesh> m_meshes;
     std::vector<Material> m_materials;
     std::vector<Vertex> m_vertexBuffer;
@@ -214,9 +226,6 @@ inline int ModelOBJ::getNumberOfTriangles() const
 inline int ModelOBJ::getNumberOfVertices() const
 { return static_cast<int>(m_vertexBuffer.size()); }
 
-inline const std::string &ModelOBJ::getPath() const
-{ return m_directoryPath; }
-
 inline const ModelOBJ::Vertex &ModelOBJ::getVertex(int i) const
 { return m_vertexBuffer[i]; }
 
@@ -7,8 +7,12 @@
 #include "Logger.h"
 
 /// Setting of the current logging level. Only logging above the level (included) will work.
+/// Logging below this level is removed at compile time. Logging above it can be further filtered at runtime per channel.
 #define LOGGER_LEVEL 2
 
+/// Logs into a channel only if the channel is enabled for the level. The message is not formatted at all otherwise.
+#define OC_CHANNEL_LOGGER(channel, level) !LogSystem::Logger::IsEnabled(channel, level) ? (void)0 : LogSystem::LoggerVoidify() & LogSystem::Logger(level, false)
+
 
 #define LL_ERROR 4
 #if LOGGER_LEVEL <= LL_ERROR
@@ -21,37 +25,49 @@
 
 #define LL_WARNING 3
 #if LOGGER_LEVEL <= LL_WARNING
-/// Warning messages logging. For enabling/disabling see the LOGGER_LEVEL macro.
-#define ocWarning LogSystem::Logger(LL_WARNING, false) << "WARNING in " << __FILE__ << ":" << __LINE__ << "\n          "
+/// Warning messages logging. For enabling/disabling see the LOGGER_LEVEL macro and the channel levels in LogMgr.
+#define ocWarning OC_CHANNEL_LOGGER(LogSystem::LC_GENERAL, LL_WARNING) << "WARNING in " << __FILE__ << ":" << __LINE__ << "\n          "
+/// Logging into the given channel. See ocWarning.
+#define ocChannelWarning(channel) OC_CHANNEL_LOGGER(LogSystem::channel, LL_WARNING) << "WARNING in " << __FILE__ << ":" << __LINE__ << "\n          "
 #else
 #define ocWarning if(1);else LogSystem::Logger(LL_DEBUG, false)
+#define ocChannelWarning(channel) if(1);else LogSystem::Logger(LL_DEBUG, false)
 #endif
 
 
 #define LL_INFO 2
 #if LOGGER_LEVEL <= LL_INFO
-/// Logging of basic informations about what's going on. For enabling/disabling see the LOGGER_LEVEL macro.
-#define ocInfo LogSystem::Logger(LL_INFO, false)
+/// Logging of basic informations about what's going on. For enabling/disabling see the LOGGER_LEVEL macro and the channel levels in LogMgr.
+#define ocInfo OC_CHANNEL_LOGGER(LogSystem::LC_GENERAL, LL_INFO)
+/// Logging into the given channel. See ocInfo.
+#define ocChannelInfo(channel) OC_CHANNEL_LOGGER(LogSystem::channel, LL_INFO)
 #else
 #define ocInfo if(1);else LogSystem::Logger(LL_DEBUG, false)
+#define ocChannelInfo(channel) if(1);else LogSystem::Logger(LL_DEBUG, false)
 #endif
 
 
 #define LL_DEBUG 1
 #if LOGGER_LEVEL <= LL_DEBUG
-/// Logging of debugging messages. For enabling/disabling see the LOGGER_LEVEL macro.
-#define ocDebug LogSystem::Logger(LL_DEBUG, false)
+/// Logging of debugging messages. For enabling/disabling see the LOGGER_LEVEL macro and the channel levels in LogMgr.
+#define ocDebug OC_CHANNEL_LOGGER(LogSystem::LC_GENERAL, LL_DEBUG)
+/// Logging into the given channel. See ocDebug.
+#define ocChannelDebug(channel) OC_CHANNEL_LOGGER(LogSystem::channel, LL_DEBUG)
 #else
 #define ocDebug if(1);else LogSystem::Logger(LL_DEBUG, false)
+#define ocChannelDebug(channel) if(1);else LogSystem::Logger(LL_DEBUG, false)
 #endif
 
 
 #define LL_TRACE 0
 #if LOGGER_LEVEL <= LL_TRACE
-/// Logging of very informative debugging messages. For enabling/disabling see the LOGGER_LEVEL macro.
-#define ocTrace LogSystem::Logger(LL_TRACE, false)
+/// Logging of very informative debugging messages. For enabling/disabling see the LOGGER_LEVEL macro and the channel levels in LogMgr.
+#define ocTrace OC_CHANNEL_LOGGER(LogSystem::LC_GENERAL, LL_TRACE)
+/// Logging into the given channel. See ocTrace.
+#define ocChannelTrace(channel) OC_CHANNEL_LOGGER(LogSystem::channel, LL_TRACE)
 #else
 #define ocTrace if(1);else LogSystem::Logger(LL_DEBUG, false)
+#define ocChannelTrace(channel) if(1);else LogSystem::Logger(LL_DEBUG, false)
 #endif
 
 
@@ -2,19 +2,54 @@
 #include "LogMgr.h"
 #include "../Core/Application.h"
 #include "../GUISystem/GUIConsole.h"
-#include <iomanip>
+#include "../Core/Config.h"
+#include "SDL/SDL_thread.h"
+#include "SDL/SDL_mutex.h"
 
 using namespace LogSystem;
 
+/// Maximum time in milliseconds the messages wait in the buffer before being written to the log file.
+const uint32 LOG_FLUSH_INTERVAL = 500;
+
+/// Names of the log channels in the order of eLogChannel.
+const char* LOG_CHANNEL_NAMES[] = { "General", "Core", "Entities", "Resources", "Gfx", "Scripts", "GUI", "Input", "Editor" };
+
+/// Name standing for all channels.
+const char* LOG_ALL_CHANNELS_NAME = "All";
+
+/// Section of the config containing the levels of the channels.
+const char* LOG_CONFIG_SECTION = "Logging";
+
 
 LogSystem::LogMgr::LogMgr( void ):
-	mOutStream(0)
+	mOutStream(0),
+	mWriterThread(0),
+	mStopWriter(false),
+	mMainThreadID(0)
 {
-
+	mMutex = SDL_CreateMutex();
+	mWriteMutex = SDL_CreateMutex();
+	mWriterCondition = SDL_CreateCond();
 }
 
 LogSystem::LogMgr::~LogMgr()
 {
+	if (mWriterThread)
+	{
+		SDL_mutexP(mMutex);
+		mStopWriter = true;
+		SDL_CondSignal(mWriterCondition);
+		SDL_mutexV(mMutex);
+		SDL_WaitThread(mWriterThread, 0);
+	}
+
+	// write whatever was logged after the writer had finished
+	Flush();
+
+	SDL_DestroyCond(mWriterCondition);
+	SDL_DestroyMutex(mWriteMutex);
+	SDL_DestroyMutex(mMutex);
+
 	if (mOutStream)
 	{
 		mOutStream->close();
@@ -29,7 +64,11 @@ void LogSystem::LogMgr::Init( const string& name )
 	mOutStream = new boost::filesystem::ofstream();
 	mOutStream->open(name.c_str());
 
+	mMainThreadID = SDL_ThreadID();
+	mWriterThread = SDL_CreateThread(WriterThreadMain, this);
+
 	ocInfo << "Log created";
+	if (!mWriterThread) ocWarning << "Can't create the log writer thread; messages will be written immediately";
 }
 
 void LogSystem::LogMgr::LogMessage(const string& msg, int32 loggingLevel)
@@ -38,34 +77,162 @@ void LogSystem::LogMgr::LogMessage(const string& msg, int32 loggingLevel)
 	#pragma warning(disable: 4996)
 #endif
 
-	struct tm* locTime;
-	time_t ctime;
-	time(&ctime);
-	locTime = localtime(&ctime);
+	// the message is formatted before locking, so that the logging threads wait for each other as little as possible
+	time_t currentTime;
+	time(&currentTime);
+	struct tm locTime;
+#ifdef __WIN__
+	localtime_s(&locTime, &currentTime);
+#else
+	localtime_r(&currentTime, &locTime);
+#endif
+	char timePrefix[16];
+	sprintf(timePrefix, "%02d:%02d:%02d: ", locTime.tm_hour, locTime.tm_min, locTime.tm_sec);
 
-	stringstream ss;
-	ss << std::setw(2) << std::setfill('0') << locTime->tm_hour	<< ":"
-	   << std::setw(2) << std::setfill('0') << locTime->tm_min  << ":"
-	   << std::setw(2) << std::setfill('0') << locTime->tm_sec	<< ": ";
+	// the final message
+	string finalString = timePrefix;
+	finalString.append(msg);
+	finalString.append("\n");
 
-	ss << msg << std::endl;
+	SDL_mutexP(mMutex);
 
-	// the final message
-	string finalString = ss.str();
+	mPendingMessages.append(finalString);
 
-	// append the message to the OS console
-	if (Core::Application::SingletonExists())
+	// GUI is not thread safe, so the messages from other threads must wait for the main one
+	bool isMainThread = SDL_ThreadID() == mMainThreadID;
+	ConsoleMessages consoleMessages;
+	if (isMainThread) consoleMessages.swap(mPendingConsoleMessages);
+	else mPendingConsoleMessages.push_back(pair<string, int32>(finalString, loggingLevel));
+
+	SDL_mutexV(mMutex);
+
+	// errors must be in the log even if the application crashes right after them
+	if (!mWriterThread || loggingLevel >= LL_ERROR) Flush();
+
+	if (isMainThread)
 	{
-		gApp.WriteToConsole(finalString);
+		for (ConsoleMessages::const_iterator it=consoleMessages.begin(); it!=consoleMessages.end(); ++it)
+		{
+			AppendToConsole(it->first, it->second);
+		}
+		AppendToConsole(finalString, loggingLevel);
 	}
+}
 
+void LogSystem::LogMgr::AppendToConsole( const string& message, int32 loggingLevel )
+{
 	// append the message to the internal GUI console
 	if (GUISystem::GUIMgr::SingletonExists() && gGUIMgr.GetConsole())
 	{
-		gGUIMgr.GetConsole()->AppendLogMessage(finalString, loggingLevel);
+		gGUIMgr.GetConsole()->AppendLogMessage(message, loggingLevel);
+	}
+}
+
+void LogSystem::LogMgr::FlushConsoleMessages( void )
+{
+	OC_DASSERT(SDL_ThreadID() == mMainThreadID);
+
+	ConsoleMessages consoleMessages;
+	SDL_mutexP(mMutex);
+	consoleMessages.swap(mPendingConsoleMessages);
+	SDL_mutexV(mMutex);
+
+	for (ConsoleMessages::const_iterator it=consoleMessages.begin(); it!=consoleMessages.end(); ++it)
+	{
+		AppendToConsole(it->first, it->second);
+	}
+}
+
+int LogSystem::LogMgr::WriterThreadMain( void* logMgr )
+{
+	((LogMgr*)logMgr)->RunWriter();
+	return 0;
+}
+
+void LogSystem::LogMgr::RunWriter( void )
+{
+	SDL_mutexP(mMutex);
+	while (!mStopWriter)
+	{
+		SDL_CondWaitTimeout(mWriterCondition, mMutex, LOG_FLUSH_INTERVAL);
+		if (mPendingMessages.empty()) continue;
+
+		SDL_mutexV(mMutex);
+		Flush();
+		SDL_mutexP(mMutex);
+	}
+	SDL_mutexV(mMutex);
+}
+
+void LogSystem::LogMgr::Flush( void )
+{
+	SDL_mutexP(mWriteMutex);
+
+	// take all pending messages and write them without blocking the logging threads
+	string messages;
+	SDL_mutexP(mMutex);
+	messages.swap(mPendingMessages);
+	SDL_mutexV(mMutex);
+	WriteMessages(messages);
+
+	SDL_mutexV(mWriteMutex);
+}
+
+void LogSystem::LogMgr::WriteMessages( const string& messages )
+{
+	if (messages.empty()) return;
+
+	// append the messages to the OS console
+	if (Core::Application::SingletonExists())
+	{
+		gApp.WriteToConsole(messages);
 	}
 
-	// append the message to the log file
-	(*mOutStream) << finalString;
-	mOutStream->flush();
+	// append the messages to the log file
+	if (mOutStream)
+	{
+		(*mOutStream) << messages;
+		mOutStream->flush();
+	}
+}
+
+bool LogSystem::LogMgr::SetChannelLevel( const string& channelName, const int32 loggingLevel )
+{
+	bool allChannels = channelName == LOG_ALL_CHANNELS_NAME;
+	bool found = false;
+	for (int32 i=0; i<NUM_LOG_CHANNELS; ++i)
+	{
+		if (allChannels || channelName == LOG_CHANNEL_NAMES[i])
+		{
+			Logger::SetChannelLevel((eLogChannel)i, loggingLevel);
+			found = true;
+		}
+	}
+	if (!found) ocWarning << "Unknown log channel '" << channelName << "'";
+	return found;
+}
+
+int32 LogSystem::LogMgr::GetChannelLevel( const string& channelName ) const
+{
+	for (int32 i=0; i<NUM_LOG_CHANNELS; ++i)
+	{
+		if (channelName == LOG_CHANNEL_NAMES[i]) return Logger::GetChannelLevel((eLogChannel)i);
+	}
+	return -1;
+}
+
+void LogSystem::LogMgr::LoadChannelLevels( const Core::Config& config )
+{
+	int32 allLevel = config.GetInt32(LOG_ALL_CHANNELS_NAME, -1, LOG_CONFIG_SECTION);
+	for (int32 i=0; i<NUM_LOG_CHANNELS; ++i)
+	{
+		int32 defaultLevel = allLevel >= 0 ? allLevel : Logger::GetChannelLevel((eLogChannel)i);
+		Logger::SetChannelLevel((eLogChannel)i, config.GetInt32(LOG_CHANNEL_NAMES[i], defaultLevel, LOG_CONFIG_SECTION));
+	}
+}
+
+const char* LogSystem::LogMgr::GetChannelName( const eLogChannel channel )
+{
+	OC_ASSERT(channel >= 0 && channel < NUM_LOG_CHANNELS);
+	return LOG_CHANNEL_NAMES[channel];
 }
@@ -8,11 +8,18 @@
 #include "Singleton.h"
 #include <boost/filesystem/fstream.hpp>
 
+struct SDL_mutex;
+struct SDL_cond;
+struct SDL_Thread;
+
 /// Logging system helps with debugging of the application by allowing programmers to save info about what's going on.
 namespace LogSystem
 {
 	/// This class allows you to store arbitrary notes into the logfile for later reviews.
 	/// Note that it's not wise to use this class directly, but the macros inside LogMacros.h instead.
+	/// @remarks
+	/// The messages are only appended to a buffer by the logging thread. A background thread writes the buffer
+	/// to the log file and the OS console in batches periodically. Errors are written before LogMessage returns.
 	class LogMgr : public Singleton<LogMgr>
 	{
 	public:
@@ -30,8 +37,52 @@ namespace LogSystem
 		/// Saves a note into the log file.
 		void LogMessage(const string& msg, int32 loggingLevel);
 
+		/// Writes all pending messages to the log file and the OS console before returning.
+		void Flush(void);
+
+		/// Appends the messages logged from other threads to the GUI console. Must be called from the main thread
+		/// regularly, otherwise the messages wait until the main thread logs something.
+		void FlushConsoleMessages(void);
+
+		/// Sets the minimal level of messages logged in the channel with the given name.
+		/// The name "All" sets the level of all channels. Returns false if there is no such channel.
+		bool SetChannelLevel(const string& channelName, const int32 loggingLevel);
+
+		/// Returns the minimal level of messages logged in the channel with the given name or -1 if there is no such channel.
+		int32 GetChannelLevel(const string& channelName) const;
+
+		/// Loads the levels of the channels from the Logging section of the config. Missing channels are left unchanged.
+		void LoadChannelLevels(const Core::Config& config);
+
+		/// Returns the name of the channel as used in the config and in the console.
+		static const char* GetChannelName(const eLogChannel channel);
+
 	private:
 		boost::filesystem::ofstream* mOutStream;
+
+		SDL_mutex* mMutex;
+		SDL_mutex* mWriteMutex; ///< Held while writing, so that the batches of messages are written in order.
+		SDL_cond* mWriterCondition;
+		SDL_Thread* mWriterThread;
+		bool mStopWriter;
+		string mPendingMessages;
+
+		/// Messages logged from other threads than the main one waiting to be appended to the GUI console.
+		typedef vector< pair<string, int32> > ConsoleMessages;
+		ConsoleMessages mPendingConsoleMessages;
+		uint32 mMainThreadID;
+
+		/// Entry point of the writer thread.
+		static int WriterThreadMain(void* logMgr);
+
+		/// Writes the pending messages until the manager is destroyed.
+		void RunWriter(void);
+
+		/// Writes a batch of messages to the outputs.
+		void WriteMessages(const string& messages);
+
+		/// Appends the message to the GUI console.
+		void AppendToConsole(const string& message, int32 loggingLevel);
 	};
 }
 
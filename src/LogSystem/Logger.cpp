@@ -19,6 +19,11 @@
 
 using namespace LogSystem;
 
+/// Levels of all channels in the order of eLogChannel. They can be changed at runtime by LogMgr.
+/// The entities are logged on every component creation and destruction, so only warnings are shown by default.
+int32 LogSystem::Logger::mChannelLevels[NUM_LOG_CHANNELS] = {
+	LOGGER_LEVEL, LOGGER_LEVEL, LL_WARNING, LOGGER_LEVEL, LOGGER_LEVEL, LOGGER_LEVEL, LOGGER_LEVEL, LOGGER_LEVEL, LOGGER_LEVEL };
+
 LogSystem::Logger::~Logger( void )
 {
 #ifdef USE_DBGLIB
@@ -8,6 +8,23 @@
 
 namespace LogSystem
 {
+	/// Channels the logged messages can be assigned to. Each channel has its own logging level which can be changed
+	/// at runtime, so the messages of one subsystem can be turned on or off independently of the others.
+	enum eLogChannel
+	{
+		LC_GENERAL = 0,
+		LC_CORE,
+		LC_ENTITIES,
+		LC_RESOURCES,
+		LC_GFX,
+		LC_SCRIPTS,
+		LC_GUI,
+		LC_INPUT,
+		LC_EDITOR,
+
+		NUM_LOG_CHANNELS
+	};
+
 	/// This classes makes logging easier. It implements << operators for all data types we could want to use for logging.
 	/// An important thing is that the message is actually logged only when destructing instance of this class,
 	/// which allows you to write
@@ -44,6 +61,16 @@ namespace LogSystem
 
 		Logger& operator<<(const Utils::StringKey& value);
 
+		/// Returns true if messages of the given level are logged in the channel.
+		/// @remarks This is the only cost of a disabled logging statement, so it must stay a single comparison.
+		static inline bool IsEnabled(const eLogChannel channel, const int32 logLevel) { return logLevel >= mChannelLevels[channel]; }
+
+		/// Returns the minimal level of messages logged in the channel.
+		static inline int32 GetChannelLevel(const eLogChannel channel) { return mChannelLevels[channel]; }
+
+		/// Sets the minimal level of messages logged in the channel.
+		static inline void SetChannelLevel(const eLogChannel channel, const int32 logLevel) { mChannelLevels[channel] = logLevel; }
+
 		/// Templated writable operator << for easier logging.
 		template<typename T>
 		Logger& operator<<(T value)
@@ -56,6 +83,15 @@ namespace LogSystem
 		int32 mLogLevel;
 		bool mGenerateStackTrace;
 		stringstream mMessageBuffer;
+
+		static int32 mChannelLevels[NUM_LOG_CHANNELS];
+	};
+
+	/// Turns a logging expression into void, so that the logging macros can skip it in a conditional expression
+	/// and still be used as a single statement anywhere.
+	struct LoggerVoidify
+	{
+		inline void operator&(const Logger&) const {}
 	};
 	
 }
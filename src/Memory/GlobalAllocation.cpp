@@ -82,3 +82,8 @@ void CustomFree(void* ptr)
 {
 	Memory::CustomFree(ptr);
 }
+
+void* CustomRealloc(void* ptr, size_t sz)
+{
+	return Memory::CustomRealloc(ptr, sz);
+}
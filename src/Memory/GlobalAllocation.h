@@ -30,6 +30,15 @@ namespace Memory
 		free(ptr);
 	}
 
+	/// Custom implementation of realloc.
+	inline void* CustomRealloc(void* ptr, std::size_t sz)
+	{
+		// WARNING:
+		// note that if you remove calls to the standard realloc, you have to hook your custom realloc to DbgLib's hooks
+		// detecting memory leaks
+		return realloc(ptr, sz);
+	}
+
 }
 
 #endif // GlobalAllocation_h__
\ No newline at end of file
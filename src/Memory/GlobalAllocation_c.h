@@ -17,6 +17,9 @@ void* CustomMalloc(size_t sz);
 /// Custom implementation of free.
 void CustomFree(void* ptr);
 
+/// Custom implementation of realloc.
+void* CustomRealloc(void* ptr, size_t sz);
+
 
 #ifdef __cplusplus
 }
@@ -77,10 +77,15 @@ namespace LogSystem
 namespace ResourceSystem
 {
 	class ResourceMgr;
+	class BackgroundLoader;
+	class FileWatcher;
 	class IResourceLoadingListener;
 	class XMLResource;
-	class XMLNodeIterator;
+	class XMLReader;
 	class XMLOutput;
+	class BinaryResource;
+	class BinaryInput;
+	class BinaryOutput;
 }
 
 namespace InputSystem
@@ -103,6 +108,7 @@ namespace StringSystem
 namespace Utils
 {
 	class DataContainer;
+	class JobPool;
 	class StringKey;
 	class Timer;
 }
@@ -0,0 +1,175 @@
+#include "Common.h"
+#include "BackgroundLoader.h"
+#include "SDL/SDL_thread.h"
+#include "SDL/SDL_mutex.h"
+
+using namespace ResourceSystem;
+
+ResourceSystem::BackgroundLoader::BackgroundLoader( const int32 workerCount ):
+	mStopWorkers(false),
+	mPendingResourcesCount(0)
+{
+	mMutex = SDL_CreateMutex();
+	mWorkCondition = SDL_CreateCond();
+	mDoneCondition = SDL_CreateCond();
+
+	for (int32 i=0; i<workerCount; ++i)
+	{
+		SDL_Thread* worker = SDL_CreateThread(WorkerThreadMain, this);
+		if (!worker)
+		{
+			ocWarning << "Can't create a resource loading thread";
+			break;
+		}
+		mWorkers.push_back(worker);
+	}
+	ocInfo << "Resources are prepared by " << mWorkers.size() << " threads";
+}
+
+ResourceSystem::BackgroundLoader::~BackgroundLoader( void )
+{
+	OC_ASSERT_MSG(GetPendingResourcesCount() == 0, "Some resources are still being loaded in background");
+
+	SDL_mutexP(mMutex);
+	mStopWorkers = true;
+	SDL_CondBroadcast(mWorkCondition);
+	SDL_mutexV(mMutex);
+
+	for (WorkerVector::iterator it=mWorkers.begin(); it!=mWorkers.end(); ++it)
+	{
+		SDL_WaitThread(*it, 0);
+	}
+
+	SDL_DestroyCond(mDoneCondition);
+	SDL_DestroyCond(mWorkCondition);
+	SDL_DestroyMutex(mMutex);
+}
+
+bool ResourceSystem::BackgroundLoader::QueueResource( const ResourcePtr& res )
+{
+	if (mWorkers.empty() || !res->IsPreparable() || res->mPrepareState != Resource::PS_NONE) return false;
+
+	SDL_mutexP(mMutex);
+	res->mPrepareState = Resource::PS_QUEUED;
+	mQueuedResources.push_back(res);
+	++mPendingResourcesCount;
+	SDL_CondSignal(mWorkCondition);
+	SDL_mutexV(mMutex);
+	return true;
+}
+
+void ResourceSystem::BackgroundLoader::FinishResource( Resource* res )
+{
+	SDL_mutexP(mMutex);
+	RemoveResource(res, true);
+	SDL_mutexV(mMutex);
+}
+
+void ResourceSystem::BackgroundLoader::CancelResource( Resource* res )
+{
+	SDL_mutexP(mMutex);
+	bool prepared = res->mPrepareState != Resource::PS_QUEUED;
+	RemoveResource(res, false);
+	SDL_mutexV(mMutex);
+
+	if (prepared) res->DiscardPreparedData();
+}
+
+ResourcePtr ResourceSystem::BackgroundLoader::PopPreparedResource( void )
+{
+	ResourcePtr result;
+	SDL_mutexP(mMutex);
+	if (!mPreparedResources.empty())
+	{
+		result = mPreparedResources.front();
+		mPreparedResources.pop_front();
+	}
+	SDL_mutexV(mMutex);
+	return result;
+}
+
+void ResourceSystem::BackgroundLoader::WaitForPreparedResource( const uint32 timeout )
+{
+	SDL_mutexP(mMutex);
+	if (mPreparedResources.empty()) SDL_CondWaitTimeout(mDoneCondition, mMutex, timeout);
+	SDL_mutexV(mMutex);
+}
+
+uint32 ResourceSystem::BackgroundLoader::GetPendingResourcesCount( void ) const
+{
+	SDL_mutexP(mMutex);
+	uint32 result = mPendingResourcesCount;
+	SDL_mutexV(mMutex);
+	return result;
+}
+
+int ResourceSystem::BackgroundLoader::WorkerThreadMain( void* loader )
+{
+	((BackgroundLoader*)loader)->RunWorker();
+	return 0;
+}
+
+void ResourceSystem::BackgroundLoader::RunWorker( void )
+{
+	SDL_mutexP(mMutex);
+	while (!mStopWorkers)
+	{
+		if (mQueuedResources.empty())
+		{
+			SDL_CondWait(mWorkCondition, mMutex);
+			continue;
+		}
+
+		ResourcePtr res = mQueuedResources.front();
+		mQueuedResources.pop_front();
+		res->mPrepareState = Resource::PS_PREPARING;
+		SDL_mutexV(mMutex);
+
+		res->PrepareImpl();
+
+		SDL_mutexP(mMutex);
+		res->mPrepareState = Resource::PS_PREPARED;
+		mPreparedResources.push_back(res);
+		SDL_CondBroadcast(mDoneCondition);
+	}
+	SDL_mutexV(mMutex);
+}
+
+bool ResourceSystem::BackgroundLoader::RemoveFromQueue( ResourceQueue& queue, const Resource* res )
+{
+	for (ResourceQueue::iterator it=queue.begin(); it!=queue.end(); ++it)
+	{
+		if (it->get() == res)
+		{
+			queue.erase(it);
+			return true;
+		}
+	}
+	return false;
+}
+
+void ResourceSystem::BackgroundLoader::RemoveResource( Resource* res, bool prepare )
+{
+	OC_ASSERT(res->mPrepareState != Resource::PS_NONE);
+
+	if (res->mPrepareState == Resource::PS_QUEUED)
+	{
+		// no worker got to the resource yet, so it's prepared right here
+		RemoveFromQueue(mQueuedResources, res);
+		if (prepare)
+		{
+			res->mPrepareState = Resource::PS_PREPARING;
+			SDL_mutexV(mMutex);
+			res->PrepareImpl();
+			SDL_mutexP(mMutex);
+		}
+	}
+	else
+	{
+		while (res->mPrepareState == Resource::PS_PREPARING) SDL_CondWait(mDoneCondition, mMutex);
+		RemoveFromQueue(mPreparedResources, res);
+	}
+
+	res->mPrepareState = Resource::PS_NONE;
+	--mPendingResourcesCount;
+}
@@ -0,0 +1,76 @@
+/// @file
+/// Preparation of resources on worker threads.
+
+#ifndef BackgroundLoader_h__
+#define BackgroundLoader_h__
+
+#include "Base.h"
+
+struct SDL_mutex;
+struct SDL_cond;
+struct SDL_Thread;
+
+namespace ResourceSystem
+{
+	/// Runs the preparation part of loading of resources (reading files, decoding data) on a pool of worker threads.
+	/// The prepared resources are then handed back to the main thread which finishes their loading by calling Load.
+	/// @remarks
+	/// Only resources returning true from IsPreparable can be queued. If the main thread needs a queued resource
+	/// before it's prepared, it either prepares it itself or waits for the worker preparing it.
+	class BackgroundLoader
+	{
+	public:
+
+		/// Constructs the loader and starts the given number of worker threads.
+		BackgroundLoader(const int32 workerCount);
+
+		/// Stops the worker threads. No resource can be queued at this point.
+		~BackgroundLoader(void);
+
+		/// Queues the resource to be prepared by the workers. Returns false if the resource can't be prepared in background.
+		bool QueueResource(const ResourcePtr& res);
+
+		/// Makes sure the queued resource is prepared and removes it from the loader, so it can be loaded.
+		void FinishResource(Resource* res);
+
+		/// Removes the queued resource from the loader and discards its prepared data.
+		void CancelResource(Resource* res);
+
+		/// Returns a resource prepared by the workers or null if there's none. The resource stays in the loader
+		/// until it's loaded or cancelled.
+		ResourcePtr PopPreparedResource(void);
+
+		/// Waits until a resource is prepared or the timeout (in milliseconds) expires.
+		void WaitForPreparedResource(const uint32 timeout);
+
+		/// Returns the number of resources in the loader.
+		uint32 GetPendingResourcesCount(void) const;
+
+	private:
+		typedef deque<ResourcePtr> ResourceQueue;
+		typedef vector<SDL_Thread*> WorkerVector;
+
+		SDL_mutex* mMutex;
+		SDL_cond* mWorkCondition;
+		SDL_cond* mDoneCondition;
+		WorkerVector mWorkers;
+		bool mStopWorkers;
+		ResourceQueue mQueuedResources;
+		ResourceQueue mPreparedResources;
+		uint32 mPendingResourcesCount;
+
+		/// Entry point of the worker threads.
+		static int WorkerThreadMain(void* loader);
+
+		/// Prepares the queued resources until the loader is destroyed.
+		void RunWorker(void);
+
+		/// Removes the resource from the queue. The mutex must be locked. Returns false if it wasn't there.
+		static bool RemoveFromQueue(ResourceQueue& queue, const Resource* res);
+
+		/// Waits until the resource is not being prepared and removes it from the loader. The mutex must be locked.
+		void RemoveResource(Resource* res, bool prepare);
+	};
+}
+
+#endif // BackgroundLoader_h__
@@ -0,0 +1,52 @@
+#include "Common.h"
+#include "BinaryInput.h"
+#include <cstring>
+
+using namespace ResourceSystem;
+
+bool ResourceSystem::BinaryInput::ReadBytes( void* data, const uint32 size )
+{
+	if (size > mSize - mPosition)
+	{
+		memset(data, 0, size);
+		mPosition = mSize;
+		mFailed = true;
+		return false;
+	}
+	if (size > 0) memcpy(data, mData + mPosition, size);
+	mPosition += size;
+	return true;
+}
+
+string ResourceSystem::BinaryInput::ReadString( void )
+{
+	const uint32 length = Read<uint32>();
+	if (length > mSize - mPosition)
+	{
+		mPosition = mSize;
+		mFailed = true;
+		return string();
+	}
+	string result((const char*)mData + mPosition, length);
+	mPosition += length;
+	return result;
+}
+
+ResourceSystem::BinaryInput ResourceSystem::BinaryInput::ReadBlock( const uint32 size )
+{
+	const uint8* block = mData + mPosition;
+	if (!Skip(size)) return BinaryInput(0, 0);
+	return BinaryInput(block, size);
+}
+
+bool ResourceSystem::BinaryInput::Skip( const uint32 size )
+{
+	if (size > mSize - mPosition)
+	{
+		mPosition = mSize;
+		mFailed = true;
+		return false;
+	}
+	mPosition += size;
+	return true;
+}
@@ -0,0 +1,68 @@
+/// @file
+/// Read binary data from memory.
+
+#ifndef BinaryInput_h__
+#define BinaryInput_h__
+
+#include "Base.h"
+
+namespace ResourceSystem
+{
+	/// Reads values from a block of binary data written by BinaryOutput. The block is not copied, so it must live
+	/// as long as the input is used.
+	/// @remarks
+	/// Reading past the end of the block doesn't crash. The missing values are returned as zeroes and the input
+	/// remembers the failure, so it's enough to check HasFailed after a whole group of values was read.
+	class BinaryInput
+	{
+	public:
+
+		/// Constructs the input reading the given block of data.
+		BinaryInput(const uint8* data, const uint32 size): mData(data), mSize(size), mPosition(0), mFailed(false) {}
+
+		/// Destructor.
+		~BinaryInput(void) {}
+
+		/// Copies the raw bytes from the input. Returns false and fills the data with zeroes if there are not enough bytes.
+		bool ReadBytes(void* data, const uint32 size);
+
+		/// Reads the value of a plain type.
+		template<typename T>
+		inline T Read(void)
+		{
+			T value;
+			ReadBytes(&value, sizeof(T));
+			return value;
+		}
+
+		/// Reads the string written by BinaryOutput::WriteString.
+		string ReadString(void);
+
+		/// Moves the read position forward by the given number of bytes. Returns false if there are not enough bytes.
+		bool Skip(const uint32 size);
+
+		/// Returns an input reading the next given number of bytes and moves the read position past them.
+		/// Whatever happens while reading the returned input, this input continues right after the block.
+		BinaryInput ReadBlock(const uint32 size);
+
+		/// Returns the current read position.
+		inline uint32 GetPosition(void) const { return mPosition; }
+
+		/// Returns the size of the data.
+		inline uint32 GetSize(void) const { return mSize; }
+
+		/// Returns true if all data was read.
+		inline bool IsAtEnd(void) const { return mPosition >= mSize; }
+
+		/// Returns true if there was an attempt to read past the end of the data.
+		inline bool HasFailed(void) const { return mFailed; }
+
+	private:
+		const uint8* mData;
+		uint32 mSize;
+		uint32 mPosition;
+		bool mFailed;
+	};
+}
+
+#endif // BinaryInput_h__
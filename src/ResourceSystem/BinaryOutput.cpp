@@ -0,0 +1,48 @@
+#include "Common.h"
+#include "BinaryOutput.h"
+#include <boost/filesystem/fstream.hpp>
+#include <cstring>
+
+using namespace ResourceSystem;
+
+void ResourceSystem::BinaryOutput::WriteBytes( const void* data, const uint32 size )
+{
+	if (size == 0) return;
+	const uint32 position = mData.size();
+	mData.resize(position + size);
+	memcpy(&mData[position], data, size);
+}
+
+void ResourceSystem::BinaryOutput::WriteString( const string& str )
+{
+	Write<uint32>(str.size());
+	WriteBytes(str.data(), str.size());
+}
+
+uint32 ResourceSystem::BinaryOutput::ReserveUInt32( void )
+{
+	const uint32 position = mData.size();
+	Write<uint32>(0);
+	return position;
+}
+
+void ResourceSystem::BinaryOutput::WriteUInt32At( const uint32 position, const uint32 value )
+{
+	OC_ASSERT(position + sizeof(uint32) <= mData.size());
+	memcpy(&mData[position], &value, sizeof(uint32));
+}
+
+bool ResourceSystem::BinaryOutput::SaveToFile( const string& fileName ) const
+{
+	boost::filesystem::ofstream outStream;
+	outStream.open(fileName.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	if (!outStream.is_open())
+	{
+		ocError << "Can't open file '" << fileName << "' for writing";
+		return false;
+	}
+	if (!mData.empty()) outStream.write((const char*)&mData[0], mData.size());
+	bool result = outStream.good();
+	outStream.close();
+	return result && outStream.good();
+}
@@ -0,0 +1,59 @@
+/// @file
+/// Store binary data to memory or file.
+
+#ifndef BinaryOutput_h__
+#define BinaryOutput_h__
+
+#include "Base.h"
+
+namespace ResourceSystem
+{
+	/// Builds a block of binary data in memory. The values are written in the native byte order without any padding,
+	/// so the block can be read back by BinaryInput on a platform of the same endianness.
+	class BinaryOutput
+	{
+	public:
+
+		/// Constructs an empty output.
+		BinaryOutput(void) {}
+
+		/// Destructor.
+		~BinaryOutput(void) {}
+
+		/// Appends the raw bytes to the output.
+		void WriteBytes(const void* data, const uint32 size);
+
+		/// Appends the value of a plain type to the output.
+		template<typename T>
+		inline void Write(const T& value) { WriteBytes(&value, sizeof(T)); }
+
+		/// Appends the string prefixed by its length to the output.
+		void WriteString(const string& str);
+
+		/// Appends a placeholder for an uint32 value which is not known yet and returns its position.
+		/// The value is filled in later by WriteUInt32At.
+		uint32 ReserveUInt32(void);
+
+		/// Overwrites the uint32 value at the position returned by ReserveUInt32.
+		void WriteUInt32At(const uint32 position, const uint32 value);
+
+		/// Returns the written data.
+		inline const uint8* GetData(void) const { return mData.empty() ? 0 : &mData[0]; }
+
+		/// Returns the number of written bytes.
+		inline uint32 GetSize(void) const { return mData.size(); }
+
+		/// Discards all written data.
+		inline void Clear(void) { mData.clear(); }
+
+		/// Writes the data to the file. Returns false if the file can't be written.
+		bool SaveToFile(const string& fileName) const;
+
+	private:
+
+		/// The written data.
+		vector<uint8> mData;
+	};
+}
+
+#endif // BinaryOutput_h__
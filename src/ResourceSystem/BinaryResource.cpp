@@ -0,0 +1,43 @@
+#include "Common.h"
+#include "BinaryResource.h"
+
+using namespace ResourceSystem;
+
+ResourcePtr BinaryResource::CreateMe(void)
+{
+	return ResourcePtr(new BinaryResource());
+}
+
+BinaryResource::~BinaryResource(void)
+{
+	mData.Release();
+}
+
+BinaryInput BinaryResource::GetInput(void)
+{
+	EnsureLoaded();
+	return BinaryInput(mData.GetData(), mData.GetSize());
+}
+
+void BinaryResource::PrepareImpl(void)
+{
+	mData.Release();
+	GetRawInputData(mData);
+}
+
+void BinaryResource::DiscardPreparedData(void)
+{
+	mData.Release();
+}
+
+size_t BinaryResource::LoadImpl(void)
+{
+	// the file was read in PrepareImpl already
+	return mData.GetSize();
+}
+
+bool BinaryResource::UnloadImpl(void)
+{
+	mData.Release();
+	return true;
+}
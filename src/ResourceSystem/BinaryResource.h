@@ -0,0 +1,49 @@
+/// @file
+/// Implementation of a resource keeping the raw content of binary files.
+
+#ifndef BinaryResource_h__
+#define BinaryResource_h__
+
+#include "Base.h"
+#include "Resource.h"
+#include "BinaryInput.h"
+#include "DataContainer.h"
+
+namespace ResourceSystem
+{
+	/// This class represents a file in a binary format which is not parsed by the resource itself. The whole file
+	/// is read into memory when the resource is loaded and its users read the data through BinaryInput.
+	class BinaryResource : public Resource
+	{
+	public:
+
+		/// Virtual destructor.
+		virtual ~BinaryResource(void);
+
+		/// Factory function.
+		static ResourcePtr CreateMe(void);
+
+		/// Returns an input reading the content of the file. The input is valid until the resource is unloaded.
+		BinaryInput GetInput(void);
+
+		/// Returns the resource type associated with this class.
+		static ResourceSystem::eResourceType GetResourceType() { return ResourceSystem::RESTYPE_BINARYRESOURCE; }
+
+		/// The file is read in PrepareImpl.
+		virtual bool IsPreparable(void) const { return true; }
+
+	protected:
+
+		virtual void PrepareImpl(void);
+		virtual void DiscardPreparedData(void);
+		virtual size_t LoadImpl(void);
+		virtual bool UnloadImpl(void);
+
+	private:
+
+		/// Content of the file.
+		DataContainer mData;
+	};
+}
+
+#endif // BinaryResource_h__
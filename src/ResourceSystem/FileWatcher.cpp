@@ -0,0 +1,163 @@
+#include "Common.h"
+#include "FileWatcher.h"
+#include <boost/filesystem.hpp>
+
+#if defined(__UNIX__) && defined(__linux__)
+#define USE_INOTIFY
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+using namespace ResourceSystem;
+
+#ifdef USE_INOTIFY
+/// Events the watcher is interested in.
+const uint32 WATCHED_EVENTS = IN_CREATE | IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+#endif
+
+ResourceSystem::FileWatcher::FileWatcher( void ):
+	mInotifyDescriptor(-1),
+	mChangesLost(false)
+{
+#ifdef USE_INOTIFY
+	mInotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (mInotifyDescriptor < 0) ocWarning << "Can't initialize inotify; resource files will be polled for changes";
+#endif
+}
+
+ResourceSystem::FileWatcher::~FileWatcher( void )
+{
+#ifdef USE_INOTIFY
+	if (mInotifyDescriptor >= 0) close(mInotifyDescriptor);
+#endif
+}
+
+void ResourceSystem::FileWatcher::AddDirectory( const string& path )
+{
+	if (!IsEventDriven()) return;
+	OC_ASSERT_MSG(!path.empty() && path[path.size()-1] == '/', "Watched path must end with a slash");
+	AddWatch(path);
+}
+
+void ResourceSystem::FileWatcher::Clear( void )
+{
+#ifdef USE_INOTIFY
+	for (WatchMap::iterator it=mWatches.begin(); it!=mWatches.end(); ++it)
+	{
+		inotify_rm_watch(mInotifyDescriptor, it->first);
+	}
+#endif
+	mWatches.clear();
+	mChangesLost = false;
+}
+
+void ResourceSystem::FileWatcher::AddWatch( const string& path )
+{
+#ifdef USE_INOTIFY
+	int32 wd = inotify_add_watch(mInotifyDescriptor, path.c_str(), WATCHED_EVENTS);
+	if (wd < 0)
+	{
+		ocWarning << "Can't watch directory '" << path << "' for changes";
+		mChangesLost = true;
+		return;
+	}
+	mWatches[wd] = path;
+
+	try
+	{
+		boost::filesystem::directory_iterator iend;
+		for (boost::filesystem::directory_iterator i(path); i!=iend; ++i)
+		{
+			if (boost::filesystem::is_directory(i->status()) && i->path().filename().compare(".svn") != 0)
+			{
+				AddWatch(path + i->path().filename() + "/");
+			}
+		}
+	}
+	catch (boost::exception&)
+	{
+		// the directory disappeared in the meantime; the watch reports it
+	}
+#else
+	OC_UNUSED(path);
+#endif
+}
+
+void ResourceSystem::FileWatcher::RemoveWatches( const string& pathPrefix )
+{
+#ifdef USE_INOTIFY
+	for (WatchMap::iterator it=mWatches.begin(); it!=mWatches.end(); )
+	{
+		if (it->second.compare(0, pathPrefix.length(), pathPrefix) == 0)
+		{
+			inotify_rm_watch(mInotifyDescriptor, it->first);
+			mWatches.erase(it++);
+		}
+		else ++it;
+	}
+#else
+	OC_UNUSED(pathPrefix);
+#endif
+}
+
+bool ResourceSystem::FileWatcher::GetChanges( PathSet& changedPaths )
+{
+#ifdef USE_INOTIFY
+	if (!IsEventDriven()) return false;
+
+	const size_t bufferSize = 16 * 1024;
+	char buffer[bufferSize] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+
+	for (;;)
+	{
+		ssize_t length = read(mInotifyDescriptor, buffer, bufferSize);
+		if (length <= 0) break;
+
+		for (char* ptr = buffer; ptr < buffer + length; )
+		{
+			const struct inotify_event* event = (const struct inotify_event*)ptr;
+			ptr += sizeof(struct inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW)
+			{
+				mChangesLost = true;
+				continue;
+			}
+
+			WatchMap::iterator watchIt = mWatches.find(event->wd);
+			if (watchIt == mWatches.end()) continue;
+
+			if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
+			{
+				// the directory itself is gone; its parent reports it as a changed entry
+				if (!(event->mask & IN_IGNORED)) inotify_rm_watch(mInotifyDescriptor, event->wd);
+				mWatches.erase(watchIt);
+				continue;
+			}
+			if (event->len == 0) continue;
+
+			string changedPath = watchIt->second + event->name;
+			changedPaths.insert(changedPath);
+
+			// the watches follow the moved directories, so they are removed with the old path and the new directories
+			// are watched with the new one
+			if ((event->mask & IN_ISDIR) && (event->mask & (IN_DELETE | IN_MOVED_FROM)))
+			{
+				RemoveWatches(changedPath + "/");
+			}
+			if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO)) && strcmp(event->name, ".svn") != 0)
+			{
+				AddWatch(changedPath + "/");
+			}
+		}
+	}
+
+	bool result = !mChangesLost;
+	mChangesLost = false;
+	return result;
+#else
+	OC_UNUSED(changedPaths);
+	return false;
+#endif
+}
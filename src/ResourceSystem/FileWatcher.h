@@ -0,0 +1,58 @@
+/// @file
+/// Notifications of changes of files in watched directories.
+
+#ifndef FileWatcher_h__
+#define FileWatcher_h__
+
+#include "Base.h"
+
+namespace ResourceSystem
+{
+	/// Watches directories for changes of the files inside them. The changes are collected from the operating system
+	/// as they happen and coalesced, so each changed path is reported only once no matter how many times it changed.
+	/// @remarks
+	/// Event driven watching is implemented with inotify on Linux. On other platforms the watcher is not event driven
+	/// and the directories must be polled by the user instead.
+	class FileWatcher
+	{
+	public:
+
+		typedef set<string> PathSet;
+
+		/// Constructor.
+		FileWatcher(void);
+
+		/// Destructor.
+		~FileWatcher(void);
+
+		/// Returns true if the watcher is notified about the changes. Otherwise the directories must be polled.
+		inline bool IsEventDriven(void) const { return mInotifyDescriptor >= 0; }
+
+		/// Starts watching the directory and all its subdirectories. The path must end with a slash.
+		/// The reported paths are composed from this path and the names of the subdirectories and files.
+		void AddDirectory(const string& path);
+
+		/// Stops watching all directories.
+		void Clear(void);
+
+		/// Appends the paths of all files and directories changed since the last call to the set. A moved or deleted
+		/// directory is reported only by its own path, not by the paths of the files inside.
+		/// Returns false if some changes were lost and the directories must be checked completely.
+		bool GetChanges(PathSet& changedPaths);
+
+	private:
+		typedef hash_map<int32, string> WatchMap;
+
+		int32 mInotifyDescriptor;
+		WatchMap mWatches;
+		bool mChangesLost;
+
+		/// Adds a watch to the single directory and its subdirectories.
+		void AddWatch(const string& path);
+
+		/// Removes the watches of the directories with paths starting with the prefix.
+		void RemoveWatches(const string& pathPrefix);
+	};
+}
+
+#endif // FileWatcher_h__
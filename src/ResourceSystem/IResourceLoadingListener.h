@@ -30,6 +30,9 @@ namespace ResourceSystem
 		/// Called when the resource which previously started loading is now loaded.
         virtual void ResourceLoadEnded(void) = 0;
 
+		/// Called repeatedly while a group is waiting for the resources loaded in background.
+		virtual void ResourceGroupLoadProgress(uint32 loadedCount, uint32 resourceCount) = 0;
+
 		/// Called when a group of resources is done with loading.
 		virtual void ResourceGroupLoadEnded(void) = 0;
 	};
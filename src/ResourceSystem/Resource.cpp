@@ -3,7 +3,7 @@
 #include <boost/filesystem/fstream.hpp>
 #include "Resource.h"
 #include "DataContainer.h"
-#include <cstring>
+#include <climits>
 
 using namespace ResourceSystem;
 
@@ -14,6 +14,10 @@ Resource::Resource():
 	mIsManual(false),
 	mState(STATE_UNINITIALIZED),
 	mSizeInBytes(0),
+	mPrepareState(PS_NONE),
+	mPrevLoaded(0),
+	mNextLoaded(0),
+	mIsInLoadedList(false),
 	mInputFileStream(0)
 
 {
@@ -77,7 +81,17 @@ bool Resource::Load()
 	gResourceMgr._NotifyResourceLoadingStarted(this);
 
 	SetState(STATE_LOADING);
-	ocTrace << "Loading resource '" << mName << "'";
+	ocChannelTrace(LC_RESOURCES) << "Loading resource '" << mName << "'";
+	if (mPrepareState != PS_NONE)
+	{
+		// the resource was queued for loading in background
+		gResourceMgr._FinishPreparing(this);
+	}
+	else if (IsPreparable())
+	{
+		PrepareImpl();
+	}
+	// the file info must not be read while a worker may still be reading the file
 	RefreshResourceInfo();
 	mSizeInBytes = LoadImpl();
 	bool loadSuccessful = mSizeInBytes != 0;
@@ -87,7 +101,7 @@ bool Resource::Load()
 			SetState(STATE_LOADED);
 		else
 			SetState(STATE_MISSING_LOADED);
-		ocInfo << "Resource '" << mName << "' loaded";
+		ocChannelInfo(LC_RESOURCES) << "Resource '" << mName << "' loaded";
 		// make sure the resource mgr is synchronized
 		gResourceMgr._NotifyResourceLoaded(this);
 	}
@@ -107,6 +121,8 @@ bool Resource::Unload(bool allowManual)
 	  ocError << "Resource '" << mName << "' is NOT initialized!";
 	  return false;
 	}
+	// the resource must not be loaded from background anymore
+	if (mPrepareState != PS_NONE) gResourceMgr._CancelPreparing(this);
 	// make sure the resource mgr is synchronized
 	gResourceMgr._NotifyResourceUnloaded(this);
 	if (GetState() == STATE_INITIALIZED)
@@ -117,7 +133,7 @@ bool Resource::Unload(bool allowManual)
 		return false; // we can't unload manual resources as we won't be able to reload them later
 	}
 	SetState(STATE_UNLOADING);
-	ocTrace << "Unloading resource '" << mName << "'";
+	ocChannelTrace(LC_RESOURCES) << "Unloading resource '" << mName << "'";
 	bool result = UnloadImpl();
 	SetState(STATE_INITIALIZED);
 	if (!result)
@@ -127,7 +143,7 @@ bool Resource::Unload(bool allowManual)
 	}
 	else
 	{
-		ocInfo << "Resource '" << mName << "' unloaded";
+		ocChannelInfo(LC_RESOURCES) << "Resource '" << mName << "' unloaded";
 	}
 	return result;
 }
@@ -143,6 +159,7 @@ void ResourceSystem::Resource::EnsureLoaded( void )
 	{
 		++sLastUsedTime;
 		mLastUsedTime = sLastUsedTime;
+		if (mIsInLoadedList) gResourceMgr._NotifyResourceUsed(this);
 	}
 
 	// if the resource is not load it, then load it
@@ -166,42 +183,49 @@ bool ResourceSystem::Resource::GetRawInputData( DataContainer& outData )
 
 bool ResourceSystem::Resource::GetRawInputData( const string filePath, DataContainer& outData )
 {
-	// The data is read in small chunks and the resulting buffer is then composed by merging the chunks together.
+	// The buffer is allocated for the whole file at once and the file is read by a single call.
 
 	outData.Release();
-	vector<uint8*> tmps;
-	const uint32 tmpMaxSize = 2048; // size of one tmp buffer
-	uint32 tmpLastSize = 0; // size of the last tmp buffer in the vector
-	uint32 bufferSize = 0; // resulting size
 	InputStream* is = OpenInputStream(filePath, ISM_BINARY);
 
 	if (is == NULL)
 		return false;
 
-	while (is->good())
+	is->seekg(0, std::ios::end);
+	std::streamoff fileSize = is->tellg();
+	is->seekg(0, std::ios::beg);
+	if (fileSize < 0 || fileSize > INT_MAX)
 	{
-		uint8* tmpBuf = new uint8[tmpMaxSize];
-		is->read((char*)tmpBuf, tmpMaxSize);
-		tmpLastSize = is->gcount();
-		bufferSize += tmpLastSize;
-		tmps.push_back(tmpBuf);
+		ocError << "Can't determine the size of file '" << filePath << "'";
+		CloseInputStream();
+		return false;
 	}
+
+	uint8* buffer = new uint8[(size_t)fileSize];
+	is->read((char*)buffer, (std::streamsize)fileSize);
+	int32 bufferSize = (int32)is->gcount();
 	CloseInputStream();
-	uint8* buffer = new uint8[bufferSize];
-	uint8* lastBufferPos = buffer;
-	int32 numBufs = tmps.size();
-	for (int32 i=0; i<numBufs; ++i)
-	{
-		uint32 copyCount = i==numBufs-1 ? tmpLastSize : tmpMaxSize;
-		memcpy(lastBufferPos, tmps[i], copyCount);
-		lastBufferPos += copyCount;
-		delete[] tmps[i];
-	}
-	OC_ASSERT(buffer+bufferSize == lastBufferPos);
+
+	// the file may have been truncated meanwhile
+	OC_ASSERT(bufferSize <= fileSize);
 	outData.SetData(buffer, bufferSize);
 	return true;
 }
 
+bool ResourceSystem::Resource::MapRawInputData( DataContainer& outData )
+{
+	return MapRawInputData(mFilePath, outData);
+}
+
+bool ResourceSystem::Resource::MapRawInputData( const string filePath, DataContainer& outData )
+{
+	OC_ASSERT(mState != STATE_UNINITIALIZED);
+
+	// empty files can't be mapped and some file systems don't support mapping, so they are read instead
+	if (outData.MapFile(filePath)) return true;
+	return GetRawInputData(filePath, outData);
+}
+
 bool ResourceSystem::Resource::Refresh( void )
 {
 	if (!boost::filesystem::exists(mFilePath))
@@ -209,7 +233,7 @@ bool ResourceSystem::Resource::Refresh( void )
 		if ((GetState() == STATE_MISSING)||(GetState() == STATE_MISSING_LOADED))
 			return true;
 
-		ocInfo << "Resource file " << mFilePath << " went missing. Unloading the resource.";
+		ocChannelInfo(LC_RESOURCES) << "Resource file " << mFilePath << " went missing. Unloading the resource.";
 		if (GetState() == STATE_LOADED)
 		{
 			Unload();
@@ -235,7 +259,7 @@ bool ResourceSystem::Resource::Refresh( void )
 	}
 	if (currentWriteTime > mLastWriteTime)
 	{
-		ocInfo << "Refreshing resource " << mName << " from " << mFilePath;
+		ocChannelInfo(LC_RESOURCES) << "Refreshing resource " << mName << " from " << mFilePath;
 		Reload();
 		mLastWriteTime = currentWriteTime;
 	}
@@ -96,6 +96,9 @@ namespace ResourceSystem
 		/// Returns base path type of this resource.
 		inline eBasePathType GetBasePathType(void) const { return mBasePathType; }
 
+		/// Returns true if the resource does a part of its loading in PrepareImpl, so it can be loaded in background.
+		virtual bool IsPreparable(void) const { return false; }
+
 
 	protected:
 
@@ -106,6 +109,14 @@ namespace ResourceSystem
 		/// indicating there was a problem with the load.
 		virtual size_t LoadImpl(void) = 0;
 
+		/// Called before LoadImpl if the resource is preparable. It may be called from a worker thread, so only the data
+		/// of this resource can be touched here. Put the file reading and decoding inside the implementation and leave
+		/// everything which needs the renderer, the GUI, the script engine or other resources for LoadImpl.
+		virtual void PrepareImpl(void) {}
+
+		/// Called if the resource was prepared, but it won't be loaded after all. Free the prepared data here.
+		virtual void DiscardPreparedData(void) {}
+
 		/// Called whenever the resource is to be unloaded.
 		/// Put your custom code inside the	implementation. You can use the OpenInputStream, CloseInputStream and
 		/// GetRawInputData methods from inside them.
@@ -133,6 +144,18 @@ namespace ResourceSystem
 		/// Returns true if successfull.
 		bool GetRawInputData(const string filePath, DataContainer& outData);
 
+		/// Returns raw data of the resource file mapped read-only into the memory, so it's not copied at all. If the file
+		/// can't be mapped, it's read by GetRawInputData instead. The data must not be modified and it should be released
+		/// as soon as possible, because the file may be locked while it's mapped.
+		/// @remarks Use it only for files which are not modified while the game runs (textures, meshes, caches). If
+		/// a mapped file is truncated while it's being read, the process is killed on Linux (SIGBUS). Editable text
+		/// resources (scripts, strings) must use GetRawInputData.
+		/// Returns true if successfull.
+		bool MapRawInputData(DataContainer& outData);
+
+		/// Returns raw data of the file from the filePath mapped read-only into the memory. See MapRawInputData.
+		bool MapRawInputData(const string filePath, DataContainer& outData);
+
 		/// Call this whenever you need to make sure the data is loaded.
 		void EnsureLoaded(void);
 
@@ -154,6 +177,23 @@ namespace ResourceSystem
 		size_t mSizeInBytes;
 		eBasePathType mBasePathType;
 
+		/// State of the preparation of the resource in the background.
+		enum ePrepareState
+		{
+			PS_NONE=0,
+			PS_QUEUED,
+			PS_PREPARING,
+			PS_PREPARED
+		};
+
+		friend class BackgroundLoader;
+		ePrepareState mPrepareState;
+
+		/// Neighbours in the list of loaded resources kept by the ResourceMgr ordered by the last use.
+		Resource* mPrevLoaded;
+		Resource* mNextLoaded;
+		bool mIsInLoadedList;
+
 		/// Used by the implementation of OpenInputStream.
 		boost::filesystem::ifstream* mInputFileStream;
 
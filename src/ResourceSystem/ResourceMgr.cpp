@@ -4,6 +4,8 @@
 #include <boost/regex.hpp>
 #include "ResourceMgr.h"
 #include "IResourceLoadingListener.h"
+#include "BackgroundLoader.h"
+#include "FileWatcher.h"
 
 #include "GfxSystem/Texture.h"
 #include "GfxSystem/Mesh.h"
@@ -13,6 +15,7 @@
 #include "ScriptSystem/ScriptResource.h"
 #include "Core/Project.h"
 #include "UnknownResource.h"
+#include "BinaryResource.h"
 
 #ifdef __WIN__
 #pragma warning(disable: 4996)
@@ -25,9 +28,65 @@ ResourceTypeMap ResourceMgr::NullResourceTypeMap;
 const uint64 RESOURCE_UPDATES_DELAY_MILLIS = 500;
 const uint64 REFRESH_PATH_DELAY_MILIS = 777;
 
+/// Number of threads preparing resources in background.
+const int32 BACKGROUND_LOADING_THREADS = 3;
+
+/// Time in milliseconds between progress reports while waiting for the resources loaded in background.
+const uint32 BACKGROUND_LOADING_WAIT = 20;
+
+/// Returns the path with forward slashes and without empty, "." and redundant ".." components, so that different
+/// spellings of the same path compare equal.
+static string GetCanonicalPath(const string& path)
+{
+	vector<string> components;
+	size_t begin = 0;
+	while (begin <= path.size())
+	{
+		size_t end = path.find_first_of("/\\", begin);
+		if (end == string::npos) end = path.size();
+		string component = path.substr(begin, end - begin);
+		if (component == "..")
+		{
+			if (!components.empty() && components.back() != "..") components.pop_back();
+			else components.push_back(component);
+		}
+		else if (!component.empty() && component != ".")
+		{
+			components.push_back(component);
+		}
+		begin = end + 1;
+	}
+
+	string result = (!path.empty() && (path[0] == '/' || path[0] == '\\')) ? "/" : "";
+	for (size_t i=0; i<components.size(); ++i)
+	{
+		if (i > 0) result += '/';
+		result += components[i];
+	}
+	return result;
+}
+
+/// Returns true if the path or one of the directories containing it is in the set.
+static bool IsPathOrParentInSet(const string& path, const FileWatcher::PathSet& paths)
+{
+	if (paths.find(path) != paths.end()) return true;
+	for (size_t slash = path.find('/', 1); slash != string::npos; slash = path.find('/', slash + 1))
+	{
+		if (paths.find(path.substr(0, slash)) != paths.end()) return true;
+	}
+	return false;
+}
+
 ResourceMgr::ResourceMgr( void ):
-	mBasePath(), mListener(0), mResourceUpdatesTimer(false), mMemoryLimit(0), mMemoryUsage(0), mEnforceMemoryLimit(true)
+	mBasePath(), mListener(0), mBackgroundLoader(0), mFileWatcher(0), mResourceUpdatesTimer(false), mMemoryLimit(0), mMemoryUsage(0), mEnforceMemoryLimit(true)
 {
+	for (int32 i=0; i<NUM_RESTYPES; ++i)
+	{
+		mTypeMemoryLimit[i] = std::numeric_limits<size_t>::max();
+		mTypeMemoryUsage[i] = 0;
+		mLoadedResources[i].first = 0;
+		mLoadedResources[i].last = 0;
+	}
 }
 
 void ResourceSystem::ResourceMgr::Init( const string& systemPath )
@@ -46,6 +105,7 @@ void ResourceSystem::ResourceMgr::Init( const string& systemPath )
 	mResourceCreationMethods[RESTYPE_TEXTRESOURCE] = StringSystem::TextResource::CreateMe;
 	mResourceCreationMethods[RESTYPE_XMLRESOURCE] = XMLResource::CreateMe;
 	mResourceCreationMethods[RESTYPE_SCRIPTRESOURCE] = ScriptSystem::ScriptResource::CreateMe;
+	mResourceCreationMethods[RESTYPE_BINARYRESOURCE] = BinaryResource::CreateMe;
 	mResourceCreationMethods[RESTYPE_UNKNOWN] = ResourceSystem::UnknownResource::CreateMe;
 	mExtToTypeMap["png"] = RESTYPE_TEXTURE;
 	mExtToTypeMap["bmp"] = RESTYPE_TEXTURE;
@@ -66,6 +126,7 @@ void ResourceSystem::ResourceMgr::Init( const string& systemPath )
 	mExtToTypeMap["str"] = RESTYPE_TEXTRESOURCE;
 	mExtToTypeMap["xml"] = RESTYPE_XMLRESOURCE;
 	mExtToTypeMap["as"] = RESTYPE_SCRIPTRESOURCE;
+	mExtToTypeMap["bin"] = RESTYPE_BINARYRESOURCE;
 
 	OC_ASSERT_MSG(mResourceCreationMethods[NUM_RESTYPES-1], "Not all resource types are registered");
 
@@ -76,12 +137,17 @@ void ResourceSystem::ResourceMgr::Init( const string& systemPath )
 	Resource::ResetLastUsedTime();
 
 	ocInfo << "All resource types registered";
+
+	mBackgroundLoader = new BackgroundLoader(BACKGROUND_LOADING_THREADS);
+	mFileWatcher = new FileWatcher();
 }
 
 ResourceMgr::~ResourceMgr()
 {
 	DeleteAllResources();
 	OC_ASSERT_MSG(mMemoryUsage==0, "Seems like we didn't unload some resources");
+	delete mBackgroundLoader;
+	delete mFileWatcher;
 }
 
 void ResourceMgr::UnloadAllResources()
@@ -101,7 +167,7 @@ bool ResourceMgr::AddResourceDirToGroup(const eBasePathType basePathType, const
 	else 
 		boostPath = mBasePath[basePathType] + path;
 
-	ocInfo << "Adding dir '" << boostPath << "' to group '" << group << "'";
+	ocChannelInfo(LC_RESOURCES) << "Adding dir '" << boostPath << "' to group '" << group << "'";
 
 	// check the path
 	if (!boost::filesystem::exists(boostPath))
@@ -186,11 +252,11 @@ bool ResourceMgr::AddResourceFileToGroup(const string& filepath, const StringKey
 	string dirStr = boostPath.filename();
 	if (dirStr.compare("Thumbs.db") == 0)
 	{
-		ocInfo << "Resource '" << boostPath << "' ignored";
+		ocChannelInfo(LC_RESOURCES) << "Resource '" << boostPath << "' ignored";
 		return false;
 	}
 	
-	ocTrace << "Adding resource '" << boostPath << "' to group '" << group << "'";
+	ocChannelTrace(LC_RESOURCES) << "Adding resource '" << boostPath << "' to group '" << group << "'";
 	if (!boost::filesystem::exists(boostPath))
 	{
 		ocWarning << "Resource located at '" << boostPath.string() << "' not found";
@@ -230,13 +296,13 @@ bool ResourceMgr::AddResourceFileToGroup(const string& filepath, const StringKey
 
 	AddResourceToGroup(group, name, r);
 
-	ocInfo << "Resource '" << name << "' added to group '" << group << "'.";
+	ocChannelInfo(LC_RESOURCES) << "Resource '" << name << "' added to group '" << group << "'.";
 	return true;
 }
 
 bool ResourceSystem::ResourceMgr::AddManualResourceToGroup( const StringKey& name, const StringKey& group, eResourceType type )
 {
-    ocTrace << "Manually adding resource '" << name << "' to group '" << group << "'";
+    ocChannelTrace(LC_RESOURCES) << "Manually adding resource '" << name << "' to group '" << group << "'";
 
 	OC_ASSERT_MSG(type != RESTYPE_AUTODETECT, "Must specify resource type when creating it manually");
 
@@ -249,7 +315,7 @@ bool ResourceSystem::ResourceMgr::AddManualResourceToGroup( const StringKey& nam
 
 	AddResourceToGroup(group, name, r);
 
-	ocInfo << "Resource '" << name << "' added";
+	ocChannelInfo(LC_RESOURCES) << "Resource '" << name << "' added";
 	return true;
 }
 
@@ -323,7 +389,7 @@ bool ResourceMgr::RefreshPathToGroup(const string& path, const eBasePathType bas
 
 void ResourceMgr::LoadResourcesInGroup(const StringKey& group)
 {
-	ocTrace << "Loading resource group '" << group << "'";
+	ocChannelTrace(LC_RESOURCES) << "Loading resource group '" << group << "'";
 
 	ResourceGroupMap::const_iterator gi = mResourceGroups.find(group);
 
@@ -334,23 +400,101 @@ void ResourceMgr::LoadResourcesInGroup(const StringKey& group)
 	}
 
 	const ResourceMap& resmap = *gi->second;
-	if (mListener) mListener->ResourceGroupLoadStarted(group.ToString(), static_cast<uint32>(resmap.size()));
+	uint32 resourceCount = static_cast<uint32>(resmap.size());
+	if (mListener) mListener->ResourceGroupLoadStarted(group.ToString(), resourceCount);
+
+	// the preparable resources are prepared in background while the others are loaded
+	vector<ResourcePtr> preparedResources;
 	for (ResourceMap::const_iterator ri = resmap.begin(); ri != resmap.end(); ++ri)
 	{
-		if (ri->second->GetState() == Resource::STATE_INITIALIZED)
+		if (ri->second->GetState() == Resource::STATE_INITIALIZED && mBackgroundLoader->QueueResource(ri->second))
+		{
+			preparedResources.push_back(ri->second);
+		}
+	}
+	for (ResourceMap::const_iterator ri = resmap.begin(); ri != resmap.end(); ++ri)
+	{
+		if (ri->second->GetState() == Resource::STATE_INITIALIZED && ri->second->mPrepareState == Resource::PS_NONE)
 		{
 			// callbacks to the listener are handled in the Load() method
 			ri->second->Load();
 		}
 	}
+
+	// finish loading of the prepared resources as they come
+	while (!preparedResources.empty())
+	{
+		if (ProcessPreparedResources() == 0)
+		{
+			mBackgroundLoader->WaitForPreparedResource(BACKGROUND_LOADING_WAIT);
+		}
+		for (size_t i=0; i<preparedResources.size(); )
+		{
+			if (preparedResources[i]->mPrepareState == Resource::PS_NONE)
+			{
+				preparedResources[i] = preparedResources.back();
+				preparedResources.pop_back();
+			}
+			else ++i;
+		}
+		if (mListener) mListener->ResourceGroupLoadProgress(resourceCount - preparedResources.size(), resourceCount);
+	}
 	if (mListener) mListener->ResourceGroupLoadEnded();
 
-	ocTrace << "Resource group loaded '" << group << "'";
+	ocChannelTrace(LC_RESOURCES) << "Resource group loaded '" << group << "'";
+}
+
+void ResourceMgr::LoadResourcesInGroupAsync(const StringKey& group)
+{
+	ocChannelTrace(LC_RESOURCES) << "Loading resource group '" << group << "' in background";
+
+	ResourceGroupMap::const_iterator gi = mResourceGroups.find(group);
+
+	if (gi==mResourceGroups.end())
+	{
+		ocError << "Unknown group '" << group << "'";
+		return;
+	}
+
+	const ResourceMap& resmap = *gi->second;
+	for (ResourceMap::const_iterator ri = resmap.begin(); ri != resmap.end(); ++ri)
+	{
+		if (ri->second->GetState() == Resource::STATE_INITIALIZED)
+		{
+			mBackgroundLoader->QueueResource(ri->second);
+		}
+	}
+}
+
+uint32 ResourceMgr::ProcessPreparedResources(void)
+{
+	uint32 processedCount = 0;
+	ResourcePtr res = mBackgroundLoader->PopPreparedResource();
+	while (res)
+	{
+		Resource::eState state = res->GetState();
+		if (state == Resource::STATE_INITIALIZED || state == Resource::STATE_MISSING)
+		{
+			res->Load();
+		}
+		else if (res->mPrepareState != Resource::PS_NONE)
+		{
+			mBackgroundLoader->CancelResource(res.get());
+		}
+		++processedCount;
+		res = mBackgroundLoader->PopPreparedResource();
+	}
+	return processedCount;
+}
+
+uint32 ResourceMgr::GetBackgroundLoadingCount(void) const
+{
+	return mBackgroundLoader ? mBackgroundLoader->GetPendingResourcesCount() : 0;
 }
 
 void ResourceMgr::UnloadResourcesInGroup(const StringKey& group, bool allowManual)
 {
-	ocTrace << "Unloading resource group '" << group << "'";
+	ocChannelTrace(LC_RESOURCES) << "Unloading resource group '" << group << "'";
 
 	ResourceGroupMap::const_iterator gi = mResourceGroups.find(group);
 
@@ -362,10 +506,10 @@ void ResourceMgr::UnloadResourcesInGroup(const StringKey& group, bool allowManua
 
 	const ResourceMap& resmap = *gi->second;
 	for (ResourceMap::const_iterator ri = resmap.begin(); ri != resmap.end(); ++ri)
-		if (ri->second->GetState() >= Resource::STATE_LOADING)
+		if (ri->second->GetState() >= Resource::STATE_LOADING || ri->second->mPrepareState != Resource::PS_NONE)
 			ri->second->Unload(allowManual);
 
-	ocTrace << "Resource group '" << group << "' unloaded";
+	ocChannelTrace(LC_RESOURCES) << "Resource group '" << group << "' unloaded";
 }
 
 void ResourceMgr::DeleteGroup(const StringKey& group)
@@ -448,7 +592,7 @@ void ResourceMgr::GetResources(vector<ResourcePtr>& output, eBasePathType basePa
 
 void ResourceSystem::ResourceMgr::DeleteResource( const StringKey& group, const StringKey& name )
 {
-	ocTrace << "Deleting resource '" << name << "' in group '" << group << "'";
+	ocChannelTrace(LC_RESOURCES) << "Deleting resource '" << name << "' in group '" << group << "'";
 
 	ResourceGroupMap::iterator gi = mResourceGroups.find(group);
 
@@ -468,7 +612,7 @@ void ResourceSystem::ResourceMgr::DeleteResource( const StringKey& group, const
 	ri->second->Unload(true);
 	resmap.erase(ri);
 
-	ocInfo << "Resource deleted";
+	ocChannelInfo(LC_RESOURCES) << "Resource deleted";
 }
 
 ResourceSystem::ResourcePtr ResourceSystem::ResourceMgr::GetResource( const char* groupSlashName )
@@ -500,15 +644,16 @@ bool ResourceSystem::ResourceMgr::RefreshAllResources( void )
 	{
 		ResourceMap* resMap = groupIter->second;
 		OC_ASSERT(resMap);
-		for (ResourceMap::iterator resIter=resMap->begin(); resIter!=resMap->end(); ++resIter)
+		for (ResourceMap::iterator resIter=resMap->begin(); resIter!=resMap->end(); )
 		{
 			if (!resIter->second->Refresh())
 			{
 				resIter->second->Unload(true);
-				ocInfo << "Deleting resource " << resIter->second->GetName() << " from resource manager.";
-				resMap->erase(resIter);
-				return true;
+				ocChannelInfo(LC_RESOURCES) << "Deleting resource " << resIter->second->GetName() << " from resource manager.";
+				resMap->erase(resIter++);
+				result = true;
 			}
+			else ++resIter;
 		}
 	}
 	return result;
@@ -531,11 +676,11 @@ void ResourceSystem::ResourceMgr::RefreshAllTextures( void )
 
 ResourceSystem::ResourcePtr ResourceSystem::ResourceMgr::ChangeResourceType(ResourcePtr resPointer, eResourceType newType)
 {
-	ocInfo << "Changing type of resource " << resPointer->GetName() << " to " << GetResourceTypeName(newType);
+	ocChannelInfo(LC_RESOURCES) << "Changing type of resource " << resPointer->GetName() << " to " << GetResourceTypeName(newType);
 
 	if (resPointer->GetState() >= Resource::STATE_LOADING)
 	{
-		ocInfo << "Cannot change type of resource " << resPointer->GetName() << " because it is being used.";
+		ocChannelInfo(LC_RESOURCES) << "Cannot change type of resource " << resPointer->GetName() << " because it is being used.";
 		return NULL;
 	}
 
@@ -576,6 +721,12 @@ bool ResourceSystem::ResourceMgr::CheckForResourcesUpdates( void )
 {
 	PROFILE_FNC();
 
+	if (mFileWatcher->IsEventDriven())
+	{
+		UpdateWatchedPaths();
+		return ProcessFileChanges();
+	}
+
 	uint64 currentTime = mResourceUpdatesTimer.GetMilliseconds();
 	if (currentTime - mLastResourceRefreshTime >= RESOURCE_UPDATES_DELAY_MILLIS)
 	{
@@ -589,6 +740,9 @@ bool ResourceSystem::ResourceMgr::CheckForRefreshPath( void )
 {
 	PROFILE_FNC();
 
+	// the new files are reported by the file watcher
+	if (mFileWatcher->IsEventDriven()) return false;
+
 	uint64 currentTime = mResourceUpdatesTimer.GetMilliseconds();
 	if (currentTime - mLastPathRefreshTime >= REFRESH_PATH_DELAY_MILIS)
 	{
@@ -598,16 +752,125 @@ bool ResourceSystem::ResourceMgr::CheckForRefreshPath( void )
 	return false;
 }
 
-void ResourceSystem::ResourceMgr::_NotifyResourceLoaded( const Resource* loadedResource )
+void ResourceSystem::ResourceMgr::UpdateWatchedPaths( void )
+{
+	bool changed = false;
+	for (int32 i=0; i<NUM_BASEPATHTYPES; ++i)
+	{
+		if (mWatchedPaths[i] != mBasePath[i]) changed = true;
+	}
+	if (!changed) return;
+
+	mFileWatcher->Clear();
+	for (int32 i=0; i<NUM_BASEPATHTYPES; ++i)
+	{
+		mWatchedPaths[i] = mBasePath[i];
+		if (i != BPT_ABSOLUTE && !mBasePath[i].empty()) mFileWatcher->AddDirectory(mBasePath[i]);
+	}
+}
+
+bool ResourceSystem::ResourceMgr::ProcessFileChanges( void )
+{
+	FileWatcher::PathSet reportedPaths;
+	if (!mFileWatcher->GetChanges(reportedPaths))
+	{
+		// some changes were lost, so everything must be checked
+		bool result = RefreshAllResources();
+		if (RefreshBasePathToGroup(BPT_PROJECT, "Project")) result = true;
+		return result;
+	}
+	if (reportedPaths.empty()) return false;
+
+	// the paths of the resources are composed from the base paths the same way as the reported ones, but may be
+	// spelled differently (data/./file versus data/file)
+	FileWatcher::PathSet changedPaths;
+	for (FileWatcher::PathSet::const_iterator it=reportedPaths.begin(); it!=reportedPaths.end(); ++it)
+	{
+		changedPaths.insert(GetCanonicalPath(*it));
+	}
+
+	bool result = false;
+
+	// refresh the resources of the changed files and of the files in the changed directories (a moved or deleted
+	// directory is reported only by itself); the files which went missing are deleted
+	FileWatcher::PathSet knownPaths;
+	for (ResourceGroupMap::iterator groupIter=mResourceGroups.begin(); groupIter!=mResourceGroups.end(); ++groupIter)
+	{
+		ResourceMap* resMap = groupIter->second;
+		OC_ASSERT(resMap);
+		for (ResourceMap::iterator resIter=resMap->begin(); resIter!=resMap->end(); )
+		{
+			const string filePath = GetCanonicalPath(resIter->second->GetFilePath());
+			if (!IsPathOrParentInSet(filePath, changedPaths))
+			{
+				++resIter;
+				continue;
+			}
+			knownPaths.insert(filePath);
+			if (!resIter->second->Refresh())
+			{
+				resIter->second->Unload(true);
+				ocChannelInfo(LC_RESOURCES) << "Deleting resource " << resIter->second->GetName() << " from resource manager.";
+				resMap->erase(resIter++);
+				result = true;
+			}
+			else ++resIter;
+		}
+	}
+
+	// the other changed files and directories in the project are new
+	if (mBasePath[BPT_PROJECT].empty()) return result;
+	string projectPath = GetCanonicalPath(mBasePath[BPT_PROJECT]);
+	if (!projectPath.empty()) projectPath += '/';
+	for (FileWatcher::PathSet::const_iterator it=changedPaths.begin(); it!=changedPaths.end(); ++it)
+	{
+		const string& path = *it;
+		if (knownPaths.find(path) != knownPaths.end() || path.compare(0, projectPath.length(), projectPath) != 0) continue;
+		boost::filesystem::path boostPath = path;
+		if (!boost::filesystem::exists(boostPath)) continue;
+
+		if (boost::filesystem::is_directory(boostPath))
+		{
+			if (RefreshPathToGroup(path, BPT_PROJECT, "Project")) result = true;
+		}
+		else if (boostPath.filename().compare(Core::Project::PROJECT_FILE_NAME) != 0)
+		{
+			if (AddResourceFileToGroup(path.substr(projectPath.length()), "Project", RESTYPE_AUTODETECT, BPT_PROJECT)) result = true;
+		}
+	}
+	return result;
+}
+
+void ResourceSystem::ResourceMgr::_NotifyResourceLoaded( Resource* loadedResource )
 {
 	if (mListener) mListener->ResourceLoadEnded();
-	mMemoryUsage += loadedResource->GetSize();
+	size_t size = loadedResource->GetSize();
+	mMemoryUsage += size;
+	mTypeMemoryUsage[loadedResource->GetType()] += size;
+	if (loadedResource->GetState() == Resource::STATE_LOADED && !loadedResource->IsManual())
+	{
+		// loading counts as a use, so the lists stay ordered by the time of the last use
+		loadedResource->mLastUsedTime = ++Resource::sLastUsedTime;
+		LinkLoadedResource(loadedResource);
+	}
 	CheckMemoryUsage(loadedResource);
 }
 
-void ResourceSystem::ResourceMgr::_NotifyResourceUnloaded( const Resource* unloadedResource )
+void ResourceSystem::ResourceMgr::_NotifyResourceUnloaded( Resource* unloadedResource )
 {
-	mMemoryUsage -= unloadedResource->GetSize();
+	size_t size = unloadedResource->GetSize();
+	mMemoryUsage -= size;
+	mTypeMemoryUsage[unloadedResource->GetType()] -= size;
+	if (unloadedResource->mIsInLoadedList) UnlinkLoadedResource(unloadedResource);
+}
+
+void ResourceSystem::ResourceMgr::_NotifyResourceUsed( Resource* usedResource )
+{
+	OC_DASSERT(usedResource->mIsInLoadedList);
+	// move the resource to the end of the list as it's the most recently used one now
+	if (mLoadedResources[usedResource->GetType()].last == usedResource) return;
+	UnlinkLoadedResource(usedResource);
+	LinkLoadedResource(usedResource);
 }
 
 void ResourceSystem::ResourceMgr::_NotifyResourceLoadingStarted( const Resource* loadingResource )
@@ -615,37 +878,93 @@ void ResourceSystem::ResourceMgr::_NotifyResourceLoadingStarted( const Resource*
 	if (mListener) mListener->ResourceLoadStarted(loadingResource);
 }
 
+void ResourceSystem::ResourceMgr::_FinishPreparing( Resource* res )
+{
+	mBackgroundLoader->FinishResource(res);
+}
+
+void ResourceSystem::ResourceMgr::_CancelPreparing( Resource* res )
+{
+	mBackgroundLoader->CancelResource(res);
+}
+
+void ResourceSystem::ResourceMgr::LinkLoadedResource( Resource* res )
+{
+	OC_DASSERT(!res->mIsInLoadedList);
+	LoadedResourceList& list = mLoadedResources[res->GetType()];
+	res->mPrevLoaded = list.last;
+	res->mNextLoaded = 0;
+	if (list.last) list.last->mNextLoaded = res;
+	else list.first = res;
+	list.last = res;
+	res->mIsInLoadedList = true;
+}
+
+void ResourceSystem::ResourceMgr::UnlinkLoadedResource( Resource* res )
+{
+	OC_DASSERT(res->mIsInLoadedList);
+	LoadedResourceList& list = mLoadedResources[res->GetType()];
+	if (res->mPrevLoaded) res->mPrevLoaded->mNextLoaded = res->mNextLoaded;
+	else list.first = res->mNextLoaded;
+	if (res->mNextLoaded) res->mNextLoaded->mPrevLoaded = res->mPrevLoaded;
+	else list.last = res->mPrevLoaded;
+	res->mPrevLoaded = 0;
+	res->mNextLoaded = 0;
+	res->mIsInLoadedList = false;
+}
+
+ResourceSystem::Resource* ResourceSystem::ResourceMgr::GetLeastUsedResource( const eResourceType type, const Resource* resourceToKeep ) const
+{
+	Resource* res = mLoadedResources[type].first;
+	if (res == resourceToKeep) res = res->mNextLoaded;
+	return res;
+}
+
+void ResourceSystem::ResourceMgr::EnforceTypeMemoryLimit( const eResourceType type, const Resource* resourceToKeep )
+{
+	while (mTypeMemoryUsage[type] > mTypeMemoryLimit[type])
+	{
+		Resource* leastUsedResource = GetLeastUsedResource(type, resourceToKeep);
+
+		// nothing to unload
+		if (!leastUsedResource) break;
+
+		ocChannelInfo(LC_RESOURCES) << "Unloading resource '" << leastUsedResource->GetName() << "' to stay under memory limits of " << GetResourceTypeName(type);
+		leastUsedResource->Unload();
+	}
+}
+
 void ResourceSystem::ResourceMgr::CheckMemoryUsage( const Resource* resourceToKeep )
 {
 	if (!mEnforceMemoryLimit) return;
 
-	while (mMemoryUsage > mMemoryLimit)
+	// the limits of types are checked first as they may free enough memory for the global limit
+	if (resourceToKeep)
+	{
+		EnforceTypeMemoryLimit(resourceToKeep->GetType(), resourceToKeep);
+	}
+	else
 	{
-		// find a resource to unload using the LRU strategy
-		ResourcePtr leastUsedResource(0);
-		uint64 leastUsedTime = std::numeric_limits<uint64>::max();
+		for (int32 i=0; i<NUM_RESTYPES; ++i) EnforceTypeMemoryLimit((eResourceType)i, 0);
+	}
 
-		for (ResourceGroupMap::iterator gi=mResourceGroups.begin(); gi!=mResourceGroups.end(); ++gi)
+	while (mMemoryUsage > mMemoryLimit)
+	{
+		// find a resource to unload using the LRU strategy; the oldest resource of each type is at the head of its list
+		Resource* leastUsedResource = 0;
+		for (int32 i=0; i<NUM_RESTYPES; ++i)
 		{
-			ResourceMap& resmap = *gi->second;
-			for (ResourceMap::iterator ri=resmap.begin(); ri!=resmap.end(); ++ri)
+			Resource* testedResource = GetLeastUsedResource((eResourceType)i, resourceToKeep);
+			if (testedResource && (!leastUsedResource || testedResource->GetLastUsedTime() < leastUsedResource->GetLastUsedTime()))
 			{
-				ResourcePtr testedResource = ri->second;
-				bool notToKeep = testedResource.get() != resourceToKeep;
-				bool loaded = testedResource->GetState() == Resource::STATE_LOADED;
-				bool lessUpdated = testedResource->GetLastUsedTime() < leastUsedTime;
-				if (notToKeep && loaded && lessUpdated)
-				{
-					leastUsedResource = testedResource;
-					leastUsedTime = testedResource->GetLastUsedTime();
-				}
+				leastUsedResource = testedResource;
 			}
 		}
 
 		// nothing to unload
 		if (!leastUsedResource) break;
 
-		ocInfo << "Unloading resource '" << leastUsedResource->GetName() << "' to stay under memory limits";
+		ocChannelInfo(LC_RESOURCES) << "Unloading resource '" << leastUsedResource->GetName() << "' to stay under memory limits";
 		leastUsedResource->Unload();
 	}
 }
@@ -656,6 +975,13 @@ void ResourceSystem::ResourceMgr::SetMemoryLimit( const size_t newLimit )
 	CheckMemoryUsage();
 }
 
+void ResourceSystem::ResourceMgr::SetTypeMemoryLimit( const eResourceType type, const size_t newLimit )
+{
+	OC_ASSERT(type >= 0 && type < NUM_RESTYPES);
+	mTypeMemoryLimit[type] = newLimit;
+	CheckMemoryUsage();
+}
+
 void ResourceSystem::ResourceMgr::EnableMemoryLimitEnforcing( void )
 {
 	mEnforceMemoryLimit = true;
@@ -689,7 +1015,7 @@ void ResourceSystem::ResourceMgr::RenameResource( ResourcePtr res, const string&
 	res->SetName(newName);
 	res->SetFilePath(newFilePath);
 
-	ocInfo << "Renamed resource " << oldName << " to " << newName;
+	ocChannelInfo(LC_RESOURCES) << "Renamed resource " << oldName << " to " << newName;
 }
 
 bool ResourceSystem::ResourceMgr::ResourceExists( const StringKey& group, const StringKey& name )
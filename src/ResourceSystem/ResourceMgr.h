@@ -61,8 +61,20 @@ namespace ResourceSystem
 		/// Loads all resources in the specified group.
 		/// It doesn't need to be called, resources are loaded on-the-fly if someone needs them. But it's
 		/// always better to preload them.
+		/// @remarks The preparable resources are prepared in background while the others are being loaded.
 		void LoadResourcesInGroup(const StringKey& group);
 
+		/// Starts loading the preparable resources in the specified group in background and returns immediately.
+		/// The loading is finished in ProcessPreparedResources. The other resources are loaded on-the-fly.
+		void LoadResourcesInGroupAsync(const StringKey& group);
+
+		/// Finishes loading of the resources prepared in background. Meant to be called each frame.
+		/// Returns the number of resources processed.
+		uint32 ProcessPreparedResources(void);
+
+		/// Returns the number of resources being loaded in background.
+		uint32 GetBackgroundLoadingCount(void) const;
+
 		/// Unloads all resources in the specified group, but they can be still reloaded.
 		///	@param allowManual If true, manually created resources will be unloaded as well. It is not recommended to do that!
 		void UnloadResourcesInGroup(const StringKey& group, bool allowManual = false);
@@ -94,12 +106,15 @@ namespace ResourceSystem
 
 		/// Performs a periodic test on resources to determine if they're up to date. The function is non-blocking.
 		/// The function is meant to be called each frame.
-		/// Returns true, if some resource was deleted.
+		/// Returns true, if some resource was deleted or added.
+		/// @remarks If the file system notifies about changed files, only the changed resources are refreshed and the
+		/// new files in the project are added here as well. Otherwise all resources are checked periodically.
 		bool CheckForResourcesUpdates(void);
 		
 		/// Performs a periodic test on resource path to determine if some resource has been added. 
 		/// The function is non-blocking. The function is meant to be called each frame.
 		/// Returns true, if something was added.
+		/// @remarks Does nothing if the file system notifies about changed files. See CheckForResourcesUpdates.
 		bool CheckForRefreshPath(void);
 
 		/// Loading listener receives callbacks from the manager when a resource is being loaded.
@@ -132,6 +147,19 @@ namespace ResourceSystem
 		/// Returns the current memory limit.
 		inline size_t GetMemoryLimit(void) const { return mMemoryLimit; }
 
+		/// Sets the memory limit the resources of the given type should keep in addition to the global limit.
+		/// The limit is given in bytes.
+		void SetTypeMemoryLimit(const eResourceType type, const size_t newLimit);
+
+		/// Returns the current memory limit of the resources of the given type.
+		inline size_t GetTypeMemoryLimit(const eResourceType type) const { return mTypeMemoryLimit[type]; }
+
+		/// Returns the memory used by all loaded resources.
+		inline size_t GetMemoryUsage(void) const { return mMemoryUsage; }
+
+		/// Returns the memory used by the loaded resources of the given type.
+		inline size_t GetTypeMemoryUsage(const eResourceType type) const { return mTypeMemoryUsage[type]; }
+
 		/// Enables unloading of resources when they're over the memory limit.
 		void EnableMemoryLimitEnforcing(void);
 
@@ -147,14 +175,23 @@ namespace ResourceSystem
 	public:
 
 		/// Callback from a resource after it was loaded.
-		void _NotifyResourceLoaded(const Resource* loadedResource);
+		void _NotifyResourceLoaded(Resource* loadedResource);
 
 		/// Callback from a resource after it was unloaded.
-		void _NotifyResourceUnloaded(const Resource* unloadedResource);
+		void _NotifyResourceUnloaded(Resource* unloadedResource);
+
+		/// Callback from a loaded resource when it was used.
+		void _NotifyResourceUsed(Resource* usedResource);
 
 		/// Callback from a resource before it was loaded.
 		void _NotifyResourceLoadingStarted(const Resource* loadingResource);
 
+		/// Callback from a resource queued for loading in background when it's needed to be loaded now.
+		void _FinishPreparing(Resource* res);
+
+		/// Callback from a resource queued for loading in background when it's being unloaded.
+		void _CancelPreparing(Resource* res);
+
 	private:
 
 		typedef ResourcePtr (*ResourceCreationMethod)();
@@ -162,16 +199,29 @@ namespace ResourceSystem
 		typedef map<StringKey, ResourceMap*> ResourceGroupMap;
 		typedef map<StringKey, eResourceType> ExtToTypeMap;
 
+		/// Intrusive list of loaded resources of one type. The least recently used resource is the first one.
+		struct LoadedResourceList
+		{
+			Resource* first;
+			Resource* last;
+		};
+
 		string mBasePath[NUM_BASEPATHTYPES];
 		ResourceGroupMap mResourceGroups;
 		ExtToTypeMap mExtToTypeMap;
 		IResourceLoadingListener* mListener;
+		BackgroundLoader* mBackgroundLoader;
+		FileWatcher* mFileWatcher;
+		string mWatchedPaths[NUM_BASEPATHTYPES];
 		ResourceCreationMethod mResourceCreationMethods[NUM_RESTYPES];
 		Utils::Timer mResourceUpdatesTimer;
 		uint64 mLastResourceRefreshTime;
 		uint64 mLastPathRefreshTime;
 		size_t mMemoryLimit;
 		size_t mMemoryUsage;
+		size_t mTypeMemoryLimit[NUM_RESTYPES];
+		size_t mTypeMemoryUsage[NUM_RESTYPES];
+		LoadedResourceList mLoadedResources[NUM_RESTYPES];
 		bool mEnforceMemoryLimit;
 
 		/// Adds a resource to a group given by iterator.
@@ -184,9 +234,28 @@ namespace ResourceSystem
 		/// Returns true if something was added.
 		bool RefreshPathToGroup(const string& path, const eBasePathType basePathType, const StringKey& group);
 
+		/// Makes sure the file watcher watches the current base paths.
+		void UpdateWatchedPaths(void);
+
+		/// Refreshes the resources whose files were reported as changed by the file watcher and adds the new files
+		/// in the project. Returns true if some resource was added or deleted.
+		bool ProcessFileChanges(void);
+
 		/// Checks if the memory usage is within limits. If not, some of the resources will be freed.
 		/// @param resourceToKeep This resource (if valid) will be preserved at any case.
 		void CheckMemoryUsage(const Resource* resourceToKeep = 0);
+
+		/// Unloads the least recently used resources of the type until the type is within its limit.
+		void EnforceTypeMemoryLimit(const eResourceType type, const Resource* resourceToKeep);
+
+		/// Returns the least recently used loaded resource of the type other than resourceToKeep or null if there's none.
+		Resource* GetLeastUsedResource(const eResourceType type, const Resource* resourceToKeep) const;
+
+		/// Appends the resource to the end of the list of loaded resources of its type.
+		void LinkLoadedResource(Resource* res);
+
+		/// Removes the resource from the list of loaded resources of its type.
+		void UnlinkLoadedResource(Resource* res);
 	};
 }
 
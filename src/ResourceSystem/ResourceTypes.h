@@ -17,6 +17,7 @@ namespace ResourceSystem
 		RESTYPE_TEXTRESOURCE, 
 		RESTYPE_XMLRESOURCE, 
 		RESTYPE_SCRIPTRESOURCE,
+		RESTYPE_BINARYRESOURCE,
 		RESTYPE_UNKNOWN,
 		
 		NUM_RESTYPES, 
@@ -32,6 +33,7 @@ namespace ResourceSystem
 		"Text",
 		"XML",
 		"Script",
+		"Binary",
 		"Unknown",
 
 		"NumRestypes",
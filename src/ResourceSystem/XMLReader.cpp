@@ -0,0 +1,324 @@
+#include "Common.h"
+#include "XMLReader.h"
+#include "XMLResource.h"
+#include <expat.h>
+#include <cstring>
+
+using namespace ResourceSystem;
+
+/// Maximum number of bytes passed to the parser at once. It limits the memory used by the parser itself.
+const uint32 PARSED_CHUNK_SIZE = 16 * 1024;
+
+ResourceSystem::XMLReader::XMLReader( const char* data, const uint32 size ):
+	mData(data),
+	mSize(size)
+{
+	Init();
+}
+
+ResourceSystem::XMLReader::XMLReader( const XMLResourcePtr& xml ):
+	mResource(xml)
+{
+	OC_ASSERT((bool)xml);
+	mData = xml->GetData();
+	mSize = xml->GetDataSize();
+	Init();
+}
+
+void ResourceSystem::XMLReader::Init( void )
+{
+	mParsedSize = 0;
+	mSuspended = false;
+	mStopRequested = false;
+	mFinished = false;
+	mFailed = false;
+	mPendingTextBegin = 0;
+	mBookmarkNode = 0;
+	mBookmarkSet = false;
+
+	XML_Memory_Handling_Suite mmhs;
+	mmhs.malloc_fcn = CustomMalloc;
+	mmhs.free_fcn = CustomFree;
+	mmhs.realloc_fcn = CustomRealloc;
+	mParser = XML_ParserCreate_MM(NULL, &mmhs, NULL);
+	OC_ASSERT(mParser);
+
+	XML_SetUserData(mParser, this);
+	XML_SetElementHandler(mParser, ElementStartHandler, ElementEndHandler);
+	XML_SetCharacterDataHandler(mParser, CharacterDataHandler);
+
+	// the reader is positioned before the first node
+	Node node;
+	node.type = NT_NONE;
+	node.depth = 0;
+	node.textBegin = 0;
+	node.textLength = 0;
+	node.attributesBegin = 0;
+	node.attributesCount = 0;
+	mNodes.push_back(node);
+	mCurrentNode = 0;
+}
+
+ResourceSystem::XMLReader::~XMLReader( void )
+{
+	XML_ParserFree(mParser);
+}
+
+bool ResourceSystem::XMLReader::Read( void )
+{
+	if (GetNodeType() == NT_END_OF_DOCUMENT) return false;
+
+	if (mCurrentNode + 1 < mNodes.size())
+	{
+		++mCurrentNode;
+	}
+	else
+	{
+		ParseNextNodes();
+	}
+	return GetNodeType() != NT_END_OF_DOCUMENT;
+}
+
+bool ResourceSystem::XMLReader::ReadChildElement( const uint32 parentDepth )
+{
+	// the reader may be anywhere inside the parent; whatever is deeper than its children is skipped
+	while (Read())
+	{
+		if (GetNodeType() == NT_ELEMENT && GetDepth() == parentDepth + 1) return true;
+		if (GetNodeType() == NT_END_ELEMENT && GetDepth() == parentDepth) return false;
+	}
+	return false;
+}
+
+const string& ResourceSystem::XMLReader::ReadElementText( void )
+{
+	mElementText.clear();
+	if (GetNodeType() != NT_ELEMENT) return mElementText;
+
+	const uint32 depth = GetDepth();
+	while (Read())
+	{
+		if (GetNodeType() == NT_TEXT && GetDepth() == depth + 1)
+		{
+			mElementText.append(GetText(), GetTextLength());
+		}
+		else if (GetNodeType() == NT_END_ELEMENT && GetDepth() == depth)
+		{
+			break;
+		}
+	}
+	return mElementText;
+}
+
+void ResourceSystem::XMLReader::SkipElement( void )
+{
+	if (GetNodeType() != NT_ELEMENT) return;
+
+	const uint32 depth = GetDepth();
+	while (Read())
+	{
+		if (GetNodeType() == NT_END_ELEMENT && GetDepth() == depth) break;
+	}
+}
+
+void ResourceSystem::XMLReader::SetBookmark( void )
+{
+	mBookmarkNode = mCurrentNode;
+	mBookmarkSet = true;
+}
+
+void ResourceSystem::XMLReader::ReturnToBookmark( void )
+{
+	OC_ASSERT_MSG(mBookmarkSet, "No bookmark to return to");
+	mCurrentNode = mBookmarkNode;
+}
+
+void ResourceSystem::XMLReader::ReleaseBookmark( void )
+{
+	mBookmarkSet = false;
+}
+
+const char* ResourceSystem::XMLReader::GetAttributeText( const StringKey& name ) const
+{
+	const Attribute* attribute = FindAttribute(name);
+	if (!attribute) return "";
+	return &mBuffer[attribute->valueBegin];
+}
+
+const ResourceSystem::XMLReader::Attribute* ResourceSystem::XMLReader::FindAttribute( const StringKey& name ) const
+{
+	const Node& node = mNodes[mCurrentNode];
+	if (node.type != NT_ELEMENT) return 0;
+
+	// elements have just a few attributes, so the interned names are simply compared one by one
+	for (uint32 i=node.attributesBegin; i<node.attributesBegin+node.attributesCount; ++i)
+	{
+		if (mAttributes[i].name == name) return &mAttributes[i];
+	}
+	return 0;
+}
+
+void ResourceSystem::XMLReader::ParseNextNodes( void )
+{
+	if (!mBookmarkSet)
+	{
+		// the text being collected is kept, the rest of the buffer belongs to the nodes already read
+		const uint32 pendingTextLength = mBuffer.size() - mPendingTextBegin;
+		if (pendingTextLength > 0) memmove(&mBuffer[0], &mBuffer[mPendingTextBegin], pendingTextLength);
+		mBuffer.resize(pendingTextLength);
+		mPendingTextBegin = 0;
+		mNodes.clear();
+		mAttributes.clear();
+	}
+
+	// the new nodes are appended after the ones kept for the bookmark
+	const uint32 firstNewNode = mNodes.size();
+	mCurrentNode = firstNewNode;
+
+	while (mNodes.size() == firstNewNode)
+	{
+		if (mFinished || mFailed)
+		{
+			AddEndOfDocument();
+			break;
+		}
+
+		mStopRequested = false;
+		XML_Status status;
+		if (mSuspended)
+		{
+			status = XML_ResumeParser(mParser);
+		}
+		else
+		{
+			const uint32 chunkSize = MathUtils::Min<uint32>(mSize - mParsedSize, PARSED_CHUNK_SIZE);
+			const bool isFinal = mParsedSize + chunkSize == mSize;
+			status = XML_Parse(mParser, mData + mParsedSize, chunkSize, isFinal);
+			mParsedSize += chunkSize;
+		}
+
+		switch (status)
+		{
+		case XML_STATUS_SUSPENDED:
+			mSuspended = true;
+			break;
+		case XML_STATUS_OK:
+			mSuspended = false;
+			mFinished = mParsedSize == mSize;
+			break;
+		default:
+			ocError << "XMLReader: Parse error at line " << (int32)XML_GetCurrentLineNumber(mParser) << ": " << (char*)XML_ErrorString(XML_GetErrorCode(mParser));
+			mFailed = true;
+			mNodes.resize(firstNewNode);
+			break;
+		}
+	}
+}
+
+void ResourceSystem::XMLReader::StopParser( void )
+{
+	if (mStopRequested) return;
+	XML_StopParser(mParser, XML_TRUE);
+	mStopRequested = true;
+}
+
+void ResourceSystem::XMLReader::FinishPendingText( void )
+{
+	// remove control characters and trim the text in place
+	uint32 end = mPendingTextBegin;
+	for (uint32 i=mPendingTextBegin; i<mBuffer.size(); ++i)
+	{
+		if (!iscntrl((unsigned char)mBuffer[i])) mBuffer[end++] = mBuffer[i];
+	}
+	uint32 begin = mPendingTextBegin;
+	while (begin < end && isspace((unsigned char)mBuffer[begin])) ++begin;
+	while (end > begin && isspace((unsigned char)mBuffer[end-1])) --end;
+
+	if (begin == end)
+	{
+		mBuffer.resize(mPendingTextBegin);
+		return;
+	}
+
+	Node node;
+	node.type = NT_TEXT;
+	node.depth = mOpenElements.size();
+	node.textBegin = begin;
+	node.textLength = end - begin;
+	node.attributesBegin = 0;
+	node.attributesCount = 0;
+	mBuffer.resize(end);
+	mBuffer.push_back('\0');
+	mNodes.push_back(node);
+	mPendingTextBegin = mBuffer.size();
+}
+
+void ResourceSystem::XMLReader::AddEndOfDocument( void )
+{
+	Node node;
+	node.type = NT_END_OF_DOCUMENT;
+	node.depth = 0;
+	node.textBegin = 0;
+	node.textLength = 0;
+	node.attributesBegin = 0;
+	node.attributesCount = 0;
+	mNodes.push_back(node);
+}
+
+void ResourceSystem::XMLReader::ElementStartHandler( void* userData, const char* name, const char** attributes )
+{
+	XMLReader* me = (XMLReader*)userData;
+	me->FinishPendingText();
+
+	Node node;
+	node.type = NT_ELEMENT;
+	node.name = StringKey(name);
+	node.depth = me->mOpenElements.size();
+	node.textBegin = 0;
+	node.textLength = 0;
+	node.attributesBegin = me->mAttributes.size();
+	node.attributesCount = 0;
+
+	for (int32 i=0; attributes[i]; i+=2)
+	{
+		Attribute attribute;
+		attribute.name = StringKey(attributes[i]);
+		attribute.valueBegin = me->mBuffer.size();
+		me->mBuffer.insert(me->mBuffer.end(), attributes[i+1], attributes[i+1] + strlen(attributes[i+1]) + 1);
+		me->mAttributes.push_back(attribute);
+		++node.attributesCount;
+	}
+
+	me->mNodes.push_back(node);
+	me->mOpenElements.push_back(node.name);
+	me->mPendingTextBegin = me->mBuffer.size();
+	me->StopParser();
+}
+
+void ResourceSystem::XMLReader::ElementEndHandler( void* userData, const char* name )
+{
+	OC_UNUSED(name);
+	XMLReader* me = (XMLReader*)userData;
+	me->FinishPendingText();
+	OC_ASSERT(!me->mOpenElements.empty());
+
+	// the name is taken from the start of the element, so it's not interned again
+	Node node;
+	node.type = NT_END_ELEMENT;
+	node.name = me->mOpenElements.back();
+	node.depth = me->mOpenElements.size() - 1;
+	node.textBegin = 0;
+	node.textLength = 0;
+	node.attributesBegin = 0;
+	node.attributesCount = 0;
+
+	me->mNodes.push_back(node);
+	me->mOpenElements.pop_back();
+	me->StopParser();
+}
+
+void ResourceSystem::XMLReader::CharacterDataHandler( void* userData, const char* data, int length )
+{
+	XMLReader* me = (XMLReader*)userData;
+	if (length > 0) me->mBuffer.insert(me->mBuffer.end(), data, data + length);
+}
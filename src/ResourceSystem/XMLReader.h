@@ -0,0 +1,190 @@
+/// @file
+/// Streaming reading of XML data.
+
+#ifndef XMLReader_h__
+#define XMLReader_h__
+
+#include "Base.h"
+
+struct XML_ParserStruct;
+
+namespace ResourceSystem
+{
+	/// Reads XML data node by node. The data is parsed incrementally as the nodes are requested, so no tree of the
+	/// whole document is ever built. Names of the elements and attributes are interned as string keys, while the
+	/// texts and the values of the attributes are kept in a single buffer reused for the whole document.
+	/// @remarks
+	/// The reader is positioned on a node after each successful call to Read. The texts and the values of the
+	/// attributes returned as pointers are valid only until the next call to Read. Texts are stripped of control
+	/// characters and trimmed, and the texts consisting of white spaces only are not reported at all.
+	class XMLReader
+	{
+	public:
+
+		/// Types of the nodes the reader can be positioned on.
+		enum eNodeType
+		{
+			NT_NONE,
+			NT_ELEMENT,
+			NT_END_ELEMENT,
+			NT_TEXT,
+			NT_END_OF_DOCUMENT
+		};
+
+		/// Constructs the reader of the given data. The data is not copied, so it must live as long as the reader
+		/// is used.
+		XMLReader(const char* data, const uint32 size);
+
+		/// Constructs the reader of the XML resource. The resource is kept loaded while the reader exists.
+		XMLReader(const XMLResourcePtr& xml);
+
+		/// Destructor.
+		~XMLReader(void);
+
+		/// Moves to the next node. Returns false at the end of the document or if the document is malformed.
+		bool Read(void);
+
+		/// Moves to the next element being a direct child of the element at the given depth. Returns false when
+		/// the reader reaches the end element of the parent. The children not read completely by the caller are skipped.
+		bool ReadChildElement(const uint32 parentDepth);
+
+		/// Reads the text of the current element and moves to its end element. Nested elements are skipped.
+		/// The returned string is valid until this method is called again.
+		const string& ReadElementText(void);
+
+		/// Reads the text of the current element converted to the given type and moves to its end element.
+		template<typename T>
+		inline T ReadElementValue(void) { return StringConverter::FromString<T>(ReadElementText()); }
+
+		/// Skips the rest of the current element including its children and moves to its end element.
+		void SkipElement(void);
+
+		/// Remembers the current node, so that the reader can return to it later. All nodes read after it are kept
+		/// in memory until the bookmark is released, so it should be used for small parts of the document only.
+		void SetBookmark(void);
+
+		/// Moves the reader back to the bookmarked node.
+		void ReturnToBookmark(void);
+
+		/// Releases the bookmark. The nodes kept for it are discarded as soon as the reader passes them.
+		void ReleaseBookmark(void);
+
+		/// Returns the type of the current node.
+		inline eNodeType GetNodeType(void) const { return mNodes[mCurrentNode].type; }
+
+		/// Returns true if the current node is a start of an element.
+		inline bool IsElement(void) const { return GetNodeType() == NT_ELEMENT; }
+
+		/// Returns the name of the current element or end element.
+		inline const StringKey& GetName(void) const { return mNodes[mCurrentNode].name; }
+
+		/// Returns the depth of the current node. The document element is at the depth 0.
+		inline uint32 GetDepth(void) const { return mNodes[mCurrentNode].depth; }
+
+		/// Returns the null terminated text of the current text node.
+		inline const char* GetText(void) const { return &mBuffer[mNodes[mCurrentNode].textBegin]; }
+
+		/// Returns the length of the text of the current text node.
+		inline uint32 GetTextLength(void) const { return mNodes[mCurrentNode].textLength; }
+
+		/// Returns true if the attribute of the current element exists.
+		inline bool HasAttribute(const StringKey& name) const { return FindAttribute(name) != 0; }
+
+		/// Returns the null terminated value of an attribute of the current element or an empty string if there's
+		/// no such attribute.
+		const char* GetAttributeText(const StringKey& name) const;
+
+		/// Returns the value of an attribute of the current element converted to the given type.
+		template<typename T>
+		inline T GetAttribute(const StringKey& name) const { return StringConverter::FromString<T>(GetAttributeText(name)); }
+
+		/// Returns true if the data is not a well-formed XML document.
+		inline bool HasFailed(void) const { return mFailed; }
+
+	private:
+
+		/// Information about a node parsed but not read yet.
+		struct Node
+		{
+			eNodeType type;
+			StringKey name;
+			uint32 depth;
+			uint32 textBegin;
+			uint32 textLength;
+			uint32 attributesBegin;
+			uint32 attributesCount;
+		};
+
+		/// Name and value of an attribute of an element.
+		struct Attribute
+		{
+			StringKey name;
+			uint32 valueBegin;
+		};
+
+		typedef vector<Node> NodeVector;
+		typedef vector<Attribute> AttributeVector;
+
+		XML_ParserStruct* mParser;
+		XMLResourcePtr mResource;
+		const char* mData;
+		uint32 mSize;
+		uint32 mParsedSize;
+		bool mSuspended;
+		bool mStopRequested;
+		bool mFinished;
+		bool mFailed;
+
+		/// Nodes parsed in the last run of the parser or since the bookmark was set.
+		NodeVector mNodes;
+		uint32 mCurrentNode;
+		uint32 mBookmarkNode;
+		bool mBookmarkSet;
+
+		/// Attributes of the parsed elements.
+		AttributeVector mAttributes;
+
+		/// Texts and values of the attributes of the parsed nodes, each of them null terminated.
+		vector<char> mBuffer;
+
+		/// Start of the text being collected in the buffer.
+		uint32 mPendingTextBegin;
+
+		/// Names of the elements not closed yet.
+		vector<StringKey> mOpenElements;
+
+		/// Result of ReadElementText.
+		string mElementText;
+
+		/// Creates the parser.
+		void Init(void);
+
+		/// Runs the parser until it produces at least a single node.
+		void ParseNextNodes(void);
+
+		/// Stops the parser after the handler returns, so the produced nodes can be read.
+		void StopParser(void);
+
+		/// Adds a node for the text collected in the buffer if there's any.
+		void FinishPendingText(void);
+
+		/// Adds a node for the end of the document.
+		void AddEndOfDocument(void);
+
+		/// Returns the attribute of the current element or null if it doesn't exist.
+		const Attribute* FindAttribute(const StringKey& name) const;
+
+		/// @name Expat handlers.
+		//@{
+		static void ElementStartHandler(void* userData, const char* name, const char** attributes);
+		static void ElementEndHandler(void* userData, const char* name);
+		static void CharacterDataHandler(void* userData, const char* data, int length);
+		//@}
+
+		/// Disabled.
+		XMLReader(const XMLReader& rhs);
+		XMLReader& operator=(const XMLReader& rhs);
+	};
+}
+
+#endif // XMLReader_h__
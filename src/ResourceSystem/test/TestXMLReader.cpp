@@ -0,0 +1,138 @@
+#include "Common.h"
+#include "UnitTests.h"
+#include "../XMLReader.h"
+#include <cstring>
+
+SUITE(XMLReader)
+{
+	TEST(Nodes)
+	{
+		const char* data = "<Scene><Layers Difference=\"2\" ActiveLayer=\"1\"><Layer Visible=\"false\">  first\n</Layer></Layers></Scene>";
+		ResourceSystem::XMLReader reader(data, strlen(data));
+
+		CHECK(reader.Read());
+		CHECK(reader.IsElement());
+		CHECK(reader.GetName() == StringKey("Scene"));
+		CHECK_EQUAL(0u, reader.GetDepth());
+
+		CHECK(reader.Read());
+		CHECK(reader.GetName() == StringKey("Layers"));
+		CHECK_EQUAL(1u, reader.GetDepth());
+		CHECK_EQUAL(2, reader.GetAttribute<int32>("Difference"));
+		CHECK_EQUAL("1", reader.GetAttributeText("ActiveLayer"));
+		CHECK(!reader.HasAttribute("Visible"));
+		CHECK_EQUAL("", reader.GetAttributeText("Visible"));
+
+		CHECK(reader.Read());
+		CHECK(reader.GetName() == StringKey("Layer"));
+		CHECK_EQUAL(false, reader.GetAttribute<bool>("Visible"));
+
+		CHECK(reader.Read());
+		CHECK_EQUAL(ResourceSystem::XMLReader::NT_TEXT, reader.GetNodeType());
+		CHECK_EQUAL("first", reader.GetText());
+		CHECK_EQUAL(5u, reader.GetTextLength());
+		CHECK_EQUAL(3u, reader.GetDepth());
+
+		CHECK(reader.Read());
+		CHECK_EQUAL(ResourceSystem::XMLReader::NT_END_ELEMENT, reader.GetNodeType());
+		CHECK(reader.GetName() == StringKey("Layer"));
+		CHECK_EQUAL(2u, reader.GetDepth());
+
+		CHECK(reader.Read());
+		CHECK(reader.GetName() == StringKey("Layers"));
+		CHECK(reader.Read());
+		CHECK(reader.GetName() == StringKey("Scene"));
+		CHECK_EQUAL(ResourceSystem::XMLReader::NT_END_ELEMENT, reader.GetNodeType());
+
+		CHECK(!reader.Read());
+		CHECK_EQUAL(ResourceSystem::XMLReader::NT_END_OF_DOCUMENT, reader.GetNodeType());
+		CHECK(!reader.Read());
+		CHECK(!reader.HasFailed());
+	}
+
+	TEST(ChildElements)
+	{
+		const char* data = "<Root><A><Skipped><Deep/></Skipped></A><B>12</B><C/><D>x<E>ignored</E>y</D></Root>";
+		ResourceSystem::XMLReader reader(data, strlen(data));
+
+		CHECK(reader.Read());
+		CHECK(reader.ReadChildElement(0));
+		CHECK(reader.GetName() == StringKey("A"));
+		CHECK(reader.ReadChildElement(0));
+		CHECK(reader.GetName() == StringKey("B"));
+		CHECK_EQUAL(12, reader.ReadElementValue<int32>());
+		CHECK_EQUAL(ResourceSystem::XMLReader::NT_END_ELEMENT, reader.GetNodeType());
+		CHECK(reader.ReadChildElement(0));
+		CHECK(reader.GetName() == StringKey("C"));
+		CHECK_EQUAL("", reader.ReadElementText());
+		CHECK(reader.ReadChildElement(0));
+		CHECK(reader.GetName() == StringKey("D"));
+		CHECK_EQUAL("xy", reader.ReadElementText());
+		CHECK(!reader.ReadChildElement(0));
+		CHECK(reader.GetName() == StringKey("Root"));
+		CHECK(!reader.Read());
+	}
+
+	TEST(Bookmark)
+	{
+		const char* data = "<Entity Name=\"a\"><Component Type=\"X\"><Value>1</Value></Component><Component Type=\"Y\"/></Entity>";
+		ResourceSystem::XMLReader reader(data, strlen(data));
+
+		CHECK(reader.Read());
+		reader.SetBookmark();
+		uint32 componentCount = 0;
+		while (reader.ReadChildElement(0)) ++componentCount;
+		CHECK_EQUAL(2u, componentCount);
+
+		reader.ReturnToBookmark();
+		reader.ReleaseBookmark();
+		CHECK(reader.GetName() == StringKey("Entity"));
+		CHECK_EQUAL("a", reader.GetAttributeText("Name"));
+		CHECK(reader.ReadChildElement(0));
+		CHECK_EQUAL("X", reader.GetAttributeText("Type"));
+		CHECK(reader.ReadChildElement(1));
+		CHECK_EQUAL(1, reader.ReadElementValue<int32>());
+		CHECK(!reader.ReadChildElement(1));
+		CHECK(reader.ReadChildElement(0));
+		CHECK_EQUAL("Y", reader.GetAttributeText("Type"));
+		CHECK(!reader.ReadChildElement(0));
+		CHECK(!reader.Read());
+	}
+
+	TEST(LongDocument)
+	{
+		// the document is parsed in chunks, so the texts and elements crossing the chunk boundaries must be joined
+		string data = "<Items>";
+		for (int32 i=0; i<5000; ++i)
+		{
+			data += "<Item Index=\"" + StringConverter::ToString(i) + "\">" + StringConverter::ToString(i * 2) + "</Item>";
+		}
+		data += "</Items>";
+		ResourceSystem::XMLReader reader(data.c_str(), data.size());
+
+		CHECK(reader.Read());
+		int32 count = 0;
+		bool valid = true;
+		while (reader.ReadChildElement(0))
+		{
+			valid = valid && reader.GetAttribute<int32>("Index") == count;
+			valid = valid && reader.ReadElementValue<int32>() == count * 2;
+			++count;
+		}
+		CHECK_EQUAL(5000, count);
+		CHECK(valid);
+		CHECK(!reader.HasFailed());
+	}
+
+	TEST(MalformedDocument)
+	{
+		const char* data = "<Root><A></B></Root>";
+		ResourceSystem::XMLReader reader(data, strlen(data));
+
+		CHECK(reader.Read());
+		CHECK(reader.ReadChildElement(0));
+		CHECK(!reader.ReadChildElement(1));
+		CHECK(reader.HasFailed());
+		CHECK_EQUAL(ResourceSystem::XMLReader::NT_END_OF_DOCUMENT, reader.GetNodeType());
+	}
+}
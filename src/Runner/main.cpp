@@ -59,6 +59,57 @@ DbgLib::CMemLeakDetector* gLeakDetector = 0;
 #endif
 
 
+/// Parses the command line arguments. The arguments are either the shared directory alone or the options of
+/// the headless run: --headless <project> [--frames <count>] [--delta <seconds>] [--realtime] [--shared <dir>].
+bool ParseCommandLine(int argc, char* argv[], string& sharedDir, Core::HeadlessSettings& headless)
+{
+	for (int i=1; i<argc; ++i)
+	{
+		string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--headless" && hasValue)
+		{
+			headless.enabled = true;
+			headless.projectPath = argv[++i];
+		}
+		else if (arg == "--frames" && hasValue)
+		{
+			headless.frameCount = StringConverter::FromString<uint32>(argv[++i]);
+		}
+		else if (arg == "--delta" && hasValue)
+		{
+			headless.frameDelta = StringConverter::FromString<float32>(argv[++i]);
+		}
+		else if (arg == "--realtime")
+		{
+			headless.realTime = true;
+		}
+		else if (arg == "--shared" && hasValue)
+		{
+			sharedDir = argv[++i];
+		}
+		else if (i == 1 && arg.compare(0, 2, "--") != 0)
+		{
+			sharedDir = arg;
+		}
+		else
+		{
+			fprintf(stderr, "Invalid argument: %s\n", arg.c_str());
+			fprintf(stderr, "Usage: %s [<shared dir>]\n", argv[0]);
+			fprintf(stderr, "       %s --headless <project> [--frames <count>] [--delta <seconds>] [--realtime] [--shared <dir>]\n", argv[0]);
+			return false;
+		}
+	}
+
+	if (headless.enabled && headless.frameDelta <= 0.0f)
+	{
+		fprintf(stderr, "The frame delta must be positive\n");
+		return false;
+	}
+	return true;
+}
+
+
 #ifdef __WIN__
 INT WINAPI WinMain (HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow )
 {
@@ -68,12 +119,20 @@ int main(int argc, char* argv[])
 #endif
 
 	string sharedDir;
+	Core::HeadlessSettings headless;
 
 	#ifdef __WIN__
-	sharedDir = lpCmdLine;
+	// the whole command line is the shared directory unless the headless run is requested
+	if (__argc >= 2 && string(__argv[1]) == "--headless")
+	{
+		if (!ParseCommandLine(__argc, __argv, sharedDir, headless)) return -1;
+	}
+	else
+	{
+		sharedDir = lpCmdLine;
+	}
 	#else
-	if (argc >= 2)
-		sharedDir = argv[1];
+	if (!ParseCommandLine(argc, argv, sharedDir, headless)) return -1;
 	#endif
 
 	// initialize memory
@@ -102,7 +161,7 @@ int main(int argc, char* argv[])
 	{
 		// run the application itself
 		Core::Application* app = new Core::Application();
-		app->Init(sharedDir);
+		app->Init(sharedDir, headless);
 		app->RunMainLoop();
 		delete app;
 	}
@@ -13,6 +13,9 @@
 #include "GUISystem/GUIMgr.h"
 #include "Editor/EditorMgr.h"
 #include "Editor/EditorGUI.h"
+#include "LogSystem/LogMgr.h"
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
 
 using namespace ScriptSystem;
 using namespace EntitySystem;
@@ -21,6 +24,9 @@ using namespace GUISystem;
 using namespace AngelScript;
 using namespace Core;
 
+/// Maximum number of unused contexts kept for reuse. More contexts are needed only by deeply nested script calls.
+const size_t MAX_POOLED_CONTEXTS = 16;
+
 void MessageCallback(const asSMessageInfo* msg, void* param)
 {
 	OC_UNUSED(param);
@@ -44,10 +50,24 @@ void MessageCallback(const asSMessageInfo* msg, void* param)
 	}
 }
 
-void LineCallback(asIScriptContext* ctx, uint64* deadline)
+/// Number of script lines executed between two checks of the script time out.
+const uint32 LINES_PER_TIMEOUT_CHECK = 1000;
+
+/// State of the time out of an executed script.
+struct ScriptTimeOut
+{
+	uint64 deadline;
+	uint32 linesToCheck;
+};
+
+void LineCallback(asIScriptContext* ctx, ScriptTimeOut* timeOut)
 {
+	// Reading the clock costs more than executing a line, so the time is checked only once per many lines
+	if (--timeOut->linesToCheck != 0) return;
+	timeOut->linesToCheck = LINES_PER_TIMEOUT_CHECK;
+
 	// If the time out is reached we abort the script
-	if (*deadline <= gScriptMgr.GetGlobalTime()) ctx->Abort();
+	if (timeOut->deadline <= gScriptMgr.GetGlobalTime()) ctx->Abort();
 }
 
 int ScriptMgr::IncludeCallback(const char* fileName, const char* from, AngelScript::CScriptBuilder* builder, void* userParam)
@@ -145,11 +165,17 @@ ScriptMgr::ScriptMgr()
 
 	// Add functions and variables that can be called from script
 	ConfigureEngine();
+	mEngineConfigHash = ComputeEngineConfigHash();
 }
 
 ScriptMgr::~ScriptMgr(void)
 {
 	ocInfo << "*** ScriptMgr deinit ***";
+	for (ContextPool::iterator it=mContextPool.begin(); it!=mContextPool.end(); ++it)
+	{
+		(*it)->Release();
+	}
+	mContextPool.clear();
 	delete mScriptBuilder;
 	mEngine->Release();
 }
@@ -617,8 +643,8 @@ void RegisterScriptEntityHandle(asIScriptEngine* engine)
 	r = engine->RegisterObjectMethod("EntityHandle", "void SetTag(EntityTag)", asMETHOD(EntityHandle, SetTag), asCALL_THISCALL); OC_SCRIPT_ASSERT();
 	r = engine->RegisterObjectMethod("EntityHandle", "eEntityMessageResult PostMessage(const eEntityMessageType) const",
 		asMETHODPR(EntityHandle, PostMessage, (const EntityMessage::eType) const, EntityMessage::eResult), asCALL_THISCALL); OC_SCRIPT_ASSERT();
-	r = engine->RegisterObjectMethod("EntityHandle", "eEntityMessageResult PostMessage(const eEntityMessageType, PropertyFunctionParameters) const",
-		asMETHODPR(EntityHandle, PostMessage, (const EntityMessage::eType, Reflection::PropertyFunctionParameters) const, EntityMessage::eResult), asCALL_THISCALL); OC_SCRIPT_ASSERT();
+	r = engine->RegisterObjectMethod("EntityHandle", "eEntityMessageResult PostMessage(const eEntityMessageType, const PropertyFunctionParameters &in) const",
+		asMETHODPR(EntityHandle, PostMessage, (const EntityMessage::eType, const Reflection::PropertyFunctionParameters&) const, EntityMessage::eResult), asCALL_THISCALL); OC_SCRIPT_ASSERT();
 	r = engine->RegisterObjectMethod("EntityHandle", "bool UnregisterDynamicProperty(const string &in) const",
 		asFUNCTION(UnregisterDynamicProperty), asCALL_CDECL_OBJFIRST); OC_SCRIPT_ASSERT();
 
@@ -855,7 +881,7 @@ void RegisterScriptEntityMgr(asIScriptEngine* engine)
 	r = engine->RegisterObjectMethod("EntityMgr", "bool HasEntityProperty(const EntityHandle, const StringKey, const PropertyAccessFlags) const", asMETHOD(EntityMgr, HasEntityProperty), asCALL_THISCALL); OC_SCRIPT_ASSERT();
 	r = engine->RegisterObjectMethod("EntityMgr", "bool HasEntityComponentProperty(const EntityHandle, const ComponentID, const StringKey, const PropertyAccessFlags) const", asMETHOD(EntityMgr, HasEntityComponentProperty), asCALL_THISCALL); OC_SCRIPT_ASSERT();
 	r = engine->RegisterObjectMethod("EntityMgr", "void BroadcastMessage(const eEntityMessageType)", asMETHODPR(EntityMgr, BroadcastMessage, (const EntityMessage::eType), void), asCALL_THISCALL); OC_SCRIPT_ASSERT();
-	r = engine->RegisterObjectMethod("EntityMgr", "void BroadcastMessage(const eEntityMessageType, PropertyFunctionParameters)", asMETHODPR(EntityMgr, BroadcastMessage, (const EntityMessage::eType, Reflection::PropertyFunctionParameters), void), asCALL_THISCALL); OC_SCRIPT_ASSERT();
+	r = engine->RegisterObjectMethod("EntityMgr", "void BroadcastMessage(const eEntityMessageType, const PropertyFunctionParameters &in)", asMETHODPR(EntityMgr, BroadcastMessage, (const EntityMessage::eType, const Reflection::PropertyFunctionParameters&), void), asCALL_THISCALL); OC_SCRIPT_ASSERT();
 	r = engine->RegisterObjectMethod("EntityMgr", "bool HasEntityComponentOfType(const EntityHandle, const eComponentType)", asMETHOD(EntityMgr, HasEntityComponentOfType), asCALL_THISCALL); OC_SCRIPT_ASSERT();
 	r = engine->RegisterObjectMethod("EntityMgr", "int32 GetNumberOfEntityComponents(const EntityHandle) const", asMETHOD(EntityMgr, GetNumberOfEntityComponents), asCALL_THISCALL); OC_SCRIPT_ASSERT();
 	r = engine->RegisterObjectMethod("EntityMgr", "ComponentID AddComponentToEntity(const EntityHandle, const eComponentType)", asMETHOD(EntityMgr, AddComponentToEntity), asCALL_THISCALL); OC_SCRIPT_ASSERT();
@@ -867,9 +893,12 @@ void RegisterScriptEntityMgr(asIScriptEngine* engine)
 
 // Functions for register InputMgr to script
 
-InputMgr& GetInputMgr()
+// Returns a pointer, although it's registered as returning a reference (AngelScript passes both the same way), so that
+// no null reference is made in headless mode. The context is aborted as soon as the function returns in such a case.
+InputMgr* GetInputMgr()
 {
-	return gInputMgr;
+	if (!InputMgr::SingletonExists()) asGetActiveContext()->SetException("Input is not available in headless mode");
+	return InputMgr::GetSingletonPtr();
 }
 
 inline static int32 MouseStateGetX(const MouseState& self)
@@ -1020,7 +1049,7 @@ void QuitGame(Game* self)
 void SetFullscreen(const bool value, Game* self)
 {
 	OC_UNUSED(self);
-	if (!gApp.IsEditMode())
+	if (!gApp.IsEditMode() && !gApp.IsHeadless())
 	{
 		gGfxWindow.SetFullscreen(value);
 	}
@@ -1034,7 +1063,7 @@ bool GetFullscreen(Game* self)
 {
 	OC_UNUSED(self);
 
-	return gGfxWindow.IsFullscreen();
+	return GfxSystem::GfxWindow::SingletonExists() && gGfxWindow.IsFullscreen();
 }
 
 void RegisterScriptGame(asIScriptEngine* engine)
@@ -1287,6 +1316,7 @@ void RegisterScriptEditboxMembers(asIScriptEngine *engine, const char *type)
 
 CEGUI::Window* ScriptGetWindow(string name)
 {
+	if (!GUIMgr::SingletonExists()) return 0;
 	string fullName = USER_GUI_WINDOWS_PREFIX + name;
 	return gGUIMgr.WindowExists(fullName) ? gGUIMgr.GetWindow(fullName) : 0;
 }
@@ -1351,9 +1381,11 @@ void RegisterScriptWindows(asIScriptEngine* engine)
 
 // Functions for register GUIMgr to script
 
-GUIMgr& GetGUIMgr()
+// Returns a pointer for the same reason as GetInputMgr.
+GUIMgr* GetGUIMgr()
 {
-	return gGUIMgr;
+	if (!GUIMgr::SingletonExists()) asGetActiveContext()->SetException("GUI is not available in headless mode");
+	return GUIMgr::GetSingletonPtr();
 }
 
 void RegisterScriptGUIMgr(asIScriptEngine* engine)
@@ -1403,6 +1435,27 @@ void RegisterScriptStringMgr(asIScriptEngine* engine)
 	r = engine->RegisterGlobalFunction("const string GetTextData(const StringKey &in)", asFUNCTIONPR(GetTextData, (const StringKey&), const string), asCALL_CDECL); OC_SCRIPT_ASSERT();
 }
 
+// Functions for register log channels to script
+
+bool SetLogLevel(const string& channel, const int32 level)
+{
+	return LogSystem::LogMgr::GetSingleton().SetChannelLevel(channel, level);
+}
+
+int32 GetLogLevel(const string& channel)
+{
+	return LogSystem::LogMgr::GetSingleton().GetChannelLevel(channel);
+}
+
+void RegisterScriptLogMgr(asIScriptEngine* engine)
+{
+	int32 r;
+
+	// Register functions for changing the levels of the log channels, mainly for the use in the console
+	r = engine->RegisterGlobalFunction("bool SetLogLevel(const string &in, const int32)", asFUNCTION(SetLogLevel), asCALL_CDECL); OC_SCRIPT_ASSERT();
+	r = engine->RegisterGlobalFunction("int32 GetLogLevel(const string &in)", asFUNCTION(GetLogLevel), asCALL_CDECL); OC_SCRIPT_ASSERT();
+}
+
 void ScriptMgr::ConfigureEngine(void)
 {
 	int32 r;
@@ -1452,6 +1505,9 @@ void ScriptMgr::ConfigureEngine(void)
 	// Register StringMgr methods
 	RegisterScriptStringMgr(mEngine);
 
+	// Register log channels
+	RegisterScriptLogMgr(mEngine);
+
 	// Register Project methods
 	RegisterScriptProject(mEngine);
 
@@ -1536,9 +1592,8 @@ asIScriptContext* ScriptMgr::PrepareContext(int32 funcId)
 {
 	OC_ASSERT_MSG(funcId >= 0, "Invalid function ID passed.");
 
-	// Create context
-	asIScriptContext* ctx = mEngine->CreateContext();
-	OC_ASSERT_MSG(ctx, "Failed to create the script context.");
+	// Get an unused context
+	asIScriptContext* ctx = AcquireContext();
 
 	// Prepare function on context
 	int32 r = ctx->Prepare(funcId);
@@ -1547,6 +1602,44 @@ asIScriptContext* ScriptMgr::PrepareContext(int32 funcId)
 	return ctx;
 }
 
+void ScriptMgr::ReleaseContext(asIScriptContext* ctx)
+{
+	OC_ASSERT_MSG(ctx, "Cannot release null context!");
+	OC_ASSERT_MSG(ctx->GetState() != asEXECUTION_ACTIVE, "Cannot release context which is being executed!");
+
+	// suspended scripts are never resumed, so the context can be prepared again only when aborted
+	if (ctx->GetState() == asEXECUTION_SUSPENDED) ctx->Abort();
+
+	// the line callback refers to the deadline of the last execution
+	ctx->ClearLineCallback();
+	ctx->SetUserData(0);
+
+	if (mContextPool.size() < MAX_POOLED_CONTEXTS) mContextPool.push_back(ctx);
+	else ctx->Release();
+}
+
+asIScriptContext* ScriptMgr::AcquireContext(void)
+{
+	if (!mContextPool.empty())
+	{
+		asIScriptContext* ctx = mContextPool.back();
+		mContextPool.pop_back();
+		return ctx;
+	}
+
+	asIScriptContext* ctx = mEngine->CreateContext();
+	OC_ASSERT_MSG(ctx, "Failed to create the script context.");
+	return ctx;
+}
+
+void ScriptMgr::UnprepareContextPool(void)
+{
+	for (ContextPool::iterator it=mContextPool.begin(); it!=mContextPool.end(); ++it)
+	{
+		(*it)->Unprepare();
+	}
+}
+
 bool ScriptMgr::ExecuteContext(asIScriptContext* ctx, uint32 timeOut)
 {
 	OC_ASSERT_MSG(ctx, "Cannot execute null context!");
@@ -1564,12 +1657,13 @@ bool ScriptMgr::ExecuteContext(asIScriptContext* ctx, uint32 timeOut)
 	ocDebug << "Executing script function '" << funcDecl << "' in module '" << moduleName << "'.";
 
 	// Set line callback function to avoid script cycling
-	uint64 deadline = 0;
+	ScriptTimeOut scriptTimeOut;
 	if (timeOut != 0)
 	{
-		r = ctx->SetLineCallback(asFUNCTION(LineCallback), &deadline, asCALL_CDECL);
+		r = ctx->SetLineCallback(asFUNCTION(LineCallback), &scriptTimeOut, asCALL_CDECL);
 		OC_ASSERT_MSG(r >= 0, "Failed to register line callback function.");
-		deadline = GetGlobalTime() + timeOut;
+		scriptTimeOut.deadline = GetGlobalTime() + timeOut;
+		scriptTimeOut.linesToCheck = LINES_PER_TIMEOUT_CHECK;
 	}
 
 	// Execute the script function and get result
@@ -1650,7 +1744,10 @@ bool ScriptMgr::ExecuteString(const char* script, const char* moduleName)
 	bool result;
 
 	// Execute the script string and get result
-	switch(ExecuteStringEngine(mEngine, script, mod, 0))
+	asIScriptContext* ctx = AcquireContext();
+	int32 r = ExecuteStringEngine(mEngine, script, mod, ctx);
+	ReleaseContext(ctx);
+	switch(r)
 	{
 	case asERROR: // failed to build
 	case asINVALID_CONFIGURATION:
@@ -1681,11 +1778,20 @@ asIScriptModule* ScriptMgr::GetModule(const char* fileName)
 	asIScriptModule* mod = mEngine->GetModule(fileName, asGM_ONLY_IF_EXISTS);
 	if (mod != 0) return mod;
 
+	mModules[string(fileName)] = ScriptResourcePtrs();
+
+	// Use the cached bytecode if the scripts didn't change; it must be tried before the builder starts the module,
+	// as restoring the module replaces any module with the same name
+	if (LoadModuleFromCache(fileName))
+	{
+		ocInfo << "Loaded script module " << fileName << " from cache";
+		return mEngine->GetModule(fileName, asGM_ONLY_IF_EXISTS);
+	}
+
 	int32 r;
 	// Create script builder to build new module
 	r = mScriptBuilder->StartNewModule(mEngine, fileName);
 	OC_ASSERT_MSG(r==0, "Failed to add module to script engine.");
-	mModules[string(fileName)] = ScriptResourcePtrs();
 
 	// Include main file
 	r = IncludeCallback(fileName, "", mScriptBuilder, 0);
@@ -1700,10 +1806,268 @@ asIScriptModule* ScriptMgr::GetModule(const char* fileName)
 	}
 
 	ocInfo << "Loaded script module " << fileName;
+	SaveModuleToCache(fileName);
 
 	return mEngine->GetModule(fileName, asGM_ONLY_IF_EXISTS);
 }
 
+/// Identifier at the beginning of the script cache files.
+const uint32 SCRIPT_CACHE_MAGIC = 0x4353434f;
+
+/// Version of the format of the script cache files. Increase it when the format or the engine configuration changes
+/// in a way not covered by ComputeEngineConfigHash.
+const uint32 SCRIPT_CACHE_VERSION = 2;
+
+/// Upper limit of the size of the cached bytecode of a module; bigger sizes come from corrupted files.
+const uint32 MAX_CACHED_BYTECODE_SIZE = 64 * 1024 * 1024;
+
+/// Returns the FNV-1a hash of the data. The hash of previous data can be passed to continue hashing.
+uint32 HashData(const void* data, size_t size, uint32 hash = 2166136261u)
+{
+	const uint8* bytes = (const uint8*)data;
+	for (size_t i=0; i<size; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/// Returns the FNV-1a hash of the null terminated string.
+uint32 HashText(const char* str, uint32 hash = 2166136261u)
+{
+	return HashData(str, strlen(str), hash);
+}
+
+/// Binary stream in memory the bytecode of modules is saved to and restored from.
+class ByteCodeStream : public asIBinaryStream
+{
+public:
+
+	ByteCodeStream(void): mReadPos(0), mReadFailed(false) {}
+
+	virtual void Read(void* ptr, asUINT size)
+	{
+		if (mReadPos + size > mData.size())
+		{
+			memset(ptr, 0, size);
+			mReadFailed = true;
+			return;
+		}
+		memcpy(ptr, &mData[mReadPos], size);
+		mReadPos += size;
+	}
+
+	virtual void Write(const void* ptr, asUINT size)
+	{
+		const uint8* bytes = (const uint8*)ptr;
+		mData.insert(mData.end(), bytes, bytes + size);
+	}
+
+	/// Returns the stored data.
+	inline vector<uint8>& GetData(void) { return mData; }
+
+	/// Returns true if more data were read than stored.
+	inline bool IsReadFailed(void) const { return mReadFailed; }
+
+private:
+	vector<uint8> mData;
+	size_t mReadPos;
+	bool mReadFailed;
+};
+
+/// Helpers for reading and writing the script cache files. The read functions return false on failure.
+void WriteCacheValue(std::ostream& output, const uint32 value)
+{
+	output.write((const char*)&value, sizeof(value));
+}
+
+bool ReadCacheValue(std::istream& input, uint32& value)
+{
+	input.read((char*)&value, sizeof(value));
+	return input.good();
+}
+
+void WriteCacheString(std::ostream& output, const string& value)
+{
+	WriteCacheValue(output, (uint32)value.size());
+	output.write(value.c_str(), value.size());
+}
+
+bool ReadCacheString(std::istream& input, string& value)
+{
+	uint32 length = 0;
+	if (!ReadCacheValue(input, length) || length > 1024) return false;
+	value.resize(length);
+	if (length > 0) input.read(&value[0], length);
+	return input.good();
+}
+
+uint32 ScriptMgr::ComputeEngineConfigHash(void)
+{
+	uint32 hash = HashText(ANGELSCRIPT_VERSION_STRING);
+	for (int32 i=0; i<mEngine->GetGlobalFunctionCount(); ++i)
+	{
+		asIScriptFunction* func = mEngine->GetFunctionDescriptorById(mEngine->GetGlobalFunctionIdByIndex(i));
+		if (func) hash = HashText(func->GetDeclaration(), hash);
+	}
+	for (int32 i=0; i<mEngine->GetGlobalPropertyCount(); ++i)
+	{
+		const char* name = 0;
+		int typeId = 0;
+		mEngine->GetGlobalPropertyByIndex(i, &name, &typeId);
+		if (name) hash = HashText(name, hash);
+		hash = HashData(&typeId, sizeof(typeId), hash);
+	}
+	for (int32 i=0; i<mEngine->GetObjectTypeCount(); ++i)
+	{
+		asIObjectType* type = mEngine->GetObjectTypeByIndex(i);
+		hash = HashText(type->GetName(), hash);
+		for (int32 j=0; j<type->GetMethodCount(); ++j)
+		{
+			hash = HashText(type->GetMethodDescriptorByIndex(j)->GetDeclaration(), hash);
+		}
+		int32 propertyCount = type->GetPropertyCount();
+		hash = HashData(&propertyCount, sizeof(propertyCount), hash);
+	}
+	return hash;
+}
+
+uint32 ScriptMgr::ComputeDefinedWordsHash(void) const
+{
+	// the words are sorted in the set, so the order of the definitions doesn't matter
+	uint32 hash = HashText("");
+	for (set<string>::const_iterator it=mDefinedWords.begin(); it!=mDefinedWords.end(); ++it)
+	{
+		hash = HashData(it->c_str(), it->size() + 1, hash);
+	}
+	return hash;
+}
+
+string ScriptMgr::GetModuleCachePath(const char* fileName)
+{
+	// the module name is not unique across projects, so the path of the main file is a part of the cache name
+	ScriptResourcePtr sp = gResourceMgr.GetResource("Project", fileName);
+	if (!sp) return "";
+
+	string cacheName = fileName;
+	for (string::iterator it=cacheName.begin(); it!=cacheName.end(); ++it)
+	{
+		if (!isalnum((uint8)*it) && *it != '.') *it = '_';
+	}
+	boost::filesystem::path cachePath = gApp.GetTempDirectory();
+	cachePath /= "ScriptCache";
+	cachePath /= cacheName + "_" + Utils::StringConverter::ToString(HashText(sp->GetFilePath().c_str())) + ".bin";
+	return cachePath.string();
+}
+
+bool ScriptMgr::LoadModuleFromCache(const char* fileName)
+{
+	string cachePath = GetModuleCachePath(fileName);
+	if (cachePath.empty()) return false;
+
+	boost::filesystem::ifstream input(cachePath, std::ios::in | std::ios::binary);
+	if (!input.is_open()) return false;
+
+	uint32 magic = 0, version = 0, configHash = 0, definedWordsHash = 0, sectionCount = 0;
+	if (!ReadCacheValue(input, magic) || !ReadCacheValue(input, version) || !ReadCacheValue(input, configHash)
+		|| !ReadCacheValue(input, definedWordsHash) || !ReadCacheValue(input, sectionCount)) return false;
+	if (magic != SCRIPT_CACHE_MAGIC || version != SCRIPT_CACHE_VERSION || configHash != mEngineConfigHash
+		|| definedWordsHash != ComputeDefinedWordsHash()) return false;
+
+	// all the script files the module was built from must be unchanged
+	ScriptResourcePtrs sections;
+	for (uint32 i=0; i<sectionCount; ++i)
+	{
+		string sectionName;
+		uint32 sectionHash = 0;
+		if (!ReadCacheString(input, sectionName) || !ReadCacheValue(input, sectionHash)) return false;
+		ScriptResourcePtr sp = gResourceMgr.GetResource("Project", sectionName);
+		if (!sp || sp->GetState() == ResourceSystem::Resource::STATE_MISSING) return false;
+		if (HashText(sp->GetScript()) != sectionHash) return false;
+		sections.push_back(sp);
+	}
+
+	uint32 byteCodeSize = 0, byteCodeHash = 0;
+	if (!ReadCacheValue(input, byteCodeSize) || !ReadCacheValue(input, byteCodeHash) || byteCodeSize == 0
+		|| byteCodeSize > MAX_CACHED_BYTECODE_SIZE) return false;
+	ByteCodeStream stream;
+	stream.GetData().resize(byteCodeSize);
+	input.read((char*)&stream.GetData()[0], byteCodeSize);
+	if (!input.good() || HashData(&stream.GetData()[0], byteCodeSize) != byteCodeHash)
+	{
+		ocWarning << "Script cache file '" << cachePath << "' is corrupted";
+		return false;
+	}
+	input.close();
+
+	asIScriptModule* mod = mEngine->GetModule(fileName, asGM_ALWAYS_CREATE);
+	OC_ASSERT_MSG(mod, "Failed to add module to script engine.");
+	if (mod->LoadByteCode(&stream) < 0 || stream.IsReadFailed())
+	{
+		ocWarning << "Can't restore script module " << fileName << " from cache; it will be built";
+		mEngine->DiscardModule(fileName);
+		return false;
+	}
+
+	// the module depends on the same files as if it was built
+	for (ScriptResourcePtrs::iterator it=sections.begin(); it!=sections.end(); ++it)
+	{
+		(*it)->GetDependentModules().insert(string(fileName));
+		mModules[string(fileName)].push_back(*it);
+	}
+	return true;
+}
+
+void ScriptMgr::SaveModuleToCache(const char* fileName)
+{
+	string cachePath = GetModuleCachePath(fileName);
+	if (cachePath.empty()) return;
+
+	asIScriptModule* mod = mEngine->GetModule(fileName, asGM_ONLY_IF_EXISTS);
+	OC_ASSERT(mod);
+	ByteCodeStream stream;
+	if (mod->SaveByteCode(&stream) < 0 || stream.GetData().empty())
+	{
+		ocWarning << "Can't save bytecode of script module " << fileName;
+		return;
+	}
+
+	boost::filesystem::ofstream output;
+	try
+	{
+		boost::filesystem::create_directories(boost::filesystem::path(cachePath).parent_path());
+		output.open(cachePath, std::ios::out | std::ios::binary | std::ios::trunc);
+	}
+	catch (const boost::filesystem::filesystem_error& e)
+	{
+		ocWarning << "Can't create script cache directory: " << e.what();
+		return;
+	}
+	if (!output.is_open())
+	{
+		ocWarning << "Can't write script cache file '" << cachePath << "'";
+		return;
+	}
+
+	const ScriptResourcePtrs& sections = mModules[string(fileName)];
+	WriteCacheValue(output, SCRIPT_CACHE_MAGIC);
+	WriteCacheValue(output, SCRIPT_CACHE_VERSION);
+	WriteCacheValue(output, mEngineConfigHash);
+	WriteCacheValue(output, ComputeDefinedWordsHash());
+	WriteCacheValue(output, (uint32)sections.size());
+	for (ScriptResourcePtrs::const_iterator it=sections.begin(); it!=sections.end(); ++it)
+	{
+		WriteCacheString(output, (*it)->GetName());
+		WriteCacheValue(output, HashText((*it)->GetScript()));
+	}
+	const vector<uint8>& byteCode = stream.GetData();
+	WriteCacheValue(output, (uint32)byteCode.size());
+	WriteCacheValue(output, HashData(&byteCode[0], byteCode.size()));
+	output.write((const char*)&byteCode[0], byteCode.size());
+	if (!output.good()) ocWarning << "Can't write script cache file '" << cachePath << "'";
+}
+
 int32 ScriptMgr::GetFunctionID(const char* moduleName, const char* funcDecl)
 {
 	// Get module by name
@@ -1718,6 +2082,20 @@ int32 ScriptMgr::GetFunctionID(const char* moduleName, const char* funcDecl)
 	return mod->GetFunctionIdByDecl(funcDecl);
 }
 
+bool ScriptMgr::ModuleHasFunction(const char* moduleName, const char* funcDecl)
+{
+	map<string, bool>& moduleFunctions = mModuleFunctions[moduleName];
+	map<string, bool>::const_iterator it = moduleFunctions.find(funcDecl);
+	if (it != moduleFunctions.end()) return it->second;
+
+	asIScriptModule* mod = GetModule(moduleName);
+	// a module that failed to build is not cached, it can be fixed later
+	if (mod == 0) return false;
+	bool result = mod->GetFunctionIdByDecl(funcDecl) >= 0;
+	moduleFunctions[funcDecl] = result;
+	return result;
+}
+
 const char* ScriptMgr::GetFunctionModuleName(int32 funcId)
 {
 	const asIScriptFunction *function = mEngine->GetFunctionDescriptorById(funcId);
@@ -1733,13 +2111,18 @@ const char* ScriptMgr::GetFunctionDeclaration(int32 funcId)
 void ScriptMgr::DefineWord( const char* word )
 {
 	mScriptBuilder->DefineWord(word);
+	mDefinedWords.insert(word);
 }
 
 void ScriptMgr::UnloadModule(const char* fileName)
 {
+	mModuleFunctions.erase(string(fileName));
 	int32 r = mEngine->DiscardModule(fileName);
 	if (r < 0) return;
 
+	// the pooled contexts must not keep the functions of the discarded module alive
+	UnprepareContextPool();
+
 	map<string, ScriptResourcePtrs>::iterator moduleIter;
 	if ((moduleIter = mModules.find(string(fileName))) != mModules.end())
 	{
@@ -1759,6 +2142,7 @@ void ScriptMgr::ClearModules()
 	{
 		UnloadModule(iter->first.c_str());
 	}
+	mModuleFunctions.clear();
 }
 
 // These macros allow us to automatically define the setter function and its value type for the script function arguments.
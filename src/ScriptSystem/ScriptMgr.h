@@ -50,6 +50,10 @@ namespace ScriptSystem
 		/// @param funcDecl Declaration of function to be called in the script.
 		/// @return Number greater than or equal to zero that is function ID, number less than zero for not found
 		int32 GetFunctionID(const char* moduleName, const char* funcDecl);
+
+		/// Returns true if the module contains a function with the given declaration. The answers are cached until
+		/// the module is unloaded, so it is cheap to ask repeatedly.
+		bool ModuleHasFunction(const char* moduleName, const char* funcDecl);
 		
 		/// Get a module name where the script function of a specified ID occurs.
 		/// @param funcId Script function ID.
@@ -61,10 +65,15 @@ namespace ScriptSystem
 		/// @return Appropriate function declaration, 0 if function with the ID is not found.
 		const char* GetFunctionDeclaration(int32 funcId);
 
-		/// Returns new context prepared for passing the argument values.
+		/// Returns a context prepared for passing the argument values. The context must be returned by ReleaseContext.
 		///	@param funcId ID of function to prepare (can get from GetFunctionID)
+		/// @remarks The contexts are reused, so it's cheap to call this for each script function call. Calls nested
+		/// from the executed scripts get other contexts.
 		AngelScript::asIScriptContext* PrepareContext(int32 funcId);
 
+		/// Returns the context got from PrepareContext back to the manager so that it can be reused.
+		void ReleaseContext(AngelScript::asIScriptContext* ctx);
+
 		/// Sets an argument to a function being prepared to be called. The type and value of the argument
 		/// is determined from PropertyFunctionParameter.
 		/// @param ctx Prepared context
@@ -74,7 +83,7 @@ namespace ScriptSystem
 		bool SetFunctionArgument(AngelScript::asIScriptContext* ctx, 
 			const uint32 parameterIndex, const Reflection::PropertyFunctionParameter& parameter);
 
-		/// Executes prepared context with specific time out. Don't forger to release context.
+		/// Executes prepared context with specific time out. Don't forget to release context by ReleaseContext.
 		/// @param ctx Prepared context with function arguments passed
 		/// @param timeOut Time in ms after the execution of script will be aborted
 		/// @return True if the execution was successful (can get return value)
@@ -92,6 +101,8 @@ namespace ScriptSystem
 
 		/// Get script module represented by the name of file where the main function is.
 		/// This function loads and builds module if necessary.
+		/// @remarks The bytecode of built modules is cached in the temp directory. The module is restored from the cache
+		/// instead of being built if none of the script files it was built from changed.
 		AngelScript::asIScriptModule* GetModule(const char* fileName);
 
 		/// Unload script module represented by the name of file where the main function is.
@@ -113,22 +124,56 @@ namespace ScriptSystem
 		inline bool IsExecutedFromConsole() const { return mExecFromConsole; }
 
 	private:
+		typedef vector<AngelScript::asIScriptContext*> ContextPool;
 
 		/// Pointer to script engine.
 		AngelScript::asIScriptEngine* mEngine;
 
+		/// Contexts which are not used at the moment and can be prepared again.
+		ContextPool mContextPool;
+
 		/// Object that helps building scripts.
 		AngelScript::CScriptBuilder* mScriptBuilder;
 
 		/// Depencency of loaded modules to resources
 		map<string, ScriptResourcePtrs> mModules;
 
+		/// Cached answers of ModuleHasFunction for each module and function declaration.
+		map<string, map<string, bool> > mModuleFunctions;
+
 		/// True if the engine is executing commands directly from the GUI console.
 		bool mExecFromConsole;
 
+		/// Hash of the engine configuration. The cached bytecode can be used only with the same configuration.
+		uint32 mEngineConfigHash;
+
+		/// Words defined for the conditional compilation. The cached bytecode can be used only with the same words.
+		set<string> mDefinedWords;
+
+		/// Returns an unused context from the pool or a new one if the pool is empty.
+		AngelScript::asIScriptContext* AcquireContext(void);
+
+		/// Releases the references the pooled contexts hold to the functions they were prepared with.
+		void UnprepareContextPool(void);
+
 		/// Configure the script engine with all the functions and variables that the script should be able to use.
 		void ConfigureEngine(void);
 
+		/// Computes the hash of everything registered to the engine by ConfigureEngine.
+		uint32 ComputeEngineConfigHash(void);
+
+		/// Computes the hash of the words defined for the conditional compilation.
+		uint32 ComputeDefinedWordsHash(void) const;
+
+		/// Returns the path of the cache file with the bytecode of the module or empty string if it can't be cached.
+		string GetModuleCachePath(const char* fileName);
+
+		/// Restores the module from the cached bytecode. Returns false if the cache is missing or out of date.
+		bool LoadModuleFromCache(const char* fileName);
+
+		/// Saves the bytecode of the built module to the cache.
+		void SaveModuleToCache(const char* fileName);
+
 		/// Callback for including files to module.
 		static int IncludeCallback(const char* fileName, const char* from, AngelScript::CScriptBuilder* builder, void* userParam);
 	};
@@ -1,5 +1,6 @@
 #include "Common.h"
 #include "ScriptResource.h"
+#include "DataContainer.h"
 
 using namespace ScriptSystem;
 
@@ -15,13 +16,23 @@ ScriptResource::~ScriptResource(void)
 	UnloadImpl();
 }
 
+void ScriptResource::PrepareImpl()
+{
+	// the script is read at once; the line ends are left to the script compiler. The file isn't mapped, because
+	// the scripts are edited while the game is running and a mapped file can't be truncated safely.
+	DataContainer dc;
+	if (GetRawInputData(dc)) mScript.assign((const char*)dc.GetData(), dc.GetSize());
+	dc.Release();
+}
+
+void ScriptResource::DiscardPreparedData()
+{
+	mScript.clear();
+}
+
 size_t ScriptResource::LoadImpl()
 {
-	InputStream* is = OpenInputStream(ISM_TEXT);
-	stringstream ss;
-	ss << is->rdbuf();
-	mScript = ss.str();
-	CloseInputStream();
+	// the script was read in PrepareImpl already
 	return mScript.size();
 }
 
@@ -31,6 +31,9 @@ namespace ScriptSystem
 		/// Returns the resource type associated with this class.
 		static ResourceSystem::eResourceType GetResourceType() { return ResourceSystem::RESTYPE_SCRIPTRESOURCE; }
 
+		/// The script file is read in PrepareImpl, the compilation is left for the script manager.
+		virtual bool IsPreparable(void) const { return true; }
+
 		/// Register the callback for reloading the script resource
 		static void SetUnloadCallback(ScriptResourceUnloadCallback callback);
 
@@ -39,6 +42,8 @@ namespace ScriptSystem
 
 	protected:
 
+		virtual void PrepareImpl(void);
+		virtual void DiscardPreparedData(void);
 		virtual size_t LoadImpl(void);
 		virtual bool UnloadImpl(void);
 
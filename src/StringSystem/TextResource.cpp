@@ -1,5 +1,6 @@
 #include "Common.h"
 #include "TextResource.h"
+#include "DataContainer.h"
 
 using namespace StringSystem;
 
@@ -19,13 +20,20 @@ TextResource::~TextResource(void)
 
 size_t TextResource::LoadImpl()
 {
-	InputStream* is = OpenInputStream(ISM_TEXT);
+	// the lines are taken right from the read data; the file isn't mapped, because it is edited by the users
+	DataContainer dc;
+	GetRawInputData(dc);
+	const char* data = (const char*)dc.GetData();
+	const char* dataEnd = data + dc.GetSize();
+
 	size_t dataSize = 0;
 	string line = "";
 	bool first = true;
-	while (is->good())
+	while (data < dataEnd)
 	{
-		std::getline(*is, line);
+		const char* lineEnd = std::find(data, dataEnd, '\n');
+		line.assign(data, lineEnd);
+		data = lineEnd == dataEnd ? dataEnd : lineEnd + 1;
 
 		// Get rid of annoying \r from windows EOL characters
 		if (!line.empty() && line[line.size() - 1] == '\r')
@@ -60,7 +68,7 @@ size_t TextResource::LoadImpl()
 			}
 		}
 	}
-	CloseInputStream();
+	dc.Release();
 	return dataSize;
 }
 
@@ -0,0 +1,55 @@
+#include "Common.h"
+#include "BinaryConverter.h"
+
+using namespace BinaryConverter;
+
+template<>
+void BinaryConverter::WriteToBinary(ResourceSystem::BinaryOutput& output, const string& val)
+{
+	output.WriteString(val);
+}
+
+template<>
+void BinaryConverter::WriteToBinary(ResourceSystem::BinaryOutput& output, const StringKey& val)
+{
+	output.WriteString(val.ToString());
+}
+
+template<>
+void BinaryConverter::WriteToBinary(ResourceSystem::BinaryOutput& output, const EntitySystem::EntityHandle& val)
+{
+	output.Write<EntitySystem::EntityID>(val.GetID());
+}
+
+template<>
+void BinaryConverter::WriteToBinary(ResourceSystem::BinaryOutput& output, const ResourceSystem::ResourcePtr& val)
+{
+	output.WriteString(val ? val->GetName() : string());
+}
+
+template<>
+string BinaryConverter::ReadFromBinary(ResourceSystem::BinaryInput& input)
+{
+	return input.ReadString();
+}
+
+template<>
+StringKey BinaryConverter::ReadFromBinary(ResourceSystem::BinaryInput& input)
+{
+	return StringKey(input.ReadString());
+}
+
+template<>
+EntitySystem::EntityHandle BinaryConverter::ReadFromBinary(ResourceSystem::BinaryInput& input)
+{
+	EntitySystem::EntityID id = input.Read<EntitySystem::EntityID>();
+	return EntitySystem::EntityHandle(id);
+}
+
+template<>
+ResourceSystem::ResourcePtr BinaryConverter::ReadFromBinary(ResourceSystem::BinaryInput& input)
+{
+	string name = input.ReadString();
+	if (name.empty()) return 0;
+	return gResourceMgr.GetResource("Project", name);
+}
@@ -0,0 +1,72 @@
+/// @file
+/// Set of functions for reading/writing different values from/to binary data.
+
+#ifndef BinaryConverter_h__
+#define BinaryConverter_h__
+
+#include "Base.h"
+#include "Array.h"
+#include "../ResourceSystem/BinaryInput.h"
+#include "../ResourceSystem/BinaryOutput.h"
+
+namespace Utils
+{
+	/// Set of functions for reading/writing different values from/to binary data.
+	/// @remarks
+	/// Plain values are stored as they are in memory, the others (strings, entity handles, resources) are
+	/// specialized below.
+	namespace BinaryConverter
+	{
+		/// Writes the given arbitrary value to binary output.
+		template<typename T>
+		void WriteToBinary(ResourceSystem::BinaryOutput& output, const T& val)
+		{
+			output.Write<T>(val);
+		}
+
+		/// Writes the given array of arbitrary values to binary output.
+		template<typename T>
+		void WriteToBinary(ResourceSystem::BinaryOutput& output, Array<T>* array)
+		{
+			output.Write<int32>(array->GetSize());
+			for (int32 i = 0; i < array->GetSize(); ++i)
+			{
+				WriteToBinary<T>(output, (*array)[i]);
+			}
+		}
+
+		template<>
+		void WriteToBinary(ResourceSystem::BinaryOutput& output, const string& val);
+
+		template<>
+		void WriteToBinary(ResourceSystem::BinaryOutput& output, const StringKey& val);
+
+		template<>
+		void WriteToBinary(ResourceSystem::BinaryOutput& output, const EntitySystem::EntityHandle& val);
+
+		template<>
+		void WriteToBinary(ResourceSystem::BinaryOutput& output, const ResourceSystem::ResourcePtr& val);
+
+
+		/// Reads the value from binary input and returns it.
+		template<typename T>
+		T ReadFromBinary(ResourceSystem::BinaryInput& input)
+		{
+			return input.Read<T>();
+		}
+
+		template<>
+		string ReadFromBinary(ResourceSystem::BinaryInput& input);
+
+		template<>
+		StringKey ReadFromBinary(ResourceSystem::BinaryInput& input);
+
+		template<>
+		EntitySystem::EntityHandle ReadFromBinary(ResourceSystem::BinaryInput& input);
+
+		template<>
+		ResourceSystem::ResourcePtr ReadFromBinary(ResourceSystem::BinaryInput& input);
+	}
+}
+
+#endif // BinaryConverter_h__
@@ -0,0 +1,88 @@
+#include "Common.h"
+#include "DataContainer.h"
+#include <climits>
+
+#ifdef __WIN__
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+using namespace Utils;
+
+bool Utils::DataContainer::MapFile( const string& filePath )
+{
+	Release();
+
+#ifdef __WIN__
+	HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0 || fileSize.QuadPart > INT_MAX)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	// the view keeps the mapping and the file open, so the handles are not needed anymore
+	HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+	CloseHandle(file);
+	if (!mapping) return false;
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!view) return false;
+
+	mData = (uint8*)view;
+	mSize = (int32)fileSize.QuadPart;
+#else
+	int file = open(filePath.c_str(), O_RDONLY);
+	if (file < 0) return false;
+
+	struct stat fileInfo;
+	if (fstat(file, &fileInfo) != 0 || fileInfo.st_size <= 0 || fileInfo.st_size > INT_MAX)
+	{
+		close(file);
+		return false;
+	}
+
+	// the mapping keeps the file referenced, so the descriptor is not needed anymore
+	void* view = mmap(0, fileInfo.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (view == MAP_FAILED) return false;
+
+	mData = (uint8*)view;
+	mSize = (int32)fileInfo.st_size;
+#endif
+
+	mOrigin = DO_MAPPING;
+	return true;
+}
+
+void Utils::DataContainer::Release( void )
+{
+	if (!mData)
+		return;
+
+	switch (mOrigin)
+	{
+	case DO_ARRAY:
+		delete[] mData;
+		break;
+	case DO_MAPPING:
+	#ifdef __WIN__
+		UnmapViewOfFile(mData);
+	#else
+		munmap(mData, mSize);
+	#endif
+		break;
+	case DO_BORROWED:
+		break;
+	}
+	mData = 0;
+	mSize = 0;
+	mOrigin = DO_ARRAY;
+}
@@ -12,19 +12,33 @@ namespace Utils
 	/// This class stores a pointer to a data buffer and its size. It is used to retrieve data from a function
 	/// where it is passed via reference.
 	/// Note that the class doesn't allocate nor deallocate any memory until requested by calling Release.
+	/// @remarks
+	/// The data can be a buffer owned by the container, a read-only mapping of a file owned by the container or
+	/// a buffer borrowed from someone else. Release frees the data in the way matching its origin. The mapped
+	/// and borrowed data must not be modified.
 	class DataContainer
 	{
 	public:
 
 		/// Default constructor. No data are created or stored.
-		DataContainer(void): mData(0), mSize (0) {}
+		DataContainer(void): mData(0), mSize (0), mOrigin(DO_ARRAY) {}
 
 		/// Note that the destructor doesn't destroy the carried data.
 		~DataContainer(void) {}
 
 		/// Sets the data to be carried. The pointer to such data must be obtained
 		/// with new[] operator.
-		inline void SetData(uint8* data, int32 size) { mData = data; mSize = size; }
+		inline void SetData(uint8* data, int32 size) { mData = data; mSize = size; mOrigin = DO_ARRAY; }
+
+		/// Sets the data to be carried without taking the ownership. Release only forgets the data.
+		inline void SetBorrowedData(const uint8* data, int32 size) { mData = const_cast<uint8*>(data); mSize = size; mOrigin = DO_BORROWED; }
+
+		/// Maps the whole file read-only into the memory and carries the mapped data. Returns false if the file
+		/// doesn't exist, is empty or can't be mapped.
+		bool MapFile(const string& filePath);
+
+		/// Returns true if the carried data is a mapping of a file.
+		inline bool IsMapped(void) const { return mOrigin == DO_MAPPING; }
 
 		/// Returns the carried data pointer.
 		inline uint8* GetData(void) { return mData; }
@@ -36,19 +50,22 @@ namespace Utils
 		inline int32 GetSize(void) const { return mSize; }
 
 		/// Destroys the carried data.
-		void Release(void)
-		{
-			if (!mData)
-				return;
-			delete[] mData;
-			mData = 0;
-			mSize = 0;
-		}
+		void Release(void);
 
 	private:
+
+		/// Where the carried data comes from.
+		enum eDataOrigin
+		{
+			DO_ARRAY,
+			DO_MAPPING,
+			DO_BORROWED
+		};
+
 		uint8* mData;
 		int32 mSize;
+		eDataOrigin mOrigin;
 	};
 }
 
-#endif // DataContainer_h__
\ No newline at end of file
+#endif // DataContainer_h__
@@ -18,18 +18,18 @@ namespace Utils
 
         /// Sets new key-pointer pair.
         /// Don't store null pointers as it will cause assert.
-        static void SetPointer(const StringKey key, void* value) {
+        static void SetPointer(const StringKey& key, void* value) {
             mProperties[key] = value;
         }
 
 		/// Clears the pointer from the properties.
-		static void RemovePointer(const StringKey key) {
+		static void RemovePointer(const StringKey& key) {
 			mProperties.erase(key);
 		}
 
         /// Returns a stored pointer identified by the given string key.
         template<typename T>
-        static T* GetPointer(const StringKey key) {
+        static T* GetPointer(const StringKey& key) {
             PropertyMap::const_iterator it = mProperties.find(key);
             OC_ASSERT_MSG(it != mProperties.end(), "Global property not found.");
             return (T*)(it->second);
@@ -38,7 +38,7 @@ namespace Utils
         /// Returns reference to the object stored using a pointer identified by the given string key.
         /// If the stored pointer is null, an assert will appear.
         template<typename T>
-        static T& Get(const StringKey key) {
+        static T& Get(const StringKey& key) {
             PropertyMap::const_iterator it = mProperties.find(key);
             OC_ASSERT_MSG(it != mProperties.end(), "Global property not found.");
             T* ptr = (T*)(it->second);
@@ -0,0 +1,209 @@
+#include "Common.h"
+#include "JobPool.h"
+#include "SDL/SDL_thread.h"
+#include "SDL/SDL_mutex.h"
+
+#ifdef __WIN__
+	#include <Windows.h>
+#else
+	#include <unistd.h>
+#endif
+
+using namespace Utils;
+
+/// Maximum number of chunks queued per thread. More chunks balance the load better, but cost more synchronization.
+const uint32 MAX_CHUNKS_PER_THREAD = 4;
+
+/// Maximum number of worker threads the default count is limited to.
+const int32 MAX_DEFAULT_WORKERS = 15;
+
+Utils::JobPool::JobPool( const int32 workerCount ):
+	mStopWorkers(false),
+	mQueuedJobsCount(0),
+	mPendingJobsCount(0)
+{
+	mMutex = SDL_CreateMutex();
+	mWorkCondition = SDL_CreateCond();
+	mDoneCondition = SDL_CreateCond();
+
+	// the last queue belongs to the thread calling ParallelFor
+	const int32 queueCount = MathUtils::Max<int32>(workerCount, 0) + 1;
+	mWorkerInfos.resize(queueCount);
+	for (int32 i=0; i<queueCount; ++i)
+	{
+		JobQueue* queue = new JobQueue();
+		queue->mutex = SDL_CreateMutex();
+		mQueues.push_back(queue);
+	}
+
+	for (int32 i=0; i<workerCount; ++i)
+	{
+		mWorkerInfos[i].pool = this;
+		mWorkerInfos[i].queueIndex = i;
+		SDL_Thread* worker = SDL_CreateThread(WorkerThreadMain, &mWorkerInfos[i]);
+		if (!worker)
+		{
+			ocWarning << "Can't create a job thread";
+			break;
+		}
+		mWorkers.push_back(worker);
+	}
+	ocInfo << "Jobs are processed by " << GetThreadCount() << " threads";
+}
+
+Utils::JobPool::~JobPool( void )
+{
+	SDL_mutexP(mMutex);
+	mStopWorkers = true;
+	SDL_CondBroadcast(mWorkCondition);
+	SDL_mutexV(mMutex);
+
+	for (WorkerVector::iterator it=mWorkers.begin(); it!=mWorkers.end(); ++it)
+	{
+		SDL_WaitThread(*it, 0);
+	}
+
+	for (QueueVector::iterator it=mQueues.begin(); it!=mQueues.end(); ++it)
+	{
+		SDL_DestroyMutex((*it)->mutex);
+		delete *it;
+	}
+
+	SDL_DestroyCond(mDoneCondition);
+	SDL_DestroyCond(mWorkCondition);
+	SDL_DestroyMutex(mMutex);
+}
+
+int32 Utils::JobPool::GetDefaultWorkerCount( void )
+{
+	int32 processorCount = 1;
+#ifdef __WIN__
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	processorCount = (int32)info.dwNumberOfProcessors;
+#else
+	processorCount = (int32)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	return MathUtils::Min<int32>(MathUtils::Max<int32>(processorCount - 1, 0), MAX_DEFAULT_WORKERS);
+}
+
+void Utils::JobPool::ParallelFor( JobFunction function, void* context, const uint32 count, const uint32 minChunkSize )
+{
+	OC_ASSERT(minChunkSize > 0);
+	if (count == 0) return;
+
+	const uint32 maxChunkCount = MathUtils::Min<uint32>(count / minChunkSize, GetThreadCount() * MAX_CHUNKS_PER_THREAD);
+	if (mWorkers.empty() || maxChunkCount <= 1)
+	{
+		function(context, 0, count);
+		return;
+	}
+
+	// the chunks are counted before they are queued, as a worker still looking for work from the previous call
+	// may take a chunk as soon as it's in a queue
+	const uint32 chunkSize = (count + maxChunkCount - 1) / maxChunkCount;
+	const uint32 chunkCount = (count + chunkSize - 1) / chunkSize;
+	SDL_mutexP(mMutex);
+	OC_ASSERT_MSG(mPendingJobsCount == 0, "Only one thread can use the job pool at a time");
+	mQueuedJobsCount += chunkCount;
+	mPendingJobsCount += chunkCount;
+	SDL_mutexV(mMutex);
+
+	// the chunks are dealt to the queues one by one, so each thread starts with its fair share
+	for (uint32 i=0; i<chunkCount; ++i)
+	{
+		Job job;
+		job.function = function;
+		job.context = context;
+		job.begin = i * chunkSize;
+		job.end = MathUtils::Min<uint32>(job.begin + chunkSize, count);
+
+		JobQueue* queue = mQueues[i % mQueues.size()];
+		SDL_mutexP(queue->mutex);
+		queue->jobs.push_back(job);
+		SDL_mutexV(queue->mutex);
+	}
+
+	SDL_mutexP(mMutex);
+	SDL_CondBroadcast(mWorkCondition);
+	SDL_mutexV(mMutex);
+
+	const uint32 queueIndex = mQueues.size() - 1;
+	Job job;
+	while (PopJob(queueIndex, job))
+	{
+		RunJob(job);
+	}
+
+	// the remaining jobs are already being processed by the workers
+	SDL_mutexP(mMutex);
+	while (mPendingJobsCount > 0) SDL_CondWait(mDoneCondition, mMutex);
+	SDL_mutexV(mMutex);
+}
+
+int Utils::JobPool::WorkerThreadMain( void* info )
+{
+	WorkerInfo* workerInfo = (WorkerInfo*)info;
+	workerInfo->pool->RunWorker(workerInfo->queueIndex);
+	return 0;
+}
+
+void Utils::JobPool::RunWorker( const uint32 queueIndex )
+{
+	for (;;)
+	{
+		SDL_mutexP(mMutex);
+		while (!mStopWorkers && mQueuedJobsCount == 0) SDL_CondWait(mWorkCondition, mMutex);
+		const bool stop = mStopWorkers;
+		SDL_mutexV(mMutex);
+		if (stop) break;
+
+		Job job;
+		while (PopJob(queueIndex, job))
+		{
+			RunJob(job);
+		}
+	}
+}
+
+bool Utils::JobPool::PopJob( const uint32 queueIndex, Job& job )
+{
+	// the own queue is processed from the front, while the others are robbed from the back to avoid contention
+	const uint32 queueCount = mQueues.size();
+	for (uint32 i=0; i<queueCount; ++i)
+	{
+		JobQueue* queue = mQueues[(queueIndex + i) % queueCount];
+		SDL_mutexP(queue->mutex);
+		if (queue->jobs.empty())
+		{
+			SDL_mutexV(queue->mutex);
+			continue;
+		}
+		if (i == 0)
+		{
+			job = queue->jobs.front();
+			queue->jobs.pop_front();
+		}
+		else
+		{
+			job = queue->jobs.back();
+			queue->jobs.pop_back();
+		}
+		SDL_mutexV(queue->mutex);
+
+		SDL_mutexP(mMutex);
+		--mQueuedJobsCount;
+		SDL_mutexV(mMutex);
+		return true;
+	}
+	return false;
+}
+
+void Utils::JobPool::RunJob( const Job& job )
+{
+	job.function(job.context, job.begin, job.end);
+
+	SDL_mutexP(mMutex);
+	if (--mPendingJobsCount == 0) SDL_CondSignal(mDoneCondition);
+	SDL_mutexV(mMutex);
+}
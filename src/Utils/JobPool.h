@@ -0,0 +1,98 @@
+/// @file
+/// Parallel execution of jobs on a pool of worker threads.
+
+#ifndef JobPool_h__
+#define JobPool_h__
+
+#include "Base.h"
+
+struct SDL_mutex;
+struct SDL_cond;
+struct SDL_Thread;
+
+namespace Utils
+{
+	/// Runs data parallel jobs on a pool of worker threads. The work is split into chunks distributed among the queues
+	/// of the threads. Each thread processes its own queue first and then steals the chunks queued for the other threads,
+	/// so the load is balanced even if the chunks take very different times.
+	/// @remarks
+	/// The thread calling ParallelFor works on the chunks as well and returns when all of them are done. Jobs may not
+	/// call ParallelFor themselves and only one thread may use the pool at a time.
+	class JobPool
+	{
+	public:
+
+		/// Function processing the items in the range [begin, end) of a job.
+		typedef void (*JobFunction)(void* context, const uint32 begin, const uint32 end);
+
+		/// Constructs the pool and starts the given number of worker threads.
+		JobPool(const int32 workerCount);
+
+		/// Stops the worker threads.
+		~JobPool(void);
+
+		/// Returns the number of worker threads suitable for this machine. It's one less than the number of processors
+		/// as the thread calling ParallelFor works as well.
+		static int32 GetDefaultWorkerCount(void);
+
+		/// Returns the number of threads processing the jobs including the calling one.
+		inline uint32 GetThreadCount(void) const { return mWorkers.size() + 1; }
+
+		/// Processes the items [0, count) by the function split into chunks of at least minChunkSize items.
+		/// The function is called directly if the items don't fill more than one chunk.
+		void ParallelFor(JobFunction function, void* context, const uint32 count, const uint32 minChunkSize);
+
+	private:
+
+		/// A chunk of items waiting to be processed.
+		struct Job
+		{
+			JobFunction function;
+			void* context;
+			uint32 begin;
+			uint32 end;
+		};
+
+		/// Jobs queued for one thread.
+		struct JobQueue
+		{
+			SDL_mutex* mutex;
+			deque<Job> jobs;
+		};
+
+		/// Parameters of the worker threads.
+		struct WorkerInfo
+		{
+			JobPool* pool;
+			uint32 queueIndex;
+		};
+
+		typedef vector<SDL_Thread*> WorkerVector;
+		typedef vector<JobQueue*> QueueVector;
+
+		SDL_mutex* mMutex;
+		SDL_cond* mWorkCondition;
+		SDL_cond* mDoneCondition;
+		WorkerVector mWorkers;
+		vector<WorkerInfo> mWorkerInfos;
+		QueueVector mQueues;
+		bool mStopWorkers;
+		uint32 mQueuedJobsCount;
+		uint32 mPendingJobsCount;
+
+		/// Entry point of the worker threads.
+		static int WorkerThreadMain(void* info);
+
+		/// Processes the queued jobs until the pool is destroyed.
+		void RunWorker(const uint32 queueIndex);
+
+		/// Takes a job from the queue of the thread or steals one from the other queues. Returns false if all
+		/// queues are empty.
+		bool PopJob(const uint32 queueIndex, Job& job);
+
+		/// Processes the job and marks it as done.
+		void RunJob(const Job& job);
+	};
+}
+
+#endif // JobPool_h__
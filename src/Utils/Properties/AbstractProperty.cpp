@@ -2,7 +2,10 @@
 #include "AbstractProperty.h"
 #include "../../ResourceSystem/XMLOutput.h"
 #include "../XMLConverter.h"
+#include "../BinaryConverter.h"
 
+/// Name of the XML elements holding the items of arrays.
+const StringKey XML_ITEM_ELEMENT("Item");
 
 void AbstractProperty::ReportConvertProblem( ePropertyType wrongType ) const
 {
@@ -60,6 +63,36 @@ void AbstractProperty::WriteValueXML(const RTTIBaseClass* owner, ResourceSystem:
 	}
 }
 
+void AbstractProperty::WriteValueBinary(const RTTIBaseClass* owner, ResourceSystem::BinaryOutput& output) const
+{
+	switch (GetType())
+	{
+	// We generate cases for all property types and arrays of property types here.
+	#define SCRIPT_ONLY
+	#define PROPERTY_TYPE(typeID, typeClass, defaultValue, typeName, scriptSetter, cloning) case typeID: \
+		Utils::BinaryConverter::WriteToBinary(output, GetValue<typeClass>(owner)); break;
+	#include "Utils/Properties/PropertyTypes.h"
+	#undef PROPERTY_TYPE
+
+	#define PROPERTY_TYPE(typeID, typeClass, defaultValue, typeName, scriptSetter, cloning) case typeID##_ARRAY: \
+		Utils::BinaryConverter::WriteToBinary(output, GetValue<Array<typeClass>*>(owner)); break;
+	#include "Utils/Properties/PropertyTypes.h"
+	#undef PROPERTY_TYPE
+	#undef SCRIPT_ONLY
+
+	case PT_RESOURCE:
+		Utils::BinaryConverter::WriteToBinary(output, GetValue<ResourceSystem::ResourcePtr>(owner));
+		break;
+
+	case PT_RESOURCE_ARRAY:
+		Utils::BinaryConverter::WriteToBinary(output, GetValue<Array<ResourceSystem::ResourcePtr>*>(owner));
+		break;
+
+	default:
+		ocError << "Writing property of type '" << PropertyTypes::GetStringName(GetType()) << "' to binary is not implemented.";
+	}
+}
+
 void Reflection::AbstractProperty::SetValueFromString( RTTIBaseClass* owner, const string& str )
 {
 	switch (GetType())
@@ -78,13 +111,14 @@ void Reflection::AbstractProperty::SetValueFromString( RTTIBaseClass* owner, con
 }
 
 template<typename T>
-void ReadArrayValueXML(Reflection::AbstractProperty* prop, RTTIBaseClass* owner, ResourceSystem::XMLNodeIterator& input)
+void ReadArrayValueXML(Reflection::AbstractProperty* prop, RTTIBaseClass* owner, ResourceSystem::XMLReader& input)
 {
 	vector<T> vertices;
-	for (ResourceSystem::XMLNodeIterator vertIt = input.IterateChildren(); vertIt != input.EndChildren(); ++vertIt)
+	const uint32 depth = input.GetDepth();
+	while (input.ReadChildElement(depth))
 	{
-		if ((*vertIt).compare("Item") == 0) { vertices.push_back(Utils::XMLConverter::ReadFromXML<T>(vertIt)); }
-		else ocError << "XML:Entity: Expected 'Item', found '" << *vertIt << "'";
+		if (input.GetName() == XML_ITEM_ELEMENT) { vertices.push_back(Utils::XMLConverter::ReadFromXML<T>(input)); }
+		else ocError << "XML:Entity: Expected 'Item', found '" << input.GetName().ToString() << "'";
 	}
 
 	Array<T> vertArray(vertices.size());
@@ -95,7 +129,22 @@ void ReadArrayValueXML(Reflection::AbstractProperty* prop, RTTIBaseClass* owner,
 	prop->SetValue<Array<T>*>(owner, &vertArray);
 }
 
-void Reflection::AbstractProperty::ReadValueXML(RTTIBaseClass* owner, ResourceSystem::XMLNodeIterator& input)
+template<typename T>
+void ReadArrayValueBinary(Reflection::AbstractProperty* prop, RTTIBaseClass* owner, ResourceSystem::BinaryInput& input)
+{
+	int32 size = input.Read<int32>();
+	if (input.HasFailed() || size < 0) return;
+
+	Array<T> array(size);
+	for (int32 i=0; i<size && !input.HasFailed(); ++i)
+	{
+		array[i] = Utils::BinaryConverter::ReadFromBinary<T>(input);
+	}
+	if (input.HasFailed()) return;
+	prop->SetValue<Array<T>*>(owner, &array);
+}
+
+void Reflection::AbstractProperty::ReadValueXML(RTTIBaseClass* owner, ResourceSystem::XMLReader& input)
 {
 	switch (GetType())
 	{
@@ -126,5 +175,46 @@ void Reflection::AbstractProperty::ReadValueXML(RTTIBaseClass* owner, ResourceSy
 
 	default:
 		ocError << "Parsing property of type '" << PropertyTypes::GetStringName(GetType()) << "' from XML is not implemented.";
+		input.SkipElement();
+	}
+}
+
+void Reflection::AbstractProperty::ReadValueBinary(RTTIBaseClass* owner, ResourceSystem::BinaryInput& input)
+{
+	switch (GetType())
+	{
+	// We generate cases for all property types and arrays of property types here.
+	#define SCRIPT_ONLY
+	#define PROPERTY_TYPE(typeID, typeClass, defaultValue, typeName, scriptSetter, cloning) \
+	case typeID: \
+		{ \
+			typeClass value = Utils::BinaryConverter::ReadFromBinary<typeClass>(input); \
+			if (!input.HasFailed()) SetValue<typeClass>(owner, value); \
+		} \
+		break;
+	#include "Utils/Properties/PropertyTypes.h"
+	#undef PROPERTY_TYPE
+
+	#define PROPERTY_TYPE(typeID, typeClass, defaultValue, typeName, scriptSetter, cloning) \
+	case typeID##_ARRAY: \
+		ReadArrayValueBinary<typeClass>(this, owner, input); \
+		break;
+	#include "Utils/Properties/PropertyTypes.h"
+	#undef PROPERTY_TYPE
+	#undef SCRIPT_ONLY
+
+	case PT_RESOURCE:
+		{
+			ResourceSystem::ResourcePtr value = Utils::BinaryConverter::ReadFromBinary<ResourceSystem::ResourcePtr>(input);
+			if (!input.HasFailed()) SetValue<ResourceSystem::ResourcePtr>(owner, value);
+		}
+		break;
+
+	case PT_RESOURCE_ARRAY:
+		ReadArrayValueBinary<ResourceSystem::ResourcePtr>(this, owner, input);
+		break;
+
+	default:
+		ocError << "Parsing property of type '" << PropertyTypes::GetStringName(GetType()) << "' from binary is not implemented.";
 	}
 }
@@ -81,6 +81,9 @@ namespace Reflection
 		/// Write the XML representation of the value of this property to XML output. An owner of the property must be specified.
 		void WriteValueXML(const RTTIBaseClass* owner, ResourceSystem::XMLOutput& output) const;
 
+		/// Write the binary representation of the value of this property to binary output. An owner of the property must be specified.
+		void WriteValueBinary(const RTTIBaseClass* owner, ResourceSystem::BinaryOutput& output) const;
+
 		/// Sets this property to a specified value. An owner of the property must be specified.
 		template<class T>
 		void SetValue(RTTIBaseClass* owner, const T value)
@@ -97,8 +100,12 @@ namespace Reflection
 		/// Parses the typed value of this property from the input string.
 		void SetValueFromString(RTTIBaseClass* owner, const string& str);
 
-		/// Parses the typed valued of this property from the XML input.
-		void ReadValueXML(RTTIBaseClass* owner, ResourceSystem::XMLNodeIterator& input);
+		/// Parses the typed valued of this property from the XML input. The input must be positioned on the element
+		/// holding the value and it's moved to the end of the element.
+		void ReadValueXML(RTTIBaseClass* owner, ResourceSystem::XMLReader& input);
+
+		/// Parses the typed valued of this property from the binary input.
+		void ReadValueBinary(RTTIBaseClass* owner, ResourceSystem::BinaryInput& input);
 
 	protected:
 
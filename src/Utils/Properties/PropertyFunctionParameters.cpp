@@ -3,8 +3,14 @@
 
 Reflection::PropertyFunctionParameters PropertyFunctionParameters::Null;
 
+const Reflection::PropertyFunctionParameter Reflection::PropertyFunctionParameters::NullParameter;
+
+const size_t Reflection::PropertyFunctionParameter::INLINE_DATA_SIZE;
+
+const uint32 Reflection::PropertyFunctionParameters::MAX_PARAMETERS;
+
 Reflection::PropertyFunctionParameters::PropertyFunctionParameters():
-	mParameters(new vector<PropertyFunctionParameter>())
+	mParametersCount(0)
 {
 }
 
@@ -15,11 +21,27 @@ Reflection::PropertyFunctionParameters::~PropertyFunctionParameters( void )
 Reflection::PropertyFunctionParameters& Reflection::PropertyFunctionParameters::operator=(const Reflection::PropertyFunctionParameters& rhs)
 {
 	if (this != &rhs)
-		mParameters = rhs.mParameters; 
+	{
+		for (uint32 i=0; i<rhs.mParametersCount; ++i)
+		{
+			mParameters[i] = rhs.mParameters[i];
+		}
+		// release the values of the parameters which are not used anymore
+		for (uint32 i=rhs.mParametersCount; i<mParametersCount; ++i)
+		{
+			mParameters[i] = PropertyFunctionParameter();
+		}
+		mParametersCount = rhs.mParametersCount;
+	}
 	return *this;
 }
 
 bool Reflection::PropertyFunctionParameters::operator==( const PropertyFunctionParameters& rhs )
 {
-	return mParameters == rhs.mParameters;
+	if (mParametersCount != rhs.mParametersCount) return false;
+	for (uint32 i=0; i<mParametersCount; ++i)
+	{
+		if (mParameters[i].GetType() != rhs.mParameters[i].GetType()) return false;
+	}
+	return true;
 }
@@ -12,18 +12,17 @@ namespace Reflection
 {
 
 	/// A single parameter which can be passed to a function accessed through the properties system.
+	/// @remarks Small values (up to INLINE_DATA_SIZE bytes) are stored directly in the parameter, so creating and copying
+	/// them doesn't allocate memory. Bigger values are allocated on the heap. Copying a parameter copies the value.
 	class PropertyFunctionParameter
 	{
-		struct NullDeleter
-		{
-			void operator()(void const*) const
-			{
-			}
-		};
 	public:
 
+		/// Maximum size of a value stored inside the parameter without allocating memory.
+		static const size_t INLINE_DATA_SIZE = 16;
+
 		/// Constructs a null PropertyFunctionParameter.
-		PropertyFunctionParameter(): mType(PT_UNKNOWN)
+		PropertyFunctionParameter(): mType(PT_UNKNOWN), mData(0), mDataOps(0)
 		{
 		}
 
@@ -32,8 +31,9 @@ namespace Reflection
 		template<class T>
 		PropertyFunctionParameter(const T& property):
 			mType(PropertyTypes::GetTypeID<T>()),
-			mData(new T(property))
+			mDataOps(&TypedDataOps<T>::Ops)
 		{
+			mData = mDataOps->copy(mInlineData, &property);
 		}
 
 		/// Constructs a PropertyFunctionParameter that will hold a reference to given property.
@@ -41,8 +41,34 @@ namespace Reflection
 		template<class T>
 		PropertyFunctionParameter(T& property, bool):
 			mType(PropertyTypes::GetTypeID<T>()),
-			mData(&property, NullDeleter())
+			mData(&property),
+			mDataOps(0)
+		{
+		}
+
+		/// Copy constructor.
+		PropertyFunctionParameter(const PropertyFunctionParameter& rhs):
+			mType(rhs.mType),
+			mDataOps(rhs.mDataOps)
+		{
+			mData = mDataOps ? mDataOps->copy(mInlineData, rhs.mData) : rhs.mData;
+		}
+
+		/// Destructor.
+		~PropertyFunctionParameter(void)
 		{
+			if (mDataOps) mDataOps->destroy(mData);
+		}
+
+		/// Assignment operator.
+		PropertyFunctionParameter& operator=(const PropertyFunctionParameter& rhs)
+		{
+			if (this == &rhs) return *this;
+			if (mDataOps) mDataOps->destroy(mData);
+			mType = rhs.mType;
+			mDataOps = rhs.mDataOps;
+			mData = mDataOps ? mDataOps->copy(mInlineData, rhs.mData) : rhs.mData;
+			return *this;
 		}
 
 		/// Returns the property.
@@ -53,21 +79,65 @@ namespace Reflection
 			{
 				return 0;
 			}
-			return &*boost::static_pointer_cast<T>(mData);
+			return static_cast<T*>(mData);
 		}
 
 		/// Returns the type of this property.
 		inline ePropertyType GetType(void) const { return mType; }
 
 	private:
-		ePropertyType           mType;
-		boost::shared_ptr<void> mData;
+
+		/// Functions copying and destroying the value of a specific type.
+		struct DataOps
+		{
+			void* (*copy)(void* inlineData, const void* source);
+			void (*destroy)(void* data);
+		};
+
+		/// Implementation of DataOps for the type T.
+		template<class T>
+		struct TypedDataOps
+		{
+			static const bool IS_INLINE = sizeof(T) <= INLINE_DATA_SIZE;
+			static const DataOps Ops;
+
+			static void* Copy(void* inlineData, const void* source)
+			{
+				if (IS_INLINE) return new (inlineData) T(*static_cast<const T*>(source));
+				else return new T(*static_cast<const T*>(source));
+			}
+
+			static void Destroy(void* data)
+			{
+				if (IS_INLINE) static_cast<T*>(data)->~T();
+				else delete static_cast<T*>(data);
+			}
+		};
+
+		ePropertyType mType;
+		void* mData;
+		const DataOps* mDataOps;
+		union
+		{
+			uint8 mInlineData[INLINE_DATA_SIZE];
+			uint64 mInlineDataAlignment;
+			void* mInlineDataPointerAlignment;
+		};
 	};
 
+	template<class T>
+	const typename PropertyFunctionParameter::DataOps PropertyFunctionParameter::TypedDataOps<T>::Ops =
+		{ &PropertyFunctionParameter::TypedDataOps<T>::Copy, &PropertyFunctionParameter::TypedDataOps<T>::Destroy };
+
 	/// This class represents generic parameters passed to a function accessed through the properties system.
+	/// @remarks The parameters are stored inside the object, so passing small values (e.g. the parameters of the entity
+	/// messages) doesn't allocate any memory. Copying the object copies the parameters.
 	class PropertyFunctionParameters
 	{
 	public:
+		/// Maximum number of parameters. It's enough for all the entity messages (see EntityMessageTypes.h) and functions.
+		static const uint32 MAX_PARAMETERS = 4;
+
 		/// Empty parameters.
 		static PropertyFunctionParameters Null;
 
@@ -80,13 +150,18 @@ namespace Reflection
 		/// Assignment operator.
 		PropertyFunctionParameters& operator=(const PropertyFunctionParameters& rhs);
 
-		/// Comparison operator.
+		/// Comparison operator. Parameters are equal if they hold the same number of parameters of the same types.
 		bool operator==(const PropertyFunctionParameters& rhs);
 
 		/// Adds a parameter to the end of the list.
 		inline void PushParameter(const PropertyFunctionParameter& toAdd)
 		{
-			mParameters->push_back(toAdd);
+			if (mParametersCount >= MAX_PARAMETERS)
+			{
+				ocError << "Too many parameters; the maximum is " << MAX_PARAMETERS;
+				return;
+			}
+			mParameters[mParametersCount++] = toAdd;
 		}
 
 		/// This method is provided for convenience and allows to create a PropertyFunctionParameters
@@ -96,28 +171,32 @@ namespace Reflection
 		inline PropertyFunctionParameters operator<<(const PropertyFunctionParameter& toAdd) const
 		{
 			PropertyFunctionParameters res(*this);
-			res.mParameters->push_back(toAdd);
+			res.PushParameter(toAdd);
 			return res;
 		}
 
 		/// Returns a parameter specified by the index. If index out of range is
 		/// supplied, returns null parameter.
-		inline PropertyFunctionParameter GetParameter(uint32 index) const
+		inline const PropertyFunctionParameter& GetParameter(uint32 index) const
 		{
-			if (index >= mParameters->size())
+			if (index >= mParametersCount)
 			{
 				ocError << "Out of parameter bounds";
-				return PropertyFunctionParameter();
+				return NullParameter;
 			}
-			return mParameters->at(index);
+			return mParameters[index];
 		}
 
 		/// Returns the number of actual parameters inserted into this parameter holder.
-		inline uint32 GetParametersCount(void) const { return mParameters->size(); }
+		inline uint32 GetParametersCount(void) const { return mParametersCount; }
 
 	private:
 
-		boost::shared_ptr< vector<PropertyFunctionParameter> > mParameters;
+		/// Returned for indices out of bounds.
+		static const PropertyFunctionParameter NullParameter;
+
+		PropertyFunctionParameter mParameters[MAX_PARAMETERS];
+		uint32 mParametersCount;
 	};
 }
 
@@ -105,6 +105,17 @@ namespace Reflection
 			mProperty->WriteValueXML(mOwner, output);
 		}
 
+		/// Write the binary representation of the value of holder's property to binary output.
+		inline void WriteValueBinary(ResourceSystem::BinaryOutput& output)
+		{
+			if (!mProperty)
+			{
+				ReportUndefined();
+				return;
+			}
+			mProperty->WriteValueBinary(mOwner, output);
+		}
+
 		/// Sets the typed value of this property.
 		template<class T>
 		void SetValue(const T value)
@@ -129,7 +140,7 @@ namespace Reflection
 		}
 
 		/// Parses the typed valued of this property from the XML input.
-		inline void ReadValueXML(ResourceSystem::XMLNodeIterator& input)
+		inline void ReadValueXML(ResourceSystem::XMLReader& input)
 		{
 			if (!mProperty)
 			{
@@ -139,6 +150,17 @@ namespace Reflection
 			mProperty->ReadValueXML(mOwner, input);
 		}
 
+		/// Parses the typed valued of this property from the binary input.
+		inline void ReadValueBinary(ResourceSystem::BinaryInput& input)
+		{
+			if (!mProperty)
+			{
+				ReportUndefined();
+				return;
+			}
+			mProperty->ReadValueBinary(mOwner, input);
+		}
+
 		/// Calls a function this property represents.
 		inline void CallFunction(PropertyFunctionParameters* parameters)
 		{
@@ -25,7 +25,7 @@ void PropertyMap::EnumProperties( RTTIBaseClass* owner, PropertyList& out, const
 	}
 }
 
-AbstractProperty* PropertyMap::GetProperty( const StringKey key, const PropertyAccessFlags flagMask ) const
+AbstractProperty* PropertyMap::GetProperty( const StringKey& key, const PropertyAccessFlags flagMask ) const
 {
 	AbstractPropertyMap::const_iterator it = mProperties.find(key);
 	if (it != mProperties.end() && (it->second->GetAccessFlags()&flagMask) != 0)
@@ -35,7 +35,7 @@ AbstractProperty* PropertyMap::GetProperty( const StringKey key, const PropertyA
 	return 0;
 }
 
-bool PropertyMap::HasProperty(const StringKey key) const
+bool PropertyMap::HasProperty(const StringKey& key) const
 {
 	return mProperties.find(key) != mProperties.end();
 }
@@ -52,7 +52,7 @@ bool PropertyMap::AddProperty( AbstractProperty* prop )
 	return true;
 }
 
-bool PropertyMap::DeleteProperty(const StringKey key)
+bool PropertyMap::DeleteProperty(const StringKey& key)
 {
 	return mProperties.erase(key) > 0;
 }
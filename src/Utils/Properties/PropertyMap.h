@@ -29,16 +29,16 @@ namespace Reflection
 		void EnumProperties( RTTIBaseClass* owner, PropertyList& out, const PropertyAccessFlags flagMask = PA_FULL_ACCESS ) const;
 
 		/// Returns a property identified by it's string key. Access restriction filter can be defined.
-		AbstractProperty* GetProperty(const StringKey key, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const;
+		AbstractProperty* GetProperty(const StringKey& key, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const;
 
 		/// Returns true if the property exists.
-		bool HasProperty(const StringKey key) const;
+		bool HasProperty(const StringKey& key) const;
 
 		/// Adds a property.
 		bool AddProperty(AbstractProperty* prop);
 
 		/// Deletes a property. It does not release its memory.
-		bool DeleteProperty(const StringKey key);
+		bool DeleteProperty(const StringKey& key);
 		
 		/// Clears all properties. It does not release theirs memory.
 		void ClearProperties();
@@ -0,0 +1,28 @@
+#include "Common.h"
+#include "UnitTests.h"
+#include "../PropertyFunctionParameters.h"
+
+SUITE(PropertyFunctionParameters)
+{
+	TEST(InlineValues)
+	{
+		PropertyFunctionParameters params = PropertyFunctionParameters() << 1.5f << Vector2(1.0f, 2.0f) << (uint32)7;
+		CHECK_EQUAL(3u, params.GetParametersCount());
+		CHECK_EQUAL(1.5f, *params.GetParameter(0).GetData<float32>());
+		CHECK_EQUAL(2.0f, params.GetParameter(1).GetData<Vector2>()->y);
+		CHECK_EQUAL(7u, *params.GetParameter(2).GetData<uint32>());
+		CHECK(params.GetParameter(0).GetData<uint32>() == 0);
+	}
+
+	TEST(HeapValues)
+	{
+		string text("a string long enough not to fit into the parameter itself");
+		PropertyFunctionParameters params = PropertyFunctionParameters() << text;
+		PropertyFunctionParameters copy;
+		copy = params;
+		params = PropertyFunctionParameters();
+		CHECK_EQUAL(0u, params.GetParametersCount());
+		CHECK_EQUAL(1u, copy.GetParametersCount());
+		CHECK_EQUAL(text, *copy.GetParameter(0).GetData<string>());
+	}
+}
@@ -10,6 +10,9 @@ RTTI::RTTI(	uint8 dwStub, ClassID CLID, const char* szClassName, RTTI* pBaseClas
 	mBaseRTTI		( pBaseClassRTTI	),
 	mClassFactory( pFactory			),
 	mComponentDependencies(0),
+	mHandledMessages(0),
+	mParallelHandledMessages(0),
+	mHandledMessagesDeclared(false),
 	mTransient(false)
 {
 	OC_UNUSED(dwStub);
@@ -46,7 +49,7 @@ void RTTI::EnumComponentDependencies( ComponentDependencyList& out ) const
 		out.push_back(*it);
 }
 
-AbstractProperty* RTTI::GetProperty( const StringKey key, const PropertyAccessFlags flagMask ) const
+AbstractProperty* RTTI::GetProperty( const StringKey& key, const PropertyAccessFlags flagMask ) const
 {
 	AbstractProperty* prop = mProperties.GetProperty(key, flagMask);
 	if (!prop && mBaseRTTI) return mBaseRTTI->GetProperty(key, flagMask);
@@ -58,7 +61,41 @@ void RTTI::AddComponentDependency( const EntitySystem::eComponentType dep )
 	mComponentDependencies.push_back(dep);
 }
 
-bool RTTI::HasProperty(const StringKey key)
+void RTTI::AddHandledMessage( const EntitySystem::EntityMessage::eType type )
+{
+	OC_ASSERT_MSG(EntitySystem::EntityMessage::NUM_TYPES <= sizeof(mHandledMessages) * 8, "Too many entity message types for the handled messages mask");
+	mHandledMessages |= (1 << type);
+	mHandledMessagesDeclared = true;
+}
+
+void RTTI::AddParallelHandledMessage( const EntitySystem::EntityMessage::eType type )
+{
+	AddHandledMessage(type);
+	mParallelHandledMessages |= (1 << type);
+}
+
+void RTTI::ClearHandledMessages( void )
+{
+	mHandledMessages = 0;
+	mParallelHandledMessages = 0;
+	mHandledMessagesDeclared = true;
+}
+
+bool RTTI::HandlesMessage( const EntitySystem::EntityMessage::eType type ) const
+{
+	if (mHandledMessagesDeclared) return (mHandledMessages & (1 << type)) != 0;
+	if (mBaseRTTI) return mBaseRTTI->HandlesMessage(type);
+	return true;
+}
+
+bool RTTI::HandlesMessageInParallel( const EntitySystem::EntityMessage::eType type ) const
+{
+	if (mHandledMessagesDeclared) return (mParallelHandledMessages & (1 << type)) != 0;
+	if (mBaseRTTI) return mBaseRTTI->HandlesMessageInParallel(type);
+	return false;
+}
+
+bool RTTI::HasProperty(const StringKey& key)
 {
 	return mProperties.HasProperty(key);
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "../Properties/PropertyAccess.h"
 #include "../Properties/PropertyMap.h"
 #include "../../EntitySystem/ComponentMgr/ComponentEnums.h"
+#include "../../EntitySystem/EntityMgr/EntityMessage.h"
 
 /// A set of classes implementing custom %RTTI and reflection.
 /// The word 'reflection' means that classes are aware of what they are. They can generate their string name
@@ -71,10 +72,10 @@ namespace Reflection
 		void EnumComponentDependencies(ComponentDependencyList& out) const;
 
 		/// Returns a property identified by it's string key. Access restriction filter can be defined.
-		AbstractProperty* GetProperty(const StringKey key, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const;
+		AbstractProperty* GetProperty(const StringKey& key, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const;
 
 		/// Returns true if the property exists.
-		bool HasProperty(const StringKey key);
+		bool HasProperty(const StringKey& key);
 
 		/// Adds a property to the RTTI.
 		bool AddProperty(AbstractProperty* prop) { return mProperties.AddProperty(prop); };
@@ -83,6 +84,25 @@ namespace Reflection
 		/// A component can define that it depends on other components. This is then used to determine the order
 		/// of creation of components. It is ensured that all components this component depends on will be created first.
 		void AddComponentDependency(const EntitySystem::eComponentType dep);
+
+		/// Adds an entity message type the component handles.
+		/// Components receive only the message types they declared. If a component declares no types at all, it
+		/// receives every message (this is the case of components with run-time defined handlers, like scripts).
+		void AddHandledMessage(const EntitySystem::EntityMessage::eType type);
+
+		/// Adds an entity message type the component handles and which can be handled by many components in parallel.
+		/// The handler may touch only its own component and the components of its entity, which don't handle the message
+		/// in parallel at the same time.
+		void AddParallelHandledMessage(const EntitySystem::EntityMessage::eType type);
+
+		/// Declares that the component handles no entity messages at all.
+		void ClearHandledMessages(void);
+
+		/// Returns true if the represented class type handles messages of the given type.
+		bool HandlesMessage(const EntitySystem::EntityMessage::eType type) const;
+
+		/// Returns true if the represented class type handles messages of the given type in parallel.
+		bool HandlesMessageInParallel(const EntitySystem::EntityMessage::eType type) const;
 		
 		/// Returns whether the component is transient.
 		inline bool IsTransient(void) const { return mTransient; }
@@ -123,6 +143,9 @@ namespace Reflection
 		ClassFactoryFunc mClassFactory;
 		PropertyMap mProperties;
 		ComponentDependencyList mComponentDependencies;
+		uint32 mHandledMessages;
+		uint32 mParallelHandledMessages;
+		bool mHandledMessagesDeclared;
 		bool mTransient;
 
 	};
@@ -75,7 +75,32 @@ namespace Reflection
 		{
 			T::GetClassRTTI()->AddComponentDependency(cmp);
 		}
-		
+
+		/// Registers an entity message type handled by the owner of this class.
+		/// EntityMgr delivers messages only to components which handle them, so all types the component reacts to
+		/// in HandleMessage must be registered here. Components registering nothing receive all messages.
+		/// @remarks This function should be called only from within a user-defined RegisterReflection function.
+		static void AddHandledMessage(const EntitySystem::EntityMessage::eType type)
+		{
+			T::GetClassRTTI()->AddHandledMessage(type);
+		}
+
+		/// Registers an entity message type handled by the owner of this class, which can be handled by many components
+		/// on worker threads at once. The handler may touch only the state of its own entity and must be thread safe
+		/// otherwise; messages handled by scripts or modifying the entities are never handled in parallel.
+		/// @remarks This function should be called only from within a user-defined RegisterReflection function.
+		static void AddParallelHandledMessage(const EntitySystem::EntityMessage::eType type)
+		{
+			T::GetClassRTTI()->AddParallelHandledMessage(type);
+		}
+
+		/// Declares that the owner of this class does not handle any entity messages.
+		/// @remarks This function should be called only from within a user-defined RegisterReflection function.
+		static void ClearHandledMessages(void)
+		{
+			T::GetClassRTTI()->ClearHandledMessages();
+		}
+
 		/// Returns whether the component is transient.
 		static inline bool IsTransient(void) { return mRTTI.IsTransient(); }
 		
@@ -96,7 +121,7 @@ namespace Reflection
 		virtual RTTI* GetRTTI(void) const { return &mRTTI; }
 
 		/// Returns a property identified by it's string key. Access restriction filter can be defined.
-		AbstractProperty* GetPropertyPointer(const StringKey key, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const
+		AbstractProperty* GetPropertyPointer(const StringKey& key, const PropertyAccessFlags flagMask = PA_FULL_ACCESS) const
 		{
 			if (BaseClass::mDynamicProperties)
 			{
@@ -13,6 +13,7 @@ namespace ResourceSystem
 {
 	class Resource;
 	class XMLResource;
+	class BinaryResource;
 
 	/// Smart pointer to Resource. This pointer allows type-checked casting to
 	/// specific resource pointers.
@@ -46,6 +47,9 @@ namespace ResourceSystem
 
 	/// Smart pointer to XMLResource.
     typedef boost::shared_ptr<XMLResource> XMLResourcePtr;
+
+	/// Smart pointer to BinaryResource.
+	typedef boost::shared_ptr<BinaryResource> BinaryResourcePtr;
 }
 
 namespace GUISystem
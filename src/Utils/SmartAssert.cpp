@@ -1,16 +1,25 @@
 #include "Common.h"
 #include "SmartAssert.h"
+#include "LogSystem/LogMgr.h"
+
+/// Writes the messages waiting in the log, so that they are not lost when the program is terminated.
+void FlushLog()
+{
+	if (LogSystem::LogMgr::SingletonExists()) LogSystem::LogMgr::GetSingleton().Flush();
+}
 
 #ifdef __WIN__
 
 #include <Windows.h>
 void DisplayAssert(const char* msg, const char* file, const int line)
 {
+	FlushLog();
 	MessageBox(NULL, msg, "An assertion failed!", MB_OK | MB_ICONERROR | MB_TASKMODAL);
 }
 
 void CRITICAL_FAILURE( const char* msg )
 {
+	FlushLog();
 	MessageBox(NULL, msg, "Critical failure!", MB_OK | MB_ICONERROR | MB_TASKMODAL);
 	exit(1);
 }
@@ -20,11 +29,13 @@ void CRITICAL_FAILURE( const char* msg )
 void DisplayAssert(const char* msg, const char* file, const int line)
 {
 	// Smart enough for linux geeks 8D
+	FlushLog();
     fprintf(stderr, "%s:%d %s\n", file, line, msg);
 }
 
 void CRITICAL_FAILURE( const char* msg )
 {
+	FlushLog();
     fprintf(stderr, "%s\n", msg);
 	exit(1);
 }
@@ -37,20 +37,17 @@ inline hash_map<string, StringKey::StringKeyData*>* GetStringKeyMap()
 
 inline StringKey::StringKeyData* GetStringKeyData(const string& str)
 {
-	StringKey::StringKeyData* res = 0;
 	StringKeyMap* stringKeyMap = StringKeyMap::GetInstance();
 	if (stringKeyMap == 0)
 	{
 		return 0;
 	}
-	else if (stringKeyMap->find(str) == stringKeyMap->end())
+
+	// a single lookup; the data is created only if the string is not there yet
+	StringKey::StringKeyData*& res = (*stringKeyMap)[str];
+	if (res == 0)
 	{
 		res = new StringKey::StringKeyData(str);
-		(*stringKeyMap)[str] = res;
-	}
-	else
-	{
-		res = (*stringKeyMap)[str];
 	}
 	return res;
 }
@@ -10,6 +10,9 @@ namespace Utils
 {
 	/// This class serves as a key into maps and other structures where we want to index data using strings, but we need high speed as well.
 	/// The string value is hashed and the result is then used as a decimal representation of the string.
+	/// @remarks Constructing the key from a string looks the string up in a global map. Code called often should therefore
+	/// use keys constructed once, e.g. static constants like the ones in EntitySystem::PropertyKeys. Copying a key
+	/// never touches the map.
 	class StringKey
 	{
 	public:
@@ -49,6 +52,12 @@ namespace Utils
 			return mData == rhs.mData;
 		}
 
+		/// Comparison operator.
+		inline bool operator!=(const StringKey& rhs) const
+		{
+			return mData != rhs.mData;
+		}
+
 		/// Comparison operator needed by containers.
 		bool operator<(const StringKey& rhs) const
 		{
@@ -61,8 +70,8 @@ namespace Utils
 		/// Structure holding the key data in the memory. The StringKey references this structure.
 		struct StringKeyData
 		{
-			StringKeyData(string refString): mRefCount(0), mRefString(refString) {}
-			uint8   mRefCount;
+			StringKeyData(const string& refString): mRefCount(0), mRefString(refString) {}
+			uint32  mRefCount;
 			string  mRefString;
 		};
 
@@ -1,7 +1,7 @@
 #include "Common.h"
 #include "XMLConverter.h"
 #include "../ResourceSystem/XMLOutput.h"
-#include "../ResourceSystem/XMLResource.h"
+#include "../ResourceSystem/XMLReader.h"
 #include <cstring>
 
 using namespace XMLConverter;
@@ -30,26 +30,26 @@ void XMLConverter::WriteToXML(ResourceSystem::XMLOutput& output, const ResourceS
 }
 
 template<>
-Vector2 XMLConverter::ReadFromXML(ResourceSystem::XMLNodeIterator& input)
+Vector2 XMLConverter::ReadFromXML(ResourceSystem::XMLReader& input)
 {
 	Vector2 result;
-	std::istringstream iss(input.GetChildValue<string>());
+	std::istringstream iss(input.ReadElementText());
 	if ((iss >> result.x).fail()) { return Vector2_Zero; }
 	if ((iss >> result.y).fail()) { return Vector2_Zero; }
 	return result;
 }
 
 template<>
-EntitySystem::EntityHandle XMLConverter::ReadFromXML(ResourceSystem::XMLNodeIterator& input)
+EntitySystem::EntityHandle XMLConverter::ReadFromXML(ResourceSystem::XMLReader& input)
 {
-	EntitySystem::EntityID id = input.GetChildValue<EntitySystem::EntityID>();
+	EntitySystem::EntityID id = input.ReadElementValue<EntitySystem::EntityID>();
 	return EntitySystem::EntityHandle(id);
 }
 
 template<>
-ResourceSystem::ResourcePtr XMLConverter::ReadFromXML(ResourceSystem::XMLNodeIterator& input)
+ResourceSystem::ResourcePtr XMLConverter::ReadFromXML(ResourceSystem::XMLReader& input)
 {
-	string name = input.GetChildValue<string>();
+	string name = input.ReadElementText();
 	if (name.empty()) return 0;
 	return gResourceMgr.GetResource("Project", name);
 }
@@ -6,7 +6,7 @@
 
 #include "Base.h"
 #include "Array.h"
-#include "../ResourceSystem/XMLResource.h"
+#include "../ResourceSystem/XMLReader.h"
 
 namespace Utils
 {
@@ -42,21 +42,21 @@ namespace Utils
 		void WriteToXML(ResourceSystem::XMLOutput& output, const ResourceSystem::ResourcePtr& val);
 
 		
-		/// Reads the value from XML and returns it.
+		/// Reads the value of the current element from XML and returns it. The input is moved to the end of the element.
 		template<typename T>
-		T ReadFromXML(ResourceSystem::XMLNodeIterator& input)
+		T ReadFromXML(ResourceSystem::XMLReader& input)
 		{
-			return input.GetChildValue<T>();
+			return input.ReadElementValue<T>();
 		}
 
 		template<>
-		Vector2 ReadFromXML(ResourceSystem::XMLNodeIterator& input);
+		Vector2 ReadFromXML(ResourceSystem::XMLReader& input);
 
 		template<>
-		EntitySystem::EntityHandle ReadFromXML(ResourceSystem::XMLNodeIterator& input);
+		EntitySystem::EntityHandle ReadFromXML(ResourceSystem::XMLReader& input);
 
 		template<>
-		ResourceSystem::ResourcePtr ReadFromXML(ResourceSystem::XMLNodeIterator& input);
+		ResourceSystem::ResourcePtr ReadFromXML(ResourceSystem::XMLReader& input);
 	}
 }
 
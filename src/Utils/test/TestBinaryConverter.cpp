@@ -0,0 +1,78 @@
+#include "Common.h"
+#include "UnitTests.h"
+#include "../BinaryConverter.h"
+
+SUITE(BinaryConverter)
+{
+	TEST(PlainValues)
+	{
+		ResourceSystem::BinaryOutput output;
+		BinaryConverter::WriteToBinary<int32>(output, -123456);
+		BinaryConverter::WriteToBinary<bool>(output, true);
+		BinaryConverter::WriteToBinary<float32>(output, 1.5f);
+		BinaryConverter::WriteToBinary<Vector2>(output, Vector2(3.0f, -4.0f));
+		BinaryConverter::WriteToBinary<string>(output, "binary");
+		BinaryConverter::WriteToBinary<string>(output, "");
+
+		ResourceSystem::BinaryInput input(output.GetData(), output.GetSize());
+		CHECK_EQUAL(-123456, BinaryConverter::ReadFromBinary<int32>(input));
+		CHECK_EQUAL(true, BinaryConverter::ReadFromBinary<bool>(input));
+		CHECK_EQUAL(1.5f, BinaryConverter::ReadFromBinary<float32>(input));
+		Vector2 vec = BinaryConverter::ReadFromBinary<Vector2>(input);
+		CHECK_EQUAL(3.0f, vec.x);
+		CHECK_EQUAL(-4.0f, vec.y);
+		CHECK_EQUAL("binary", BinaryConverter::ReadFromBinary<string>(input));
+		CHECK_EQUAL("", BinaryConverter::ReadFromBinary<string>(input));
+		CHECK(input.IsAtEnd());
+		CHECK(!input.HasFailed());
+	}
+
+
+	TEST(Arrays)
+	{
+		Array<int32> array(3);
+		array[0] = 1;
+		array[1] = 2;
+		array[2] = 3;
+
+		ResourceSystem::BinaryOutput output;
+		BinaryConverter::WriteToBinary<int32>(output, &array);
+
+		ResourceSystem::BinaryInput input(output.GetData(), output.GetSize());
+		CHECK_EQUAL(3, input.Read<int32>());
+		CHECK_EQUAL(1, BinaryConverter::ReadFromBinary<int32>(input));
+		CHECK_EQUAL(2, BinaryConverter::ReadFromBinary<int32>(input));
+		CHECK_EQUAL(3, BinaryConverter::ReadFromBinary<int32>(input));
+		CHECK(input.IsAtEnd());
+	}
+
+
+	TEST(ReservedValuesAndBlocks)
+	{
+		ResourceSystem::BinaryOutput output;
+		uint32 sizePosition = output.ReserveUInt32();
+		output.Write<uint16>(7);
+		output.Write<uint16>(8);
+		output.WriteUInt32At(sizePosition, output.GetSize() - sizePosition - sizeof(uint32));
+		output.Write<uint8>(9);
+
+		ResourceSystem::BinaryInput input(output.GetData(), output.GetSize());
+		ResourceSystem::BinaryInput block = input.ReadBlock(input.Read<uint32>());
+		CHECK_EQUAL((uint32)4, block.GetSize());
+		CHECK_EQUAL(7, block.Read<uint16>());
+		CHECK_EQUAL(9, input.Read<uint8>());
+		CHECK(input.IsAtEnd());
+	}
+
+
+	TEST(ReadingPastEnd)
+	{
+		ResourceSystem::BinaryOutput output;
+		output.Write<uint16>(1);
+
+		ResourceSystem::BinaryInput input(output.GetData(), output.GetSize());
+		CHECK_EQUAL((uint32)0, input.Read<uint32>());
+		CHECK(input.HasFailed());
+		CHECK_EQUAL("", input.ReadString());
+	}
+}
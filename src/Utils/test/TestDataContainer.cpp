@@ -0,0 +1,56 @@
+#include "Common.h"
+#include "UnitTests.h"
+#include "../DataContainer.h"
+#include <boost/filesystem.hpp>
+#include <cstring>
+
+namespace
+{
+	const char* TEST_FILE_NAME = "TestDataContainer.tmp";
+
+	void WriteTestFile(const char* content)
+	{
+		boost::filesystem::ofstream output(TEST_FILE_NAME, std::ios::out | std::ios::binary | std::ios::trunc);
+		output.write(content, strlen(content));
+	}
+}
+
+SUITE(DataContainer)
+{
+	TEST(MapFile)
+	{
+		const char* content = "mapped file content";
+		WriteTestFile(content);
+		DataContainer dc;
+		CHECK(dc.MapFile(TEST_FILE_NAME));
+		CHECK(dc.IsMapped());
+		CHECK_EQUAL((int32)strlen(content), dc.GetSize());
+		CHECK(memcmp(content, dc.GetData(), dc.GetSize()) == 0);
+		dc.Release();
+		CHECK(!dc.GetData());
+		CHECK_EQUAL(0, dc.GetSize());
+		boost::filesystem::remove(TEST_FILE_NAME);
+	}
+
+	TEST(MapMissingOrEmptyFile)
+	{
+		DataContainer dc;
+		CHECK(!dc.MapFile("MissingTestDataContainer.tmp"));
+		WriteTestFile("");
+		CHECK(!dc.MapFile(TEST_FILE_NAME));
+		CHECK(!dc.GetData());
+		boost::filesystem::remove(TEST_FILE_NAME);
+	}
+
+	TEST(BorrowedData)
+	{
+		uint8 data[4] = { 1, 2, 3, 4 };
+		DataContainer dc;
+		dc.SetBorrowedData(data, 4);
+		CHECK(!dc.IsMapped());
+		CHECK_EQUAL(data, dc.GetData());
+		dc.Release();
+		CHECK(!dc.GetData());
+		CHECK_EQUAL(4, data[3]);
+	}
+}
@@ -0,0 +1,57 @@
+#include "Common.h"
+#include "UnitTests.h"
+#include "../JobPool.h"
+
+namespace
+{
+	void IncrementItems(void* context, const uint32 begin, const uint32 end)
+	{
+		vector<uint32>& items = *(vector<uint32>*)context;
+		for (uint32 i=begin; i<end; ++i)
+		{
+			++items[i];
+		}
+	}
+}
+
+SUITE(JobPool)
+{
+	TEST(AllItemsProcessedOnce)
+	{
+		JobPool pool(3);
+		vector<uint32> items(1000, 0);
+		pool.ParallelFor(IncrementItems, &items, items.size(), 10);
+		pool.ParallelFor(IncrementItems, &items, items.size(), 10);
+		for (uint32 i=0; i<items.size(); ++i)
+		{
+			CHECK_EQUAL(2u, items[i]);
+		}
+	}
+
+	TEST(RepeatedSmallCalls)
+	{
+		// the workers are still looking for jobs of the previous call when the next one starts
+		JobPool pool(3);
+		vector<uint32> items(8, 0);
+		for (uint32 i=0; i<10000; ++i)
+		{
+			pool.ParallelFor(IncrementItems, &items, items.size(), 1);
+		}
+		for (uint32 i=0; i<items.size(); ++i)
+		{
+			CHECK_EQUAL(10000u, items[i]);
+		}
+	}
+
+	TEST(NoWorkers)
+	{
+		JobPool pool(0);
+		CHECK_EQUAL(1u, pool.GetThreadCount());
+		vector<uint32> items(100, 0);
+		pool.ParallelFor(IncrementItems, &items, items.size(), 1);
+		for (uint32 i=0; i<items.size(); ++i)
+		{
+			CHECK_EQUAL(1u, items[i]);
+		}
+	}
+}
@@ -21,4 +21,14 @@ SUITE(StringKey)
 		e=a;
 		CHECK_EQUAL(a==e, true);
 	}
+
+	TEST(ManyReferences)
+	{
+		StringKey a = "Referenced String";
+		vector<StringKey> copies(1000, a);
+		copies.clear();
+		StringKey b = "Referenced String";
+		CHECK_EQUAL(a==b, true);
+		CHECK_EQUAL("Referenced String", b.ToString());
+	}
 }